@@ -0,0 +1,57 @@
+#include "BenchFixtures.h"
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+namespace bench
+{
+const std::string& wordListPath()
+{
+    static const std::string path = []
+    {
+        constexpr int kWordCount = 5000;
+        const auto file = std::filesystem::temp_directory_path() / "typeit_bench_words.txt";
+
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<int> length(3, 10);
+        std::uniform_int_distribution<int> letter('a', 'z');
+        std::ofstream out(file, std::ios::trunc);
+        for (int i = 0; i < kWordCount; ++i)
+        {
+            std::string word;
+            const int n = length(gen);
+            for (int c = 0; c < n; ++c)
+            {
+                word += static_cast<char>(letter(gen));
+            }
+            out << word << " n. definition of " << word << " number " << i << "\n";
+        }
+        return file.string();
+    }();
+    return path;
+}
+
+PopulatedEngine::PopulatedEngine(size_t liveWords, int width, int height) : m_engine(m_words)
+{
+    m_words.loadFromFile(wordListPath());
+    GameSettings& cfg = m_settings.settings();
+    cfg.gameAreaHeight = height;
+    cfg.maxConcurrentWords = static_cast<int>(liveWords);
+    cfg.baseTeleportInterval = 1.0e6f;
+    cfg.minTeleportInterval = 1.0e6f;
+    cfg.teleportIntervalDecrease = 0.0f;
+    cfg.spawnIntervalMin = 0.0f;
+    cfg.spawnIntervalMax = 0.0f;
+    cfg.minSpawnInterval = 0.0f;
+    cfg.spawnIntervalDecrease = 0.0f;
+
+    m_engine.start(width);
+    m_engine.updateVisibleArea(width, height);
+
+    // The spawn interval settles at [0, 0.2) s, so a 0.25 s step spawns one word
+    for (size_t i = 0; i < liveWords * 2 && m_engine.getFallingWords().size() < liveWords; ++i)
+    {
+        m_engine.update(0.25f);
+    }
+}
+} // namespace bench
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "engine/GameEngine.h"
+#include "managers/WordManager.h"
+#include "utils/GameConfig.h"
+#include <cstddef>
+#include <string>
+
+namespace bench
+{
+// Deterministic dictionary written once to the temp directory
+const std::string& wordListPath();
+
+// Restores the global GameSettings when a case is done with them
+class ScopedSettings
+{
+public:
+    ScopedSettings() : m_saved(ConfigManager::instance().settings()) {}
+    ~ScopedSettings() { ConfigManager::instance().settings() = m_saved; }
+    ScopedSettings(const ScopedSettings&) = delete;
+    ScopedSettings& operator=(const ScopedSettings&) = delete;
+
+    GameSettings& settings() { return ConfigManager::instance().settings(); }
+
+private:
+    GameSettings m_saved;
+};
+
+// A started engine on the generated dictionary holding exactly liveWords
+// words that never move, so update() measures steady-state cost without
+// spawns or misses. The global settings it changes are restored with it.
+class PopulatedEngine
+{
+public:
+    explicit PopulatedEngine(size_t liveWords, int width = 100, int height = 15);
+    PopulatedEngine(const PopulatedEngine&) = delete;
+    PopulatedEngine& operator=(const PopulatedEngine&) = delete;
+
+    GameEngine& engine() { return m_engine; }
+    // For further engines on the same dictionary
+    const WordManager& words() const { return m_words; }
+
+private:
+    ScopedSettings m_settings;
+    WordManager m_words;
+    GameEngine m_engine;
+};
+} // namespace bench
@@ -0,0 +1,194 @@
+#include "Benchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+#include <utility>
+
+namespace
+{
+struct Registration
+{
+    std::string name;
+    BenchmarkFn fn;
+};
+
+std::vector<Registration>& registry()
+{
+    static std::vector<Registration> cases;
+    return cases;
+}
+
+std::string escapeJson(const std::string& text)
+{
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\')
+        {
+            escaped += '\\';
+            escaped += c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            char buffer[8];
+            std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+            escaped += buffer;
+        }
+        else
+        {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+std::string timestamp()
+{
+    const auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    std::tm timeInfo{};
+#ifdef _WIN32
+    gmtime_s(&timeInfo, &now);
+#else
+    gmtime_r(&now, &timeInfo);
+#endif
+    std::ostringstream oss;
+    oss << std::put_time(&timeInfo, "%Y-%m-%dT%H:%M:%SZ");
+    return oss.str();
+}
+} // namespace
+
+BenchmarkState::BenchmarkState(std::string name, const BenchmarkSettings& settings) : m_settings(settings)
+{
+    m_result.name = std::move(name);
+}
+
+void BenchmarkState::runLoop(const std::function<void(uint64_t)>& loop)
+{
+    auto timeMs = [&](uint64_t iterations)
+    {
+        const auto start = Clock::now();
+        loop(iterations);
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    };
+
+    // Grow the batch until one sample is long enough to time reliably
+    uint64_t iterations = 1;
+    double elapsed = timeMs(iterations);
+    while (elapsed < m_settings.minSampleMs && iterations < (1ULL << 40))
+    {
+        const double scale = elapsed > 0.0 ? m_settings.minSampleMs * 1.2 / elapsed : 10.0;
+        iterations = std::max(iterations + 1, static_cast<uint64_t>(static_cast<double>(iterations) * std::min(scale, 10.0)));
+        elapsed = timeMs(iterations);
+    }
+
+    std::vector<double> nsPerOp;
+    const int samples = std::max(1, m_settings.samples);
+    for (int s = 0; s < samples; ++s)
+    {
+        nsPerOp.push_back(timeMs(iterations) * 1e6 / static_cast<double>(iterations));
+    }
+    std::sort(nsPerOp.begin(), nsPerOp.end());
+
+    m_result.iterations = iterations;
+    m_result.samples = samples;
+    m_result.nsPerOpMin = nsPerOp.front();
+    m_result.nsPerOpMedian = nsPerOp[nsPerOp.size() / 2];
+    m_result.nsPerOpMean = std::accumulate(nsPerOp.begin(), nsPerOp.end(), 0.0) / static_cast<double>(nsPerOp.size());
+}
+
+BenchmarkRegistrar::BenchmarkRegistrar(const char* name, BenchmarkFn fn)
+{
+    registry().push_back(Registration{name, std::move(fn)});
+}
+
+std::vector<BenchmarkResult> runBenchmarks(const BenchmarkSettings& settings)
+{
+    auto cases = registry();
+    std::stable_sort(cases.begin(), cases.end(), [](const Registration& a, const Registration& b) { return a.name < b.name; });
+
+    std::vector<BenchmarkResult> results;
+    for (const auto& registration : cases)
+    {
+        if (!settings.filter.empty() && registration.name.find(settings.filter) == std::string::npos)
+            continue;
+
+        BenchmarkState state(registration.name, settings);
+        registration.fn(state);
+        if (state.result().samples > 0)
+        {
+            results.push_back(state.result());
+        }
+    }
+    return results;
+}
+
+std::string resultsToJson(const std::vector<BenchmarkResult>& results)
+{
+    std::ostringstream oss;
+    oss << std::setprecision(6);
+    oss << "{\n";
+    oss << "  \"context\": {\n";
+    oss << "    \"date\": \"" << timestamp() << "\",\n";
+#ifdef TYPEIT_BUILD_TYPE
+    oss << "    \"build_type\": \"" << escapeJson(TYPEIT_BUILD_TYPE) << "\",\n";
+#endif
+#if defined(__clang__)
+    oss << "    \"compiler\": \"clang " << __clang_major__ << "." << __clang_minor__ << "\"\n";
+#elif defined(__GNUC__)
+    oss << "    \"compiler\": \"gcc " << __GNUC__ << "." << __GNUC_MINOR__ << "\"\n";
+#elif defined(_MSC_VER)
+    oss << "    \"compiler\": \"msvc " << _MSC_VER << "\"\n";
+#else
+    oss << "    \"compiler\": \"unknown\"\n";
+#endif
+    oss << "  },\n";
+    oss << "  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const auto& r = results[i];
+        oss << (i == 0 ? "\n" : ",\n");
+        oss << "    {\"name\": \"" << escapeJson(r.name) << "\", \"iterations\": " << r.iterations << ", \"samples\": " << r.samples
+            << ", \"ns_per_op_min\": " << r.nsPerOpMin << ", \"ns_per_op_median\": " << r.nsPerOpMedian
+            << ", \"ns_per_op_mean\": " << r.nsPerOpMean;
+        if (r.itemsPerOp > 0.0)
+        {
+            oss << ", \"items_per_second\": " << r.itemsPerOp * 1e9 / r.nsPerOpMedian;
+        }
+        if (r.bytesPerOp > 0.0)
+        {
+            oss << ", \"bytes_per_second\": " << r.bytesPerOp * 1e9 / r.nsPerOpMedian;
+        }
+        if (!r.label.empty())
+        {
+            oss << ", \"label\": \"" << escapeJson(r.label) << "\"";
+        }
+        oss << "}";
+    }
+    oss << "\n  ]\n}\n";
+    return oss.str();
+}
+
+std::string resultsToTable(const std::vector<BenchmarkResult>& results)
+{
+    size_t nameWidth = 9;
+    for (const auto& r : results)
+    {
+        nameWidth = std::max(nameWidth, r.name.size());
+    }
+
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1);
+    oss << std::left << std::setw(static_cast<int>(nameWidth)) << "Benchmark" << std::right << std::setw(14) << "median ns" << std::setw(14)
+        << "min ns" << std::setw(12) << "iterations" << "  label\n";
+    for (const auto& r : results)
+    {
+        oss << std::left << std::setw(static_cast<int>(nameWidth)) << r.name << std::right << std::setw(14) << r.nsPerOpMedian << std::setw(14)
+            << r.nsPerOpMin << std::setw(12) << r.iterations << "  " << r.label << "\n";
+    }
+    return oss.str();
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Minimal self-calibrating benchmark harness. A case does its setup, then
+// hands the measured body to BenchmarkState::run(), which scales the
+// iteration count until a sample takes at least the minimum sample time and
+// then records several samples.
+struct BenchmarkResult
+{
+    std::string name;
+    uint64_t iterations = 0; // Per sample
+    int samples = 0;
+    double nsPerOpMin = 0.0;
+    double nsPerOpMedian = 0.0;
+    double nsPerOpMean = 0.0;
+    double itemsPerOp = 0.0; // 0 when the case doesn't count items
+    double bytesPerOp = 0.0;
+    std::string label;
+};
+
+struct BenchmarkSettings
+{
+    double minSampleMs = 20.0;
+    int samples = 5;
+    std::string filter; // Substring of the case name, empty runs everything
+};
+
+class BenchmarkState
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    BenchmarkState(std::string name, const BenchmarkSettings& settings);
+
+    template <typename Body>
+    void run(Body&& body)
+    {
+        runLoop([&](uint64_t iterations)
+                {
+                    for (uint64_t i = 0; i < iterations; ++i)
+                    {
+                        body();
+                    }
+                });
+    }
+
+    // Per-iteration throughput, reported as items/s and bytes/s
+    void setItemsPerOp(double items) { m_result.itemsPerOp = items; }
+    void setBytesPerOp(double bytes) { m_result.bytesPerOp = bytes; }
+    void setLabel(std::string label) { m_result.label = std::move(label); }
+
+    const BenchmarkResult& result() const { return m_result; }
+
+private:
+    const BenchmarkSettings& m_settings;
+    BenchmarkResult m_result;
+
+    void runLoop(const std::function<void(uint64_t)>& loop);
+};
+
+using BenchmarkFn = std::function<void(BenchmarkState&)>;
+
+// Registers a case at static-initialization time
+struct BenchmarkRegistrar
+{
+    BenchmarkRegistrar(const char* name, BenchmarkFn fn);
+};
+
+std::vector<BenchmarkResult> runBenchmarks(const BenchmarkSettings& settings);
+std::string resultsToJson(const std::vector<BenchmarkResult>& results);
+std::string resultsToTable(const std::vector<BenchmarkResult>& results);
+
+// Prevents the optimizer from discarding a computed value
+template <typename T>
+inline void doNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+#define TYPEIT_BENCH_CONCAT_INNER(a, b) a##b
+#define TYPEIT_BENCH_CONCAT(a, b) TYPEIT_BENCH_CONCAT_INNER(a, b)
+#define TYPEIT_BENCHMARK(name, fn) static const BenchmarkRegistrar TYPEIT_BENCH_CONCAT(s_benchmark_, __LINE__)(name, fn)
@@ -0,0 +1,218 @@
+#include "Benchmark.h"
+#include "BenchFixtures.h"
+#include "engine/BotTypist.h"
+#include "engine/GhostRunner.h"
+#include "models/GameRecord.h"
+#include "models/InputLog.h"
+#include "models/KeystrokeLog.h"
+#include "utils/AllocationCounter.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+namespace
+{
+void benchLoadWords(BenchmarkState& state)
+{
+    const std::string& path = bench::wordListPath();
+    WordManager manager;
+    state.run([&] { doNotOptimize(manager.loadFromFile(path)); });
+    state.setItemsPerOp(static_cast<double>(manager.getWordCount()));
+    state.setBytesPerOp(static_cast<double>(std::filesystem::file_size(path)));
+}
+
+void benchParseRecord(BenchmarkState& state)
+{
+    const std::string line = "72,96.5,183.2,2025-03-14 09:30,140,6,4,37";
+    state.run([&] { doNotOptimize(GameRecord::fromCSVLine(line)); });
+    state.setItemsPerOp(1.0);
+    state.setBytesPerOp(static_cast<double>(line.size()));
+}
+
+void benchEngineUpdate(BenchmarkState& state, size_t liveWords)
+{
+    bench::PopulatedEngine game(liveWords);
+    GameEngine& engine = game.engine();
+
+    // Words never move or spawn here, so every tick should be allocation free
+    uint64_t ticks = 0;
+    const uint64_t allocationsBefore = alloc::threadCount();
+    state.run(
+        [&]
+        {
+            engine.update(1.0f / 60.0f);
+            ++ticks;
+        }
+    );
+    char allocations[32];
+    std::snprintf(allocations, sizeof(allocations), "%.2f", static_cast<double>(alloc::threadCount() - allocationsBefore) / static_cast<double>(ticks));
+    state.setLabel(std::to_string(engine.getFallingWords().size()) + " live words, " + allocations + " allocs/tick");
+    state.setItemsPerOp(static_cast<double>(liveWords));
+}
+
+// A word that is never on screen scans every live word before failing,
+// which is the worst case of the matcher
+void benchCheckMatchMiss(BenchmarkState& state, size_t liveWords)
+{
+    bench::PopulatedEngine game(liveWords);
+    GameEngine& engine = game.engine();
+
+    const std::string typed = "zzzzzzzzzzzz"; // Longer than any generated word
+    state.setLabel("type + submit, " + std::to_string(engine.getFallingWords().size()) + " live words");
+    state.run(
+        [&]
+        {
+            for (char c : typed)
+            {
+                engine.handleCharInput(c);
+            }
+            engine.handleSpace();
+        }
+    );
+    state.setItemsPerOp(static_cast<double>(liveWords));
+}
+
+// A 24-key paste with the keystroke log on, fed one key at a time as the
+// event handler used to, or as one batch the way the simulation does now
+void benchPaste(BenchmarkState& state, size_t liveWords, bool batched)
+{
+    bench::PopulatedEngine game(liveWords);
+    GameEngine& engine = game.engine();
+    KeystrokeLog log;
+    log.begin(0);
+    engine.setKeystrokeLog(&log);
+
+    std::vector<KeyPress> keys(24, KeyPress{KeyPress::Type::Char, 'z', {}});
+    keys.push_back(KeyPress{KeyPress::Type::Space, 0, {}});
+    state.setLabel(std::to_string(keys.size()) + " keys, " + std::to_string(engine.getFallingWords().size()) + " live words");
+    state.run(
+        [&]
+        {
+            if (batched)
+            {
+                engine.handleKeys(keys);
+                return;
+            }
+            for (size_t i = 0; i + 1 < keys.size(); ++i)
+            {
+                engine.handleCharInput(keys[i].letter);
+            }
+            engine.handleSpace();
+        }
+    );
+    state.setItemsPerOp(static_cast<double>(keys.size()));
+}
+
+// Suspend and resume cost, the game's state with liveWords on the board
+void benchSaveSnapshot(BenchmarkState& state, size_t liveWords)
+{
+    bench::PopulatedEngine game(liveWords);
+    GameEngine& engine = game.engine();
+
+    const size_t bytes = engine.saveSnapshot().size();
+    state.setLabel(std::to_string(bytes) + " bytes");
+    state.run([&] { doNotOptimize(engine.saveSnapshot()); });
+    state.setBytesPerOp(static_cast<double>(bytes));
+}
+
+void benchRestoreSnapshot(BenchmarkState& state, size_t liveWords)
+{
+    bench::PopulatedEngine game(liveWords);
+    GameEngine& engine = game.engine();
+
+    const std::string snapshot = engine.saveSnapshot();
+    GameEngine restored(game.words());
+    state.setLabel(std::to_string(snapshot.size()) + " bytes");
+    state.run([&] { doNotOptimize(restored.restoreSnapshot(snapshot)); });
+    state.setBytesPerOp(static_cast<double>(snapshot.size()));
+}
+
+// Whole games against a bot opponent on the shipped dictionary, whose longest
+// words overflow the small-string buffer. Built with TYPEIT_ASSERT_NO_ALLOC
+// this checks that the bot's typing inside update() never allocates.
+void benchBotRace(BenchmarkState& state)
+{
+    WordManager words;
+    if (!words.loadFromFile(GamePaths::WORDS_FILE))
+    {
+        words.loadFromFile(bench::wordListPath());
+    }
+    GameSettings settings;
+    settings.botOpponent = true;
+    settings.botWpm = 120.0f;
+
+    uint32_t seed = 0;
+    uint64_t ticks = 0;
+    state.run(
+        [&]
+        {
+            GameEngine engine(words);
+            engine.start(100, settings, ++seed);
+            while (!engine.isGameOver() && engine.getElapsedTime() < 900.0f)
+            {
+                engine.update(GameEngine::kTickSeconds);
+                ++ticks;
+            }
+        }
+    );
+#ifdef TYPEIT_ASSERT_NO_ALLOC
+    const char* checked = ", allocation-free ticks asserted";
+#else
+    const char* checked = "";
+#endif
+    state.setLabel(std::to_string(seed) + " games, " + std::to_string(ticks / std::max<uint32_t>(seed, 1)) + " ticks/game" + checked);
+    state.setItemsPerOp(1.0);
+}
+
+// Replay cost of a recorded bot game, the extra work a ghost race adds per tick
+void benchGhostStep(BenchmarkState& state)
+{
+    WordManager words;
+    words.loadFromFile(bench::wordListPath());
+    const GameSettings settings;
+
+    InputLog log;
+    GameEngine engine(words);
+    engine.setInputLog(&log);
+    engine.start(100, settings, 7);
+    BotTypist typist(BotProfile{}, 7);
+    while (!engine.isGameOver() && engine.getElapsedTime() < 600.0f)
+    {
+        typist.update(engine, GameEngine::kTickSeconds);
+        engine.update(GameEngine::kTickSeconds);
+    }
+
+    GhostRunner ghost(words);
+    ghost.start(log, settings);
+    state.setLabel(std::to_string(log.events.size()) + " events over " + std::to_string(log.totalTicks) + " ticks");
+    state.run(
+        [&]
+        {
+            if (!ghost.isActive())
+            {
+                ghost.start(log, settings);
+            }
+            ghost.step();
+        }
+    );
+    state.setItemsPerOp(1.0);
+}
+} // namespace
+
+TYPEIT_BENCHMARK("WordManager::loadFromFile", benchLoadWords);
+TYPEIT_BENCHMARK("GameRecord::fromCSVLine", benchParseRecord);
+TYPEIT_BENCHMARK("GameEngine::update/8", [](BenchmarkState& state) { benchEngineUpdate(state, 8); });
+TYPEIT_BENCHMARK("GameEngine::update/100", [](BenchmarkState& state) { benchEngineUpdate(state, 100); });
+TYPEIT_BENCHMARK("GameEngine::update/10000", [](BenchmarkState& state) { benchEngineUpdate(state, 10000); });
+TYPEIT_BENCHMARK("GameEngine::checkMatch/8", [](BenchmarkState& state) { benchCheckMatchMiss(state, 8); });
+TYPEIT_BENCHMARK("GameEngine::checkMatch/100", [](BenchmarkState& state) { benchCheckMatchMiss(state, 100); });
+TYPEIT_BENCHMARK("GameEngine::checkMatch/10000", [](BenchmarkState& state) { benchCheckMatchMiss(state, 10000); });
+TYPEIT_BENCHMARK("GameEngine::paste/perKey/100", [](BenchmarkState& state) { benchPaste(state, 100, false); });
+TYPEIT_BENCHMARK("GameEngine::paste/batched/100", [](BenchmarkState& state) { benchPaste(state, 100, true); });
+TYPEIT_BENCHMARK("GameEngine::saveSnapshot/8", [](BenchmarkState& state) { benchSaveSnapshot(state, 8); });
+TYPEIT_BENCHMARK("GameEngine::saveSnapshot/100", [](BenchmarkState& state) { benchSaveSnapshot(state, 100); });
+TYPEIT_BENCHMARK("GameEngine::restoreSnapshot/8", [](BenchmarkState& state) { benchRestoreSnapshot(state, 8); });
+TYPEIT_BENCHMARK("GameEngine::restoreSnapshot/100", [](BenchmarkState& state) { benchRestoreSnapshot(state, 100); });
+TYPEIT_BENCHMARK("GameEngine::botRace", benchBotRace);
+TYPEIT_BENCHMARK("GhostRunner::step", benchGhostStep);
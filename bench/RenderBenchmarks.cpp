@@ -0,0 +1,118 @@
+#include "Benchmark.h"
+#include "BenchFixtures.h"
+#include "screens/GameScreen.h"
+#include "screens/WordField.h"
+#include "screens/WordPalette.h"
+#include "utils/AllocationCounter.h"
+#include "ftxui/dom/canvas.hpp"
+#include "ftxui/dom/elements.hpp"
+#include "ftxui/component/screen_interactive.hpp"
+#include "ftxui/dom/node.hpp"
+#include "ftxui/screen/screen.hpp"
+#include <string>
+
+namespace
+{
+// Builds the element tree through the screen's component, lays it out and
+// rasterizes it into an off-screen buffer; the terminal is never touched
+void benchGameScreenRender(BenchmarkState& state, int width, int height, size_t liveWords)
+{
+    bench::PopulatedEngine game(liveWords, width, height);
+    GameEngine& engine = game.engine();
+
+    auto interactive = ftxui::ScreenInteractive::FixedSize(width, height);
+    GameScreen screen(engine, interactive, nullptr, nullptr);
+    auto component = screen.createComponent();
+    auto target = ftxui::Screen(width, height);
+
+    uint64_t frames = 0;
+    const uint64_t allocationsBefore = alloc::threadCount();
+    state.run(
+        [&]
+        {
+            target.Clear();
+            ftxui::Render(target, component->Render());
+            ++frames;
+        }
+    );
+    const uint64_t allocationsPerFrame = (alloc::threadCount() - allocationsBefore) / frames;
+    state.setLabel(std::to_string(width) + "x" + std::to_string(height) + ", " + std::to_string(engine.getFallingWords().size()) +
+                   " live words, " + std::to_string(allocationsPerFrame) + " allocs/frame");
+    state.setItemsPerOp(1.0);
+}
+
+// Just the game field: the words of a populated board drawn through a braille
+// canvas, as the game screen used to, or straight into the screen cells
+void benchGameField(BenchmarkState& state, int width, int height, size_t liveWords, bool direct)
+{
+    bench::PopulatedEngine game(liveWords, width * 2, height * 2);
+    const WordPalette palette(game.engine().getSettings(), WordPalette::Depth::TrueColor);
+    const auto& live = game.engine().getFallingWords();
+    auto target = ftxui::Screen(width, height);
+
+    state.setLabel(std::to_string(width) + "x" + std::to_string(height) + ", " + std::to_string(live.size()) + " live words");
+    auto drawDirect = [&](WordField& field)
+    {
+        for (const auto& fw : live)
+        {
+            field.drawText(static_cast<int>(fw.x) / 2, static_cast<int>(fw.y) / 2, fw.word.text, palette.colorAt(fw.lifeProgress));
+        }
+    };
+    auto drawCanvas = [&](ftxui::Canvas& c)
+    {
+        for (const auto& fw : live)
+        {
+            c.DrawText(static_cast<int>(fw.x), static_cast<int>(fw.y * 2.0f), fw.word.text, palette.colorAt(fw.lifeProgress));
+        }
+    };
+
+    state.run(
+        [&]
+        {
+            // The element is built inside the loop, as the game screen does every frame
+            target.Clear();
+            ftxui::Render(target, direct ? wordField(drawDirect) : ftxui::canvas(drawCanvas) | ftxui::flex);
+        }
+    );
+    state.setItemsPerOp(static_cast<double>(live.size()));
+}
+
+// The colour of every live word, once computed from the gradient and once
+// looked up in the precomputed palette
+void benchWordColors(BenchmarkState& state, bool palette)
+{
+    bench::PopulatedEngine game(100);
+    const GameSettings& settings = game.engine().getSettings();
+    const WordPalette lookup(settings, WordPalette::Depth::TrueColor);
+
+    const auto& live = game.engine().getFallingWords();
+    state.setLabel(std::to_string(live.size()) + " live words");
+    state.run(
+        [&]
+        {
+            for (const auto& fw : live)
+            {
+                if (palette)
+                {
+                    doNotOptimize(lookup.colorAt(fw.lifeProgress));
+                }
+                else
+                {
+                    const auto rgb = FallingWord::gradientColor(fw.lifeProgress, settings);
+                    doNotOptimize(ftxui::Color::RGB(static_cast<uint8_t>(rgb.r), static_cast<uint8_t>(rgb.g), static_cast<uint8_t>(rgb.b)));
+                }
+            }
+        }
+    );
+    state.setItemsPerOp(static_cast<double>(live.size()));
+}
+} // namespace
+
+TYPEIT_BENCHMARK("GameScreen::render/80x24", [](BenchmarkState& state) { benchGameScreenRender(state, 80, 24, 8); });
+TYPEIT_BENCHMARK("GameScreen::render/300x100", [](BenchmarkState& state) { benchGameScreenRender(state, 300, 100, 100); });
+TYPEIT_BENCHMARK("gameField/canvas/80x24", [](BenchmarkState& state) { benchGameField(state, 80, 24, 8, false); });
+TYPEIT_BENCHMARK("gameField/direct/80x24", [](BenchmarkState& state) { benchGameField(state, 80, 24, 8, true); });
+TYPEIT_BENCHMARK("gameField/canvas/300x100", [](BenchmarkState& state) { benchGameField(state, 300, 100, 100, false); });
+TYPEIT_BENCHMARK("gameField/direct/300x100", [](BenchmarkState& state) { benchGameField(state, 300, 100, 100, true); });
+TYPEIT_BENCHMARK("wordColor/gradient", [](BenchmarkState& state) { benchWordColors(state, false); });
+TYPEIT_BENCHMARK("wordColor/palette", [](BenchmarkState& state) { benchWordColors(state, true); });
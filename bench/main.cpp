@@ -0,0 +1,65 @@
+#include "Benchmark.h"
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace
+{
+const char* kUsage = "Usage: typeit_bench [options]\n"
+                     "  --json <file>       Write results as JSON to file (default: stdout)\n"
+                     "  --filter <text>     Only run cases whose name contains text\n"
+                     "  --min-time <ms>     Minimum duration of one sample (default 20)\n"
+                     "  --samples <n>       Samples per case (default 5)\n";
+}
+
+int main(int argc, char* argv[])
+{
+    BenchmarkSettings settings;
+    std::string jsonPath;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        try
+        {
+            if (arg == "--json" && hasValue)
+                jsonPath = argv[++i];
+            else if (arg == "--filter" && hasValue)
+                settings.filter = argv[++i];
+            else if (arg == "--min-time" && hasValue)
+                settings.minSampleMs = std::stod(argv[++i]);
+            else if (arg == "--samples" && hasValue)
+                settings.samples = std::stoi(argv[++i]);
+            else
+            {
+                std::cerr << (arg == "-h" || arg == "--help" ? "" : "Unknown option: " + arg + "\n") << kUsage;
+                return arg == "-h" || arg == "--help" ? 0 : 1;
+            }
+        }
+        catch (...)
+        {
+            std::cerr << "Invalid value for " << arg << "\n" << kUsage;
+            return 1;
+        }
+    }
+
+    const auto results = runBenchmarks(settings);
+    std::cerr << resultsToTable(results);
+
+    const std::string json = resultsToJson(results);
+    if (jsonPath.empty())
+    {
+        std::cout << json;
+        return 0;
+    }
+
+    std::ofstream file(jsonPath, std::ios::trunc);
+    if (!file.is_open())
+    {
+        std::cerr << "Cannot write " << jsonPath << "\n";
+        return 1;
+    }
+    file << json;
+    return 0;
+}
@@ -1,14 +1,52 @@
 #include "Application.h"
+#include "utils/FrameArena.h"
 #include "utils/GameConfig.h"
+#include "utils/SnapshotIO.h"
+#include "utils/Trace.h"
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
 #include <iostream>
 
 using namespace ftxui;
 
-Application::Application()
-    : m_currentState(State::Menu)
+namespace
+{
+bool isReady(const std::shared_future<bool>& future)
+{
+    return future.valid() && future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+// Written next to the target and renamed over it, so a session killed
+// mid-write leaves the previous file intact
+bool writeFileAtomically(const std::string& path, const std::string& data)
+{
+    const std::string temp = path + ".tmp";
+    {
+        std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+            return false;
+        file.write(data.data(), static_cast<std::streamsize>(data.size()));
+        if (!file)
+            return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(temp, path, ec);
+    return !ec;
+}
+} // namespace
+
+Application::Application(const AppOptions& options)
+    : m_options(options)
+    , m_currentState(State::Menu)
     , m_isRunning(true)
     , m_screen(ScreenInteractive::Fullscreen())
+    , m_statsWorker(m_recordManager)
     , m_gameEngine(m_wordManager)
+    , m_ghost(m_wordManager)
     , m_isNewRecord(false)
 {}
 
@@ -18,17 +56,33 @@ Application::~Application()
     {
         m_activeScreen->onExit();
     }
+    waitForBackgroundLoads();
+    m_recordManager.setChangeListener(nullptr);
+    m_statsWorker.stop();
+
+    // Every traced thread has stopped by now
+    if (!m_options.tracePath.empty() && !trace::writeChromeTrace(m_options.tracePath))
+    {
+        std::cerr << "Error: could not write trace to " << m_options.tracePath << "\n";
+    }
 }
 
 void Application::run()
 {
-    initialize();
+    if (!m_options.tracePath.empty())
+    {
+        trace::enable();
+        trace::setThreadName("main");
+    }
 
-    if (!loadResources())
+    initialize();
+    if (!m_options.spectatePath.empty())
     {
-        std::cerr << "Error: Failed to load resources!\n";
-        std::cerr << "Please ensure data/words.txt exists.\n";
-        return;
+        m_spectator = std::make_unique<SpectatorSink>(SpectatorOptions{m_options.spectatePath});
+    }
+    if (m_options.lowBandwidthKBps > 0.0)
+    {
+        m_governor = std::make_unique<BandwidthGovernor>(m_options.lowBandwidthKBps * 1000.0);
     }
 
     m_exitClosure = m_screen.ExitLoopClosure();
@@ -38,18 +92,141 @@ void Application::run()
     m_loopRunning = true;
     m_screen.Loop(m_rootComponent);
     m_loopRunning = false;
+    if (m_spectator)
+    {
+        m_spectator->stop();
+    }
+    m_governor.reset();
+
+    waitForBackgroundLoads();
+    if (!m_wordsReady.get())
+    {
+        std::cerr << "Error: Failed to load resources!\n";
+        std::cerr << "Please ensure data/words.txt exists.\n";
+    }
+    if (m_options.startupProfile)
+    {
+        std::cerr << m_startupProfile.report();
+    }
+    if (m_options.tickJitter && m_tickJitter.summary().samples > 0)
+    {
+        std::cerr << m_tickJitter.report("Game tick");
+    }
 }
 
 void Application::initialize()
 {
-    // Load config file (creates default if not exists)
-    ConfigManager::instance().loadFromFile();
-    m_recordManager.loadRecords();
+    // Load config file (creates default if not exists). It is a few lines and
+    // the screens read it, so it stays ahead of the first frame.
+    m_startupProfile.measure("config", [] { return ConfigManager::instance().loadFromFile(); });
+
+    // Stats are recomputed in the background whenever the records change
+    m_recordManager.setChangeListener([this]() { m_statsWorker.notifyRecordsChanged(); });
+    m_statsWorker.setPublishCallback(
+        [this]()
+        {
+            if (m_loopRunning)
+            {
+                m_screen.Post(Event::Custom);
+            }
+        }
+    );
+    m_statsWorker.start();
+    startBackgroundLoads();
+}
+
+void Application::startBackgroundLoads()
+{
+    // Each loader fulfils its promise before asking for a redraw, so the
+    // frame it triggers already sees the option as ready
+    auto launch = [this](const char* phase, std::function<bool()> load, std::shared_future<bool>& ready)
+    {
+        auto promise = std::make_shared<std::promise<bool>>();
+        ready = promise->get_future().share();
+        return std::async(
+            std::launch::async,
+            [this, phase, load = std::move(load), promise]
+            {
+                trace::setThreadName(std::string("load ") + phase);
+                TYPEIT_TRACE_SCOPE(phase);
+                promise->set_value(m_startupProfile.measure(phase, load));
+                if (m_loopRunning)
+                {
+                    m_screen.Post(Event::Custom);
+                }
+            }
+        );
+    };
+
+    m_wordsTask = launch("dictionary", [this] { return m_wordManager.loadFromFile(GamePaths::WORDS_FILE); }, m_wordsReady);
+    m_recordsTask = launch(
+        "records",
+        [this]
+        {
+            // A missing or damaged file just starts the counters over
+            m_keyAnalytics.loadFromFile(m_recordManager.keyAnalyticsPath());
+            return m_recordManager.loadRecords();
+        },
+        m_recordsReady
+    );
+}
+
+void Application::waitForBackgroundLoads()
+{
+    if (m_wordsTask.valid())
+    {
+        m_wordsTask.wait();
+    }
+    if (m_recordsTask.valid())
+    {
+        m_recordsTask.wait();
+    }
+}
+
+std::string Application::menuStatus(MenuScreen::MenuOption option)
+{
+    switch (option)
+    {
+    case MenuScreen::MenuOption::StartGame:
+        if (!isReady(m_wordsReady))
+            return "loading words...";
+        return m_wordsReady.get() ? "" : std::string(GamePaths::WORDS_FILE) + " missing";
+    case MenuScreen::MenuOption::ResumeGame:
+        if (!menuStatus(MenuScreen::MenuOption::StartGame).empty())
+            return menuStatus(MenuScreen::MenuOption::StartGame);
+        return std::filesystem::exists(GamePaths::SUSPEND_FILE) ? "" : "nothing to resume";
+    case MenuScreen::MenuOption::GhostRace:
+        if (!menuStatus(MenuScreen::MenuOption::StartGame).empty())
+            return menuStatus(MenuScreen::MenuOption::StartGame);
+        return ghostRaceStatus();
+    case MenuScreen::MenuOption::ViewStats:
+        return isReady(m_recordsReady) ? "" : "loading records...";
+    case MenuScreen::MenuOption::Exit:
+        break;
+    }
+    return "";
 }
 
-bool Application::loadResources()
+std::string Application::ghostRaceStatus()
 {
-    return m_wordManager.loadFromFile(GamePaths::WORDS_FILE);
+    if (!isReady(m_recordsReady))
+        return "loading records...";
+
+    // Runs on every menu frame, so the log is only read when the best may have changed
+    const uint64_t version = m_recordManager.getVersion();
+    if (version == m_ghostCheckedVersion)
+        return m_ghostStatus;
+    m_ghostCheckedVersion = version;
+
+    const GameRecord best = m_recordManager.getBestRecord();
+    if (best.seed == 0 || !m_bestLog.loadFromFile(m_recordManager.inputLogPath(best)))
+        m_ghostStatus = "no replay of your best yet";
+    else if (m_bestLog.settingsFingerprint != ConfigManager::fingerprint(ConfigManager::instance().settings()) ||
+             m_bestLog.tickRate != static_cast<uint32_t>(std::lround(1.0f / GameEngine::kTickSeconds)))
+        m_ghostStatus = "best was set with other settings";
+    else
+        m_ghostStatus.clear();
+    return m_ghostStatus;
 }
 
 ftxui::Component Application::buildRootComponent()
@@ -57,12 +234,28 @@ ftxui::Component Application::buildRootComponent()
     auto renderer = Renderer(
         [this]
         {
-            std::shared_lock lock(m_componentMutex);
-            if (m_activeComponent)
+            if (!m_firstFrameDrawn.exchange(true))
             {
-                return m_activeComponent->Render();
+                m_startupProfile.mark("first frame");
             }
-            return ftxui::text("Loading...") | center;
+
+            if (m_governor)
+            {
+                m_governor->onFrame();
+            }
+
+            // Screens format into the frame arena while their tree is built
+            FrameArena::Frame frame;
+            Element root;
+            {
+                std::shared_lock lock(m_componentMutex);
+                root = m_activeComponent ? m_activeComponent->Render() : ftxui::text("Loading...") | center;
+            }
+            if (m_governor)
+            {
+                root = m_governor->decorate(std::move(root));
+            }
+            return m_spectator ? m_spectator->decorate(std::move(root)) : root;
         }
     );
 
@@ -127,6 +320,12 @@ void Application::showMenu()
             case MenuScreen::MenuOption::StartGame:
                 startGame();
                 break;
+            case MenuScreen::MenuOption::ResumeGame:
+                resumeGame();
+                break;
+            case MenuScreen::MenuOption::GhostRace:
+                startGhostRace();
+                break;
             case MenuScreen::MenuOption::ViewStats:
                 showStatsScreen();
                 break;
@@ -138,28 +337,124 @@ void Application::showMenu()
                 }
                 break;
             }
-        }
+        },
+        [this](MenuScreen::MenuOption option) { return menuStatus(option); }
     );
 
     setScreen(menuScreen);
 }
 
 void Application::startGame()
+{
+    beginGame(std::random_device{}(), nullptr);
+}
+
+void Application::startGhostRace()
+{
+    // Same seed as the best game, so both boards get the same words at the same moments
+    m_ghost.start(m_bestLog, ConfigManager::instance().settings());
+    beginGame(m_bestLog.seed, &m_ghost);
+}
+
+void Application::beginGame(uint32_t seed, GhostRunner* ghost)
 {
     constexpr int kScreenWidth = 100;
-    m_gameEngine.start(kScreenWidth);
+    m_racingGhost = ghost != nullptr;
+    if (!m_racingGhost)
+    {
+        m_ghost.stop();
+    }
+    m_gameEngine.setInputLog(&m_inputLog);
+    m_gameEngine.setKeystrokeLog(&m_keystrokes);
+    m_gameEngine.start(kScreenWidth, ConfigManager::instance().settings(), seed);
+    showGameScreen();
+}
 
-    auto gameScreen = std::make_shared<GameScreen>(m_gameEngine, m_screen, [this]() { handleGameFinished(); }, [this]() { showMenu(); });
+void Application::showGameScreen()
+{
+    auto gameScreen = std::make_shared<GameScreen>(
+        m_gameEngine,
+        m_screen,
+        [this]() { handleGameFinished(); },
+        [this]()
+        {
+            suspendGame();
+            showMenu();
+        },
+        m_racingGhost ? &m_ghost : nullptr,
+        m_governor.get(),
+        &m_tickJitter
+    );
 
     m_gameScreen = gameScreen;
     setScreen(gameScreen);
 }
 
+void Application::suspendGame()
+{
+    // The engine, the logs recorded so far and the ghost
+    std::string data;
+    varint::putString(data, m_gameEngine.saveSnapshot());
+    varint::putString(data, m_inputLog.encode());
+    varint::putString(data, m_keystrokes.encode());
+    snapshot::putBool(data, m_racingGhost);
+    if (m_racingGhost)
+    {
+        m_ghost.saveState(data);
+    }
+    m_gameEngine.stop();
+    m_ghost.stop();
+
+    // A failed write shows up as "nothing to resume" on the menu
+    writeFileAtomically(GamePaths::SUSPEND_FILE, data);
+}
+
+void Application::resumeGame()
+{
+    std::string data;
+    {
+        std::ifstream file(GamePaths::SUSPEND_FILE, std::ios::binary);
+        data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    // A game is resumed once; an unreadable one would never get better
+    std::error_code ec;
+    std::filesystem::remove(GamePaths::SUSPEND_FILE, ec);
+
+    std::string_view in = data;
+    std::string engineState, logState, keystrokeState;
+    bool racingGhost = false;
+    if (!varint::getString(in, engineState) || !varint::getString(in, logState) || !varint::getString(in, keystrokeState) ||
+        !snapshot::getBool(in, racingGhost) || (racingGhost && !m_ghost.restoreState(in)) || !m_gameEngine.restoreSnapshot(engineState) ||
+        !m_inputLog.decode(logState) || !m_keystrokes.decode(keystrokeState))
+    {
+        m_ghost.stop();
+        showMenu();
+        return;
+    }
+
+    m_racingGhost = racingGhost;
+    m_gameEngine.setInputLog(&m_inputLog);
+    m_gameEngine.setKeystrokeLog(&m_keystrokes);
+    m_gameEngine.resume();
+    showGameScreen();
+}
+
 void Application::handleGameFinished()
 {
     m_lastGameRecord = m_gameEngine.getResult();
+    // A quick first game can finish before the history is in; the new-record
+    // check needs it
+    m_recordsReady.wait();
     m_isNewRecord = m_recordManager.isNewRecord(m_lastGameRecord);
     m_recordManager.saveRecord(m_lastGameRecord);
+    // Only the best game is ever raced, so only its log is kept
+    if (m_isNewRecord)
+    {
+        m_inputLog.saveToFile(m_recordManager.inputLogPath(m_lastGameRecord));
+    }
+    m_keystrokes.saveToFile(m_recordManager.keystrokeLogPath(m_lastGameRecord));
+    m_keyAnalytics.addGame(m_keystrokes);
+    m_keyAnalytics.saveToFile(m_recordManager.keyAnalyticsPath());
 
     showResultScreen(m_lastGameRecord, m_isNewRecord);
 }
@@ -173,7 +468,16 @@ void Application::showResultScreen(const GameRecord& record, bool isNewRecord)
 
 void Application::showStatsScreen()
 {
-    auto statsScreen = std::make_shared<StatsScreen>(m_recordManager, [this]() { showMenu(); });
+    auto statsScreen = std::make_shared<StatsScreen>(
+        m_recordManager, m_statsWorker, [this]() { showMenu(); }, [this]() { showAnalyticsScreen(); }
+    );
 
     setScreen(statsScreen);
 }
+
+void Application::showAnalyticsScreen()
+{
+    auto analyticsScreen = std::make_shared<AnalyticsScreen>(m_keyAnalytics, [this]() { showStatsScreen(); });
+
+    setScreen(analyticsScreen);
+}
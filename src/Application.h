@@ -1,22 +1,36 @@
 #pragma once
 
 #include "engine/GameEngine.h"
+#include "engine/GhostRunner.h"
+#include "managers/KeyAnalytics.h"
 #include "managers/RecordManager.h"
+#include "managers/StatsWorker.h"
 #include "managers/WordManager.h"
+#include "models/InputLog.h"
+#include "models/KeystrokeLog.h"
+#include "screens/AnalyticsScreen.h"
+#include "screens/BandwidthGovernor.h"
 #include "screens/GameScreen.h"
 #include "screens/MenuScreen.h"
 #include "screens/ResultScreen.h"
+#include "screens/SpectatorSink.h"
 #include "screens/StatsScreen.h"
+#include "utils/AppOptions.h"
+#include "utils/JitterStats.h"
+#include "utils/StartupProfile.h"
 #include "ftxui/component/component.hpp"
 #include "ftxui/component/screen_interactive.hpp"
+#include <atomic>
+#include <cstdint>
 #include <functional>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <shared_mutex>
 
 class Application {
 public:
-    Application();
+    explicit Application(const AppOptions& options = {});
     ~Application();
     
     void run();
@@ -29,6 +43,9 @@ private:
         Stats
     };
     
+    // First member so its origin is as close to launch as possible
+    StartupProfile m_startupProfile;
+    AppOptions m_options;
     State m_currentState;
     bool m_isRunning;
     ftxui::ScreenInteractive m_screen;
@@ -36,7 +53,18 @@ private:
     // Managers
     WordManager m_wordManager;
     RecordManager m_recordManager;
+    StatsWorker m_statsWorker;
     GameEngine m_gameEngine;
+    InputLog m_inputLog; // Keystrokes of the game in progress, kept when it sets a new best
+    KeystrokeLog m_keystrokes; // Timed keystrokes of the game in progress, kept for every game
+    KeyAnalytics m_keyAnalytics; // Loaded with the records, fed by every finished game
+    GhostRunner m_ghost;
+    bool m_racingGhost = false;
+
+    // Replay of the personal best, checked again whenever the records change
+    InputLog m_bestLog;
+    std::string m_ghostStatus;
+    uint64_t m_ghostCheckedVersion = UINT64_MAX;
     
     // Result data
     GameRecord m_lastGameRecord;
@@ -46,20 +74,43 @@ private:
     ftxui::Component m_activeComponent;
     std::shared_mutex m_componentMutex;
     std::function<void()> m_exitClosure;
-    bool m_loopRunning = false;
+    std::atomic<bool> m_loopRunning = false;
     std::shared_ptr<GameScreen> m_gameScreen;
     std::shared_ptr<BaseScreen> m_activeScreen;
 
+    // Dictionary and records load in the background while the menu is up;
+    // the shared futures hold each loader's result once it is done
+    std::shared_future<bool> m_wordsReady;
+    std::shared_future<bool> m_recordsReady;
+    std::future<void> m_wordsTask;
+    std::future<void> m_recordsTask;
+    std::atomic<bool> m_firstFrameDrawn = false;
+    // Set with --spectate
+    std::unique_ptr<SpectatorSink> m_spectator;
+    // Wake-up jitter of every game's tick loop, logged on exit
+    JitterStats m_tickJitter;
+    // Set with --low-bandwidth
+    std::unique_ptr<BandwidthGovernor> m_governor;
+
     void initialize();
-    bool loadResources();
+    void startBackgroundLoads();
+    void waitForBackgroundLoads();
+    std::string menuStatus(MenuScreen::MenuOption option);
+    std::string ghostRaceStatus();
     ftxui::Component buildRootComponent();
     void setActiveComponent(ftxui::Component component);
     void setScreen(std::shared_ptr<BaseScreen> screen);
 
     void showMenu();
     void startGame();
+    void startGhostRace();
+    void beginGame(uint32_t seed, GhostRunner* ghost);
+    void showGameScreen();
+    void suspendGame();
+    void resumeGame();
     void showResultScreen(const GameRecord& record, bool isNewRecord);
     void showStatsScreen();
+    void showAnalyticsScreen();
     void handleGameFinished();
 };
 
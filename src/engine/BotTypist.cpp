@@ -0,0 +1,256 @@
+#include "BotTypist.h"
+#include "../utils/SnapshotIO.h"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <string_view>
+#include <utility>
+
+namespace
+{
+// Keys around each letter on a QWERTY keyboard, indexed by letter
+const std::array<const char*, 26> kNeighbours = {
+    "qwsz",   // a
+    "vghn",   // b
+    "xdfv",   // c
+    "serfcx", // d
+    "wsdr",   // e
+    "drtgvc", // f
+    "ftyhbv", // g
+    "gyujnb", // h
+    "ujko",   // i
+    "huikmn", // j
+    "jiolm",  // k
+    "kop",    // l
+    "njk",    // m
+    "bhjm",   // n
+    "iklp",   // o
+    "ol",     // p
+    "wa",     // q
+    "edft",   // r
+    "awedxz", // s
+    "rfgy",   // t
+    "yhji",   // u
+    "cfgb",   // v
+    "qase",   // w
+    "zsdc",   // x
+    "tghu",   // y
+    "asx",    // z
+};
+
+// The bot's player on a local engine
+class EngineSurface : public TypingSurface
+{
+public:
+    EngineSurface(GameEngine& engine, PlayerId player) : m_engine(engine), m_player(player) {}
+
+    const std::vector<FallingWord>& fallingWords() const override { return m_engine.getFallingWords(); }
+    int visibleWidth() const override { return m_engine.getVisibleWidth(); }
+    bool acceptingInput() const override { return m_engine.isRunning() && !m_engine.isGameOver(); }
+    void typeChar(char c) override { m_engine.handleCharInput(c, m_player); }
+    void typeBackspace() override { m_engine.handleBackspace(m_player); }
+    void typeSpace() override { m_engine.handleSpace(m_player); }
+
+private:
+    GameEngine& m_engine;
+    PlayerId m_player;
+};
+
+std::lognormal_distribution<float> intervalDistribution(const BotProfile& profile)
+{
+    // A standard word is five characters; pick mu so the mean interval matches the WPM
+    const float mean = 60.0f / (std::max(1.0f, profile.wpm) * 5.0f);
+    const float sigma = std::max(0.0f, profile.keyIntervalSpread);
+    return std::lognormal_distribution<float>(std::log(mean) - 0.5f * sigma * sigma, sigma);
+}
+} // namespace
+
+BotTypist::BotTypist(const BotProfile& profile, uint32_t seed, PlayerId player)
+    : m_profile(profile), m_player(player), m_gen(seed), m_interval(intervalDistribution(profile))
+{
+    // Picking a target runs inside the engine's allocation-free tick, and
+    // some words are longer than the small-string buffer
+    m_target.reserve(GameEngine::kInputCapacity);
+}
+
+void BotTypist::saveState(std::string& out) const
+{
+    snapshot::putFloat(out, m_profile.wpm);
+    snapshot::putFloat(out, m_profile.reactionTime);
+    snapshot::putFloat(out, m_profile.errorRate);
+    snapshot::putFloat(out, m_profile.keyIntervalSpread);
+    snapshot::putFloat(out, m_profile.correctionPause);
+    varint::put(out, m_player);
+    varint::put(out, m_gen.getSeed());
+    varint::put(out, m_gen.getDraws());
+    snapshot::putStreamed(out, m_interval);
+    varint::putString(out, m_target);
+    varint::put(out, m_typed);
+    varint::put(out, m_wrong);
+    varint::put(out, static_cast<uint64_t>(m_noticeIn));
+    snapshot::putBool(out, m_correcting);
+    snapshot::putFloat(out, m_nextKeyIn);
+}
+
+bool BotTypist::restoreState(std::string_view& in, uint64_t maxDraws)
+{
+    BotTypist bot(BotProfile{}, 0);
+    uint32_t seed = 0;
+    uint64_t draws = 0;
+    const bool ok = snapshot::getFloat(in, bot.m_profile.wpm) && snapshot::getFloat(in, bot.m_profile.reactionTime) &&
+                    snapshot::getFloat(in, bot.m_profile.errorRate) && snapshot::getFloat(in, bot.m_profile.keyIntervalSpread) &&
+                    snapshot::getFloat(in, bot.m_profile.correctionPause) && snapshot::getInt(in, bot.m_player) &&
+                    snapshot::getInt(in, seed) && varint::get(in, draws) && snapshot::getStreamed(in, bot.m_interval) && varint::getString(in, bot.m_target) &&
+                    snapshot::getInt(in, bot.m_typed) && snapshot::getInt(in, bot.m_wrong) && snapshot::getInt(in, bot.m_noticeIn) &&
+                    snapshot::getBool(in, bot.m_correcting) && snapshot::getFloat(in, bot.m_nextKeyIn);
+    // The generator catches up by discarding, so a corrupt count would hang here
+    if (!ok || bot.m_typed + bot.m_wrong > bot.m_target.size() || draws > maxDraws)
+        return false;
+    bot.m_gen.restore(seed, draws);
+
+    *this = std::move(bot);
+    return true;
+}
+
+void BotTypist::update(GameEngine& engine, float deltaTime)
+{
+    EngineSurface surface(engine, m_player);
+    update(surface, deltaTime);
+}
+
+void BotTypist::update(TypingSurface& surface, float deltaTime)
+{
+    m_nextKeyIn -= deltaTime;
+    while (m_nextKeyIn <= 0.0f && surface.acceptingInput())
+    {
+        m_nextKeyIn += step(surface);
+    }
+}
+
+float BotTypist::step(TypingSurface& surface)
+{
+    if (m_target.empty())
+    {
+        if (!pickTarget(surface))
+            return kIdlePoll;
+        std::uniform_real_distribution<float> jitter(0.8f, 1.2f);
+        return m_profile.reactionTime * jitter(m_gen);
+    }
+
+    if (!targetOnScreen(surface))
+    {
+        // The word escaped or was taken, erase what was typed so far
+        if (m_typed + m_wrong > 0)
+        {
+            surface.typeBackspace();
+            if (m_wrong > 0)
+                --m_wrong;
+            else
+                --m_typed;
+            return keyInterval();
+        }
+        m_target.clear();
+        m_correcting = false;
+        return 0.0f;
+    }
+
+    if (m_wrong > 0)
+    {
+        // A typo nobody has noticed yet keeps the fingers going; a finished
+        // word is always checked before it is submitted
+        if (!m_correcting && m_noticeIn > 0 && m_typed + m_wrong < m_target.size())
+        {
+            --m_noticeIn;
+            typeNext(surface);
+            return keyInterval();
+        }
+        if (!m_correcting)
+        {
+            m_correcting = true;
+            return m_profile.correctionPause;
+        }
+        surface.typeBackspace();
+        if (--m_wrong == 0)
+            m_correcting = false;
+        return keyInterval();
+    }
+
+    if (m_typed < m_target.size())
+    {
+        typeNext(surface);
+        return keyInterval();
+    }
+
+    surface.typeSpace();
+    m_target.clear();
+    m_typed = 0;
+    return keyInterval();
+}
+
+void BotTypist::typeNext(TypingSurface& surface)
+{
+    const char intended = m_target[std::min(m_typed + m_wrong, m_target.size() - 1)];
+    if (m_wrong > 0)
+    {
+        // Past a typo every key lands after it, right or not
+        surface.typeChar(intended);
+        ++m_wrong;
+        return;
+    }
+
+    std::bernoulli_distribution typo(std::clamp(m_profile.errorRate, 0.0f, 1.0f));
+    if (typo(m_gen))
+    {
+        surface.typeChar(neighbourOf(intended));
+        m_wrong = 1;
+        m_noticeIn = std::uniform_int_distribution<int>(0, kMaxNoticeDelay)(m_gen);
+        return;
+    }
+
+    surface.typeChar(intended);
+    ++m_typed;
+}
+
+bool BotTypist::pickTarget(const TypingSurface& surface)
+{
+    const int width = surface.visibleWidth();
+    const FallingWord* best = nullptr;
+    for (const auto& fw : surface.fallingWords())
+    {
+        if (fw.isVisible(width) && (!best || fw.x > best->x))
+        {
+            best = &fw;
+        }
+    }
+    if (!best)
+        return false;
+
+    m_target = best->word.text;
+    m_typed = 0;
+    m_wrong = 0;
+    m_correcting = false;
+    return true;
+}
+
+bool BotTypist::targetOnScreen(const TypingSurface& surface) const
+{
+    const int width = surface.visibleWidth();
+    const auto& words = surface.fallingWords();
+    return std::any_of(words.begin(), words.end(), [&](const FallingWord& fw) { return fw.isVisible(width) && fw.word.text == m_target; });
+}
+
+float BotTypist::keyInterval()
+{
+    return m_interval(m_gen);
+}
+
+char BotTypist::neighbourOf(char c)
+{
+    const char lower = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    if (lower < 'a' || lower > 'z')
+        return c;
+    const std::string_view keys = kNeighbours[lower - 'a'];
+    std::uniform_int_distribution<size_t> pick(0, keys.size() - 1);
+    return keys[pick(m_gen)];
+}
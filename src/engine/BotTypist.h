@@ -0,0 +1,88 @@
+#pragma once
+
+#include "GameEngine.h"
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Skill of a simulated typist
+struct BotProfile
+{
+    float wpm = 60.0f;              // Typing speed in standard 5-character words per minute
+    float reactionTime = 0.35f;     // Pause before starting on a new word (seconds)
+    float errorRate = 0.0f;         // Chance that a keystroke hits a neighbouring key
+    float keyIntervalSpread = 0.35f; // Sigma of the log-normal inter-key interval, 0 types like a metronome
+    float correctionPause = 0.25f;  // Pause between noticing a typo and reaching for backspace
+};
+
+// What a bot reads and types into: a local engine, or a client mirroring a
+// remote race
+class TypingSurface
+{
+public:
+    virtual ~TypingSurface() = default;
+
+    virtual const std::vector<FallingWord>& fallingWords() const = 0;
+    virtual int visibleWidth() const = 0;
+    virtual bool acceptingInput() const = 0;
+    virtual void typeChar(char c) = 0;
+    virtual void typeBackspace() = 0;
+    virtual void typeSpace() = 0;
+};
+
+// Simulated player that types through the engine's normal input calls.
+// It always goes for the word closest to escaping, and erases its input
+// when that word disappears before it is finished.
+//
+// Keystrokes are spaced by a log-normal interval whose mean matches the
+// profile's WPM. A typo hits a key next to the intended one on a QWERTY
+// layout; the bot notices it zero to two keystrokes later, pauses, and
+// backspaces to the last correct character.
+class BotTypist
+{
+public:
+    // Far above what a keystroke costs (a handful of draws) times the keys
+    // even a very fast bot types in a tick
+    static constexpr uint64_t kMaxDrawsPerTick = 64;
+
+    BotTypist(const BotProfile& profile, uint32_t seed, PlayerId player = kLocalPlayer);
+
+    // Advances the bot's clock and sends every keystroke that falls due
+    void update(GameEngine& engine, float deltaTime);
+    void update(TypingSurface& surface, float deltaTime);
+
+    // Everything the bot knows, its random generator included, for game snapshots
+    void saveState(std::string& out) const;
+    // Returns false for a malformed state, or one whose generator has made
+    // more than maxDraws draws, leaving the bot unchanged
+    bool restoreState(std::string_view& in, uint64_t maxDraws);
+
+    const BotProfile& getProfile() const { return m_profile; }
+    PlayerId getPlayer() const { return m_player; }
+
+private:
+    // Poll interval while there is nothing to type
+    static constexpr float kIdlePoll = 0.05f;
+    static constexpr int kMaxNoticeDelay = 2;
+
+    BotProfile m_profile;
+    PlayerId m_player;
+    GameRng m_gen;
+    std::lognormal_distribution<float> m_interval;
+    std::string m_target;
+    size_t m_typed = 0;  // Correct prefix of m_target in the engine's input
+    size_t m_wrong = 0;  // Characters typed after the first typo
+    int m_noticeIn = 0;  // Keystrokes left before the typo is noticed
+    bool m_correcting = false;
+    float m_nextKeyIn = 0.0f;
+
+    // Returns the delay until the next keystroke
+    float step(TypingSurface& surface);
+    void typeNext(TypingSurface& surface);
+    bool pickTarget(const TypingSurface& surface);
+    bool targetOnScreen(const TypingSurface& surface) const;
+    float keyInterval();
+    char neighbourOf(char c);
+};
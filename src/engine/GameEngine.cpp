@@ -1,20 +1,101 @@
 #include "GameEngine.h"
+#include "BotTypist.h"
+#include "../models/InputLog.h"
+#include "../models/KeystrokeLog.h"
+#include "../utils/AllocationCounter.h"
+#include "../utils/SnapshotIO.h"
+#include "../utils/Trace.h"
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <iomanip>
+#include <limits>
 #include <sstream>
 
-GameEngine::GameEngine(WordManager& wordManager) : m_wordManager(wordManager), m_visibleWidth(100), m_visibleHeight(15), m_gen(m_rd()) {}
+namespace
+{
+constexpr std::string_view kSnapshotMagic = "TIS";
+
+void writeStats(std::string& out, const GameStats& stats)
+{
+    varint::put(out, static_cast<uint64_t>(stats.correctWords));
+    varint::put(out, static_cast<uint64_t>(stats.missedWords));
+    varint::put(out, static_cast<uint64_t>(stats.wrongAttempts));
+    varint::put(out, static_cast<uint64_t>(stats.currentCombo));
+    varint::put(out, static_cast<uint64_t>(stats.maxCombo));
+    snapshot::putFloat(out, stats.health);
+}
+
+bool readStats(std::string_view& in, GameStats& stats)
+{
+    return snapshot::getInt(in, stats.correctWords) && snapshot::getInt(in, stats.missedWords) && snapshot::getInt(in, stats.wrongAttempts) &&
+           snapshot::getInt(in, stats.currentCombo) && snapshot::getInt(in, stats.maxCombo) && snapshot::getFloat(in, stats.health);
+}
+
+void writeWord(std::string& out, const FallingWord& fw)
+{
+    varint::putString(out, fw.word.text);
+    varint::putString(out, fw.word.definition);
+    varint::put(out, fw.id);
+    snapshot::putFloat(out, fw.x);
+    snapshot::putFloat(out, fw.y);
+    snapshot::putFloat(out, fw.lifeProgress);
+    snapshot::putFloat(out, fw.age);
+    snapshot::putFloat(out, fw.sinceTeleport);
+    snapshot::putFloat(out, fw.teleportInterval);
+    varint::put(out, static_cast<uint64_t>(fw.teleportCount));
+    snapshot::putBool(out, fw.isActive);
+}
+
+bool readWord(std::string_view& in, FallingWord& fw)
+{
+    std::string text, definition;
+    if (!varint::getString(in, text) || !varint::getString(in, definition))
+        return false;
+    fw = FallingWord(Word(text, definition), 0.0f, 0.0f);
+    return snapshot::getInt(in, fw.id) && snapshot::getFloat(in, fw.x) && snapshot::getFloat(in, fw.y) && snapshot::getFloat(in, fw.lifeProgress) &&
+           snapshot::getFloat(in, fw.age) && snapshot::getFloat(in, fw.sinceTeleport) && snapshot::getFloat(in, fw.teleportInterval) &&
+           snapshot::getInt(in, fw.teleportCount) && snapshot::getBool(in, fw.isActive);
+}
+} // namespace
+
+GameEngine::GameEngine(const WordManager& wordManager) : m_wordManager(wordManager), m_visibleWidth(100), m_visibleHeight(15), m_players(1) {}
+
+GameEngine::~GameEngine() = default;
 
 void GameEngine::start(int screenWidth)
 {
-    const auto& cfg = ConfigManager::instance().settings();
+    start(screenWidth, ConfigManager::instance().settings(), std::random_device{}());
+}
+
+void GameEngine::start(int screenWidth, const GameSettings& settings, uint32_t seed)
+{
+    m_settings = settings;
+    m_seed = seed;
+    m_gen.seed(seed);
+    const auto& cfg = m_settings;
 
     updateVisibleArea(screenWidth, cfg.gameAreaHeight);
     m_isRunning = true;
     m_isPaused = false;
-    m_startTime = std::chrono::steady_clock::now();
-    m_totalPausedTime = 0.0f;
+    m_gameTime = 0.0f;
+    m_tickCount = 0;
+    m_inputTime = {};
+    m_inputTickOffset = 0.0f;
+    m_speed.reset();
+
+    if (m_inputLog)
+    {
+        m_inputLog->clear();
+        m_inputLog->seed = seed;
+        m_inputLog->tickRate = static_cast<uint32_t>(std::lround(1.0f / kTickSeconds));
+        m_inputLog->settingsFingerprint = ConfigManager::fingerprint(m_settings);
+        m_inputLog->addResize(0, getVisibleWidth(), getVisibleHeight());
+    }
+    if (m_keystrokeLog)
+    {
+        m_keystrokeLog->begin(seed);
+    }
 
     // Reset difficulty from config
     m_currentTeleportInterval = cfg.baseTeleportInterval;
@@ -23,26 +104,79 @@ void GameEngine::start(int screenWidth)
 
     // Reset state
     m_fallingWords.clear();
-    m_currentInput.clear();
-    m_stats = GameStats();
-    m_stats.health = cfg.maxHealth;
+    m_nextWordId = 0;
+    m_players.clear();
+    addPlayer();
+    m_bots.clear();
+    localStats().health = cfg.maxHealth;
 
     m_nextSpawnTime = getRandomSpawnInterval();
     m_flashRedBorder = false;
+    m_flashStartTime = 0.0f;
+
+    if (cfg.botOpponent)
+    {
+        BotProfile profile;
+        profile.wpm = cfg.botWpm;
+        profile.errorRate = cfg.botErrorRate;
+        profile.reactionTime = cfg.botReactionTime;
+        addBotOpponent(profile);
+    }
+}
+
+PlayerId GameEngine::addPlayer()
+{
+    m_players.emplace_back();
+    // Longer than any word, so typing never allocates
+    m_players.back().input.reserve(kInputCapacity);
+    return static_cast<PlayerId>(m_players.size() - 1);
+}
+
+void GameEngine::resetPlayer(PlayerId player)
+{
+    // clear() keeps the reserved capacity
+    m_players[player].input.clear();
+    m_players[player].stats = GameStats();
+}
+
+PlayerId GameEngine::addBotOpponent(const BotProfile& profile)
+{
+    const PlayerId player = addPlayer();
+    // Seeded from the game's generator, so a seeded game replays the same race
+    m_bots.push_back(std::make_unique<BotTypist>(profile, static_cast<uint32_t>(m_gen()), player));
+    return player;
 }
 
 void GameEngine::update(float deltaTime)
 {
+    TYPEIT_TRACE_SCOPE("GameEngine::update");
     if (!m_isRunning || m_isPaused)
         return;
 
-    const auto& cfg = ConfigManager::instance().settings();
+    const auto& cfg = m_settings;
+    m_gameTime += deltaTime;
+    ++m_tickCount;
+    if (m_inputLog)
+    {
+        m_inputLog->totalTicks = m_tickCount;
+    }
+
+    {
+        // Everything but a spawn works on memory allocated up front
+        TYPEIT_NO_ALLOC_SCOPE("GameEngine::update");
 
-    // Update difficulty (teleport interval decreases over time)
-    updateDifficulty(deltaTime);
+        // Update difficulty (teleport interval decreases over time)
+        updateDifficulty(deltaTime);
 
-    // Update falling words
-    updateFallingWords(deltaTime);
+        // Update falling words
+        updateFallingWords(deltaTime);
+
+        // Opponents type through the same input path as the player
+        for (auto& bot : m_bots)
+        {
+            bot->update(*this, deltaTime);
+        }
+    }
 
     // Check if we need to spawn a new word
     m_nextSpawnTime -= deltaTime;
@@ -55,21 +189,164 @@ void GameEngine::update(float deltaTime)
     // Update red border flash effect
     if (m_flashRedBorder)
     {
-        auto now = std::chrono::steady_clock::now();
-        float elapsed = std::chrono::duration<float>(now - m_flashStartTime).count();
-        if (elapsed >= cfg.borderFlashDuration)
+        if (m_gameTime - m_flashStartTime >= cfg.borderFlashDuration)
         {
             m_flashRedBorder = false;
         }
     }
 }
 
+std::string GameEngine::saveSnapshot() const
+{
+    TYPEIT_TRACE_SCOPE("GameEngine::saveSnapshot");
+    std::string out(kSnapshotMagic);
+    varint::put(out, kSnapshotVersion);
+
+    // Settings as config text, with enough digits to read back every float exactly
+    std::ostringstream settings;
+    settings.precision(std::numeric_limits<float>::max_digits10);
+    ConfigManager::writeSettings(settings, m_settings);
+    varint::putString(out, settings.str());
+
+    varint::put(out, m_seed);
+    varint::put(out, m_tickCount);
+    varint::put(out, m_nextWordId);
+    varint::put(out, static_cast<uint64_t>(m_visibleWidth.load()));
+    varint::put(out, static_cast<uint64_t>(m_visibleHeight.load()));
+    snapshot::putBool(out, m_isRunning);
+    snapshot::putBool(out, m_isPaused);
+    snapshot::putBool(out, m_flashRedBorder);
+    snapshot::putFloat(out, m_gameTime);
+    snapshot::putFloat(out, m_flashStartTime);
+    snapshot::putFloat(out, m_nextSpawnTime);
+    snapshot::putFloat(out, m_currentTeleportInterval);
+    snapshot::putFloat(out, m_currentSpawnIntervalMin);
+    snapshot::putFloat(out, m_currentSpawnIntervalMax);
+    varint::put(out, m_gen.getSeed());
+    varint::put(out, m_gen.getDraws());
+
+    varint::put(out, m_players.size());
+    for (const auto& player : m_players)
+    {
+        varint::putString(out, player.input);
+        writeStats(out, player.stats);
+    }
+
+    varint::put(out, m_fallingWords.size());
+    for (const auto& fw : m_fallingWords)
+    {
+        writeWord(out, fw);
+    }
+
+    varint::put(out, m_bots.size());
+    for (const auto& bot : m_bots)
+    {
+        bot->saveState(out);
+    }
+    m_speed.save(out);
+    return out;
+}
+
+bool GameEngine::restoreSnapshot(std::string_view data)
+{
+    TYPEIT_TRACE_SCOPE("GameEngine::restoreSnapshot");
+    if (data.substr(0, kSnapshotMagic.size()) != kSnapshotMagic)
+        return false;
+    data.remove_prefix(kSnapshotMagic.size());
+
+    uint32_t version = 0;
+    std::string settingsText;
+    if (!snapshot::getInt(data, version) || version == 0 || version > kSnapshotVersion || !varint::getString(data, settingsText))
+        return false;
+    GameSettings settings;
+    std::istringstream settingsStream(settingsText);
+    ConfigManager::readSettings(settingsStream, settings);
+
+    uint32_t seed = 0, tickCount = 0, nextWordId = 0;
+    int width = 0, height = 0;
+    bool running = false, paused = false, flash = false;
+    float gameTime = 0.0f, flashStart = 0.0f, nextSpawn = 0.0f, teleport = 0.0f, spawnMin = 0.0f, spawnMax = 0.0f;
+    uint32_t genSeed = 0;
+    uint64_t genDraws = 0;
+    if (!snapshot::getInt(data, seed) || !snapshot::getInt(data, tickCount) || !snapshot::getInt(data, nextWordId) || !snapshot::getInt(data, width) ||
+        !snapshot::getInt(data, height) || !snapshot::getBool(data, running) || !snapshot::getBool(data, paused) || !snapshot::getBool(data, flash) ||
+        !snapshot::getFloat(data, gameTime) || !snapshot::getFloat(data, flashStart) || !snapshot::getFloat(data, nextSpawn) ||
+        !snapshot::getFloat(data, teleport) || !snapshot::getFloat(data, spawnMin) || !snapshot::getFloat(data, spawnMax) ||
+        !snapshot::getInt(data, genSeed) || !varint::get(data, genDraws) || tickCount > kMaxSnapshotTicks)
+        return false;
+
+    // Every element takes at least a byte, which bounds a corrupt count
+    uint64_t count = 0;
+    if (!varint::get(data, count) || count == 0 || count > data.size() || count > std::numeric_limits<PlayerId>::max())
+        return false;
+    // Plus the draw that seeds each bot at start()
+    if (genDraws > (static_cast<uint64_t>(tickCount) + 1) * kMaxDrawsPerTick + count)
+        return false;
+    std::vector<PlayerState> players(count);
+    for (auto& player : players)
+    {
+        player.input.reserve(kInputCapacity);
+        if (!varint::getString(data, player.input) || !readStats(data, player.stats))
+            return false;
+    }
+
+    if (!varint::get(data, count) || count > data.size())
+        return false;
+    std::vector<FallingWord> words(count);
+    for (auto& fw : words)
+    {
+        if (!readWord(data, fw))
+            return false;
+    }
+
+    if (!varint::get(data, count) || count > data.size())
+        return false;
+    std::vector<std::unique_ptr<BotTypist>> bots;
+    const uint64_t maxBotDraws = (static_cast<uint64_t>(tickCount) + 1) * BotTypist::kMaxDrawsPerTick;
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        auto bot = std::make_unique<BotTypist>(BotProfile{}, 0);
+        if (!bot->restoreState(data, maxBotDraws) || bot->getPlayer() >= players.size())
+            return false;
+        bots.push_back(std::move(bot));
+    }
+    // Version 1 games resume with their speed counted from here on
+    TypingSpeed speed;
+    if (version >= 2 && !speed.restore(data))
+        return false;
+    if (!data.empty())
+        return false;
+
+    m_settings = settings;
+    m_seed = seed;
+    m_tickCount = tickCount;
+    m_nextWordId = nextWordId;
+    m_visibleWidth.store(width);
+    m_visibleHeight.store(height);
+    m_isRunning = running;
+    m_isPaused = paused;
+    m_flashRedBorder = flash;
+    m_gameTime = gameTime;
+    m_flashStartTime = flashStart;
+    m_nextSpawnTime = nextSpawn;
+    m_currentTeleportInterval = teleport;
+    m_currentSpawnIntervalMin = spawnMin;
+    m_currentSpawnIntervalMax = spawnMax;
+    m_gen.restore(genSeed, genDraws);
+    m_players = std::move(players);
+    m_fallingWords = std::move(words);
+    m_bots = std::move(bots);
+    m_speed = std::move(speed);
+    m_inputTime = {};
+    m_inputTickOffset = 0.0f;
+    return true;
+}
+
 void GameEngine::pause()
 {
     if (m_isRunning && !m_isPaused)
     {
         m_isPaused = true;
-        m_pauseTime = std::chrono::steady_clock::now();
     }
 }
 
@@ -77,8 +354,6 @@ void GameEngine::resume()
 {
     if (m_isRunning && m_isPaused)
     {
-        auto now = std::chrono::steady_clock::now();
-        m_totalPausedTime += std::chrono::duration<float>(now - m_pauseTime).count();
         m_isPaused = false;
     }
 }
@@ -88,44 +363,198 @@ void GameEngine::stop()
     m_isRunning = false;
 }
 
-void GameEngine::handleCharInput(char c)
+bool GameEngine::acceptsInput(PlayerId player) const
 {
-    if (!m_isRunning || m_isPaused)
+    return m_isRunning && !m_isPaused && player < m_players.size();
+}
+
+void GameEngine::handleKeys(std::span<const KeyPress> keys)
+{
+    for (size_t i = 0; i < keys.size();)
+    {
+        if (keys[i].type == KeyPress::Type::Char)
+        {
+            size_t end = i + 1;
+            while (end < keys.size() && keys[end].type == KeyPress::Type::Char)
+            {
+                ++end;
+            }
+            handleCharRun(keys.subspan(i, end - i), kLocalPlayer);
+            i = end;
+            continue;
+        }
+
+        setInputTime(keys[i].arrival, keys[i].secondsIntoTick);
+        if (keys[i].type == KeyPress::Type::Space)
+        {
+            handleSpace();
+        }
+        else
+        {
+            handleBackspace();
+        }
+        ++i;
+    }
+}
+
+void GameEngine::handleCharInput(char c, PlayerId player)
+{
+    const KeyPress key{KeyPress::Type::Char, c, m_inputTime, m_inputTickOffset};
+    handleCharRun(std::span<const KeyPress>(&key, 1), player);
+}
+
+void GameEngine::handleCharRun(std::span<const KeyPress> keys, PlayerId player)
+{
+    if (!acceptsInput(player))
         return;
 
-    // Only accept letters
-    if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'))
+    auto& input = m_players[player].input;
+    const bool local = player == kLocalPlayer;
+    // Only letters are accepted; the board is matched in chunks that fit the
+    // fixed table of targets below
+    while (!keys.empty())
     {
-        m_currentInput += static_cast<char>(std::tolower(c));
+        const size_t chunk = std::min(keys.size(), kInputCapacity);
+        const size_t before = input.size();
+        std::array<const KeyPress*, kInputCapacity> accepted{};
+        size_t count = 0;
+        for (const KeyPress& key : keys.first(chunk))
+        {
+            const char c = key.letter;
+            if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'))
+            {
+                input += static_cast<char>(std::tolower(c));
+                accepted[count++] = &key;
+            }
+        }
+        keys = keys.subspan(chunk);
+        if (count == 0 || !local)
+            continue;
+
+        // count is at most kInputCapacity
+        m_speed.addTyped(static_cast<uint32_t>(count));
+        if (m_inputLog)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                m_inputLog->addChar(m_tickCount, input[before + i]);
+            }
+        }
+        if (!m_keystrokeLog)
+            continue;
+
+        // One pass over the board: the first word spelling out each prefix the
+        // run produced, the same word findTypedWord() would pick key by key
+        std::array<const FallingWord*, kInputCapacity> targets{};
+        const int visibleWidth = m_visibleWidth.load();
+        for (const auto& fw : m_fallingWords)
+        {
+            if (!fw.isVisible(visibleWidth))
+                continue;
+            const std::string& text = fw.word.text;
+            if (text.size() <= before || text.compare(0, before, input, 0, before) != 0)
+                continue;
+            for (size_t i = 0; i < count && before + i < text.size() && text[before + i] == input[before + i]; ++i)
+            {
+                if (!targets[i])
+                    targets[i] = &fw;
+            }
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            setInputTime(accepted[i]->arrival, accepted[i]->secondsIntoTick);
+            recordKeystroke(input[before + i], targets[i] != nullptr, targets[i]);
+        }
     }
 }
 
-void GameEngine::handleBackspace()
+void GameEngine::handleBackspace(PlayerId player)
 {
-    if (!m_isRunning || m_isPaused)
+    if (!acceptsInput(player))
         return;
 
-    if (!m_currentInput.empty())
+    auto& input = m_players[player].input;
+    if (!input.empty())
     {
-        m_currentInput.pop_back();
+        input.pop_back();
+        if (m_inputLog && player == kLocalPlayer)
+        {
+            m_inputLog->addBackspace(m_tickCount);
+        }
+        if (m_keystrokeLog && player == kLocalPlayer)
+        {
+            const FallingWord* target = findTypedWord(input, false);
+            recordKeystroke('\b', input.empty() || target != nullptr, target);
+        }
     }
 }
 
-void GameEngine::handleSpace()
+void GameEngine::handleSpace(PlayerId player)
 {
-    if (!m_isRunning || m_isPaused)
+    if (!acceptsInput(player))
         return;
-    if (m_currentInput.empty())
+    auto& input = m_players[player].input;
+    if (input.empty())
         return;
+    if (m_inputLog && player == kLocalPlayer)
+    {
+        m_inputLog->addSpace(m_tickCount);
+    }
+    if (m_keystrokeLog && player == kLocalPlayer)
+    {
+        // Recorded before the match removes the word
+        const FallingWord* target = findTypedWord(input, true);
+        recordKeystroke(' ', target != nullptr, target ? target : findTypedWord(input, false));
+    }
 
-    bool matched = checkMatch(m_currentInput);
+    bool matched = checkMatch(input, player);
 
     if (!matched)
     {
-        onWrongMatch();
+        onWrongMatch(player);
+    }
+    if (player == kLocalPlayer)
+    {
+        m_speed.addTyped();
+        if (matched)
+        {
+            m_speed.addWord(m_gameTime + m_inputTickOffset, input.size());
+        }
     }
 
-    m_currentInput.clear();
+    input.clear();
+}
+
+const FallingWord* GameEngine::findTypedWord(const std::string& input, bool exact) const
+{
+    if (input.empty())
+        return nullptr;
+
+    const int visibleWidth = m_visibleWidth.load();
+    for (const auto& fw : m_fallingWords)
+    {
+        if (!fw.isVisible(visibleWidth))
+            continue;
+        const bool typed = exact ? fw.word.text == input : fw.word.text.compare(0, input.size(), input) == 0;
+        if (typed)
+            return &fw;
+    }
+    return nullptr;
+}
+
+void GameEngine::recordKeystroke(char key, bool correct, const FallingWord* target)
+{
+    // No allocation here, the log is preallocated and copies the word into a fixed slot
+    const auto at = m_inputTime != std::chrono::steady_clock::time_point{} ? m_inputTime : std::chrono::steady_clock::now();
+    if (target)
+    {
+        m_keystrokeLog->record(key, correct, target->id, target->word.text, at);
+    }
+    else
+    {
+        m_keystrokeLog->record(key, correct, 0, {}, at);
+    }
 }
 
 bool GameEngine::isGameOver() const
@@ -134,7 +563,7 @@ bool GameEngine::isGameOver() const
         return true;
 
     // Endless mode: only check health
-    if (m_stats.health <= 0.0f)
+    if (localStats().health <= 0.0f)
         return true;
 
     return false;
@@ -145,27 +574,28 @@ float GameEngine::getElapsedTime() const
     if (!m_isRunning)
         return 0.0f;
 
-    auto now = std::chrono::steady_clock::now();
-    float elapsed = std::chrono::duration<float>(now - m_startTime).count() - m_totalPausedTime;
-    return elapsed;
+    return m_gameTime;
 }
 
 GameRecord GameEngine::getResult() const
 {
     GameRecord record;
+    const GameStats& stats = localStats();
 
-    auto now = std::chrono::steady_clock::now();
-    float elapsed = std::chrono::duration<float>(now - m_startTime).count() - m_totalPausedTime;
-    float minutes = elapsed / 60.0f;
+    float elapsed = m_gameTime;
 
-    record.wpm = (minutes > 0.0f) ? static_cast<int>(std::round(m_stats.correctWords / minutes)) : 0;
-    record.accuracy = m_stats.getAccuracy();
+    // Five characters to the word, over game time rather than wall time
+    record.wpm = static_cast<int>(std::lround(m_speed.netWpm(elapsed)));
+    record.rawWpm = static_cast<int>(std::lround(m_speed.rawWpm(elapsed)));
+    record.speedCurve = m_speed.curve(elapsed);
+    record.accuracy = stats.getAccuracy();
     record.survivalTime = elapsed;
     record.date = getCurrentDateTime();
-    record.correctWords = m_stats.correctWords;
-    record.missedWords = m_stats.missedWords;
-    record.wrongAttempts = m_stats.wrongAttempts;
-    record.maxCombo = m_stats.maxCombo;
+    record.correctWords = stats.correctWords;
+    record.missedWords = stats.missedWords;
+    record.wrongAttempts = stats.wrongAttempts;
+    record.maxCombo = stats.maxCombo;
+    record.seed = m_seed;
 
     return record;
 }
@@ -177,18 +607,20 @@ bool GameEngine::shouldFlashRedBorder() const
 
 void GameEngine::spawnWord()
 {
+    TYPEIT_TRACE_SCOPE("GameEngine::spawnWord");
     if (m_wordManager.isEmpty())
         return;
 
-    Word word = m_wordManager.getRandomWord();
+    Word word = m_wordManager.getRandomWord(m_gen);
     float y = getRandomYPosition();
 
     m_fallingWords.emplace_back(word, y, m_currentTeleportInterval);
+    m_fallingWords.back().id = m_nextWordId++;
 }
 
 void GameEngine::updateDifficulty(float deltaTime)
 {
-    const auto& cfg = ConfigManager::instance().settings();
+    const auto& cfg = m_settings;
 
     // Teleport interval decreases over time (words teleport faster)
     m_currentTeleportInterval -= cfg.teleportIntervalDecrease * deltaTime;
@@ -203,10 +635,11 @@ void GameEngine::updateDifficulty(float deltaTime)
 
 void GameEngine::updateFallingWords(float deltaTime)
 {
+    TYPEIT_TRACE_SCOPE("GameEngine::updateFallingWords");
     const int visibleWidth = std::max(1, m_visibleWidth.load());
     for (auto it = m_fallingWords.begin(); it != m_fallingWords.end();)
     {
-        it->update(deltaTime, visibleWidth);
+        it->update(deltaTime, visibleWidth, m_settings.teleportStepRatio);
 
         // Check if word has left the screen
         if (!it->isActive)
@@ -221,8 +654,9 @@ void GameEngine::updateFallingWords(float deltaTime)
     }
 }
 
-bool GameEngine::checkMatch(const std::string& input)
+bool GameEngine::checkMatch(const std::string& input, PlayerId player)
 {
+    TYPEIT_TRACE_SCOPE("GameEngine::checkMatch");
     for (size_t i = 0; i < m_fallingWords.size(); ++i)
     {
         auto& fw = m_fallingWords[i];
@@ -231,11 +665,13 @@ bool GameEngine::checkMatch(const std::string& input)
         if (!fw.isVisible(m_visibleWidth.load()))
             continue;
 
-        // Check for match
+        // Check for match. Every player's input goes through here on the one
+        // thread running the engine, so the first to submit a word removes it
+        // and nobody else can score it.
         if (fw.word.text == input)
         {
             removeWord(i);
-            onCorrectMatch();
+            onCorrectMatch(player);
             return true;
         }
     }
@@ -251,34 +687,42 @@ void GameEngine::removeWord(size_t index)
     }
 }
 
-void GameEngine::onCorrectMatch()
+void GameEngine::onCorrectMatch(PlayerId player)
 {
-    const auto& cfg = ConfigManager::instance().settings();
-    m_stats.onCorrect();
+    const auto& cfg = m_settings;
+    GameStats& stats = m_players[player].stats;
+    stats.onCorrect();
 
-    // Gain health
-    m_stats.health = std::min(m_stats.health + cfg.healthGain, cfg.healthCap);
+    // Gain health, only the local player's health keeps the game going
+    if (player == kLocalPlayer)
+    {
+        stats.health = std::min(stats.health + cfg.healthGain, cfg.healthCap);
+    }
 }
 
-void GameEngine::onWrongMatch()
+void GameEngine::onWrongMatch(PlayerId player)
 {
-    m_stats.onWrong();
+    m_players[player].stats.onWrong();
 
     // Trigger red border flash
-    m_flashRedBorder = true;
-    m_flashStartTime = std::chrono::steady_clock::now();
+    if (player == kLocalPlayer)
+    {
+        m_flashRedBorder = true;
+        m_flashStartTime = m_gameTime;
+    }
 }
 
 void GameEngine::onWordMissed()
 {
-    const auto& cfg = ConfigManager::instance().settings();
-    m_stats.onMiss();
+    const auto& cfg = m_settings;
+    GameStats& stats = localStats();
+    stats.onMiss();
 
     // Lose health
-    m_stats.health -= cfg.healthLoss;
-    if (m_stats.health < 0.0f)
+    stats.health -= cfg.healthLoss;
+    if (stats.health < 0.0f)
     {
-        m_stats.health = 0.0f;
+        stats.health = 0.0f;
     }
 }
 
@@ -316,6 +760,11 @@ void GameEngine::updateVisibleArea(int width, int height)
 {
     width = std::max(10, width);
     height = std::max(1, height);
+    // The visible width decides which words can be typed, so a replay needs every change
+    if (m_inputLog && m_isRunning && (width != m_visibleWidth.load() || height != m_visibleHeight.load()))
+    {
+        m_inputLog->addResize(m_tickCount, width, height);
+    }
     m_visibleWidth.store(width);
     m_visibleHeight.store(height);
 }
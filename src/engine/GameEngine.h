@@ -3,59 +3,160 @@
 #include "../models/FallingWord.h"
 #include "../models/GameStats.h"
 #include "../models/GameRecord.h"
+#include "../models/TypingSpeed.h"
 #include "../managers/WordManager.h"
 #include "../utils/GameConfig.h"
+#include "../utils/GameRng.h"
 #include <atomic>
+#include <cstdint>
+#include <memory>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <chrono>
 #include <random>
+#include <span>
+
+class BotTypist;
+struct BotProfile;
+class InputLog;
+class KeystrokeLog;
+
+// Everyone typing on the board. Player 0 is the local player, whose health
+// decides the game; others (bot opponents, remote racers) only compete for words.
+// All players' input is applied on the one thread driving the engine (the UI,
+// a GameSimulation or the race server), so matches are checked one after the
+// other and the first player to submit a word is the only one to score it.
+using PlayerId = uint16_t;
+constexpr PlayerId kLocalPlayer = 0;
+
+struct PlayerState
+{
+    std::string input;
+    GameStats stats;
+};
+
+// A key of the local player and when it was pressed, see GameEngine::handleKeys()
+struct KeyPress
+{
+    enum class Type : uint8_t
+    {
+        Char,
+        Backspace,
+        Space,
+    };
+
+    Type type = Type::Char;
+    char letter = 0;
+    std::chrono::steady_clock::time_point arrival;
+    float secondsIntoTick = 0.0f; // How far into the coming update() it arrived
+};
 
 class GameEngine
 {
 public:
-    GameEngine(WordManager& wordManager);
+    GameEngine(const WordManager& wordManager);
+    ~GameEngine();
+
+    // Step of the interactive game; input logs count time in these ticks
+    static constexpr float kTickSeconds = 1.0f / 60.0f;
+    static constexpr size_t kInputCapacity = 64;
 
     // Game control (endless mode, no time limit)
+    // Uses the global config and a random seed
     void start(int screenWidth);
+    // Same settings and seed give the same game for the same update/input sequence
+    void start(int screenWidth, const GameSettings& settings, uint32_t seed);
+    // All game time comes from deltaTime, the engine never reads the clock
     void update(float deltaTime);
+    // Records the local player's accepted input and board resizes into log,
+    // which every start() resets. nullptr stops recording.
+    void setInputLog(InputLog* log) { m_inputLog = log; }
+    // Times the local player's keystrokes into log, restarted by every start()
+    void setKeystrokeLog(KeystrokeLog* log) { m_keystrokeLog = log; }
+    // When the keys handled next were pressed: arrival for the keystroke log,
+    // and how far into the coming tick for the speed counts. Until it is set
+    // (start() clears it) keys count at the time they are handled.
+    void setInputTime(std::chrono::steady_clock::time_point arrival, float secondsIntoTick = 0.0f)
+    {
+        m_inputTime = arrival;
+        m_inputTickOffset = secondsIntoTick;
+    }
+
+    // Versioned binary copy of the whole game (board, timers, difficulty,
+    // players, bots and every random generator) for suspending to disk.
+    // Restoring continues exactly where the snapshot was taken; a malformed
+    // or foreign snapshot returns false and leaves the engine unchanged.
+    static constexpr uint32_t kSnapshotVersion = 2;
+    // Generators are restored by replaying their draws, so a snapshot is
+    // rejected when it claims more than this: games of up to four hours, and
+    // a few times the draws per tick real games make (one per spawn at most)
+    static constexpr uint32_t kMaxSnapshotTicks = 4 * 60 * 60 * 60;
+    static constexpr uint64_t kMaxDrawsPerTick = 8;
+    std::string saveSnapshot() const;
+    bool restoreSnapshot(std::string_view data);
     void pause();
     void resume();
     void stop();
 
     // Input handling
-    void handleCharInput(char c);
-    void handleBackspace();
-    void handleSpace();
+    // The local player's keys since the last call, applied in order. A run of
+    // letters is appended in one go and matched against the board in one pass.
+    void handleKeys(std::span<const KeyPress> keys);
+    void handleCharInput(char c, PlayerId player = kLocalPlayer);
+    void handleBackspace(PlayerId player = kLocalPlayer);
+    void handleSpace(PlayerId player = kLocalPlayer);
+
+    // Players beyond the local one, valid until the next start()
+    PlayerId addPlayer();
+    // Fresh input and stats for a new player taking over a left player's slot
+    void resetPlayer(PlayerId player);
+    // Bot on the same board, typing during update(); GameSettings::botOpponent adds one at start()
+    PlayerId addBotOpponent(const BotProfile& profile);
+    size_t getPlayerCount() const { return m_players.size(); }
 
     // State queries
     bool isRunning() const { return m_isRunning; }
     bool isGameOver() const;
     float getElapsedTime() const;
-    float getHealthPercentage() const { return m_stats.health; }
+    float getHealthPercentage() const { return localStats().health; }
     float getCurrentTeleportInterval() const { return m_currentTeleportInterval; }
+    uint32_t getSeed() const { return m_seed; }
+    // update() calls that advanced the game since start()
+    uint32_t getTickCount() const { return m_tickCount; }
+    // Ids below this have been spawned; live words are in ascending id order
+    uint32_t getSpawnedWordCount() const { return m_nextWordId; }
+    const GameSettings& getSettings() const { return m_settings; }
     int getVisibleWidth() const { return m_visibleWidth.load(); }
     int getVisibleHeight() const { return m_visibleHeight.load(); }
 
     // Data access
     const std::vector<FallingWord>& getFallingWords() const { return m_fallingWords; }
-    const std::string& getCurrentInput() const { return m_currentInput; }
-    const GameStats& getStats() const { return m_stats; }
+    const std::string& getCurrentInput(PlayerId player = kLocalPlayer) const { return m_players[player].input; }
+    const GameStats& getStats(PlayerId player = kLocalPlayer) const { return m_players[player].stats; }
+    // The local player's, counted as keys are handled
+    const TypingSpeed& getSpeed() const { return m_speed; }
     GameRecord getResult() const;
     bool shouldFlashRedBorder() const;
     void updateVisibleArea(int width, int height);
 
 private:
-    WordManager& m_wordManager;
+    const WordManager& m_wordManager;
     std::atomic<int> m_visibleWidth;
     std::atomic<int> m_visibleHeight;
+    GameSettings m_settings; // Copied at start(), so games can run side by side
 
     // Game state
     bool m_isRunning = false;
     bool m_isPaused = false;
-    std::chrono::steady_clock::time_point m_startTime;
-    std::chrono::steady_clock::time_point m_pauseTime;
-    float m_totalPausedTime = 0.0f;
+    float m_gameTime = 0.0f; // Sum of unpaused update() steps
+    uint32_t m_tickCount = 0;
+    uint32_t m_seed = 0;
+    InputLog* m_inputLog = nullptr;
+    KeystrokeLog* m_keystrokeLog = nullptr;
+    std::chrono::steady_clock::time_point m_inputTime;
+    float m_inputTickOffset = 0.0f;
+    TypingSpeed m_speed;
 
     // Difficulty scaling (initialized in start())
     float m_currentTeleportInterval = 1.5f;
@@ -64,28 +165,33 @@ private:
 
     // Word management
     std::vector<FallingWord> m_fallingWords;
+    uint32_t m_nextWordId = 0;
     float m_nextSpawnTime = 0.0f;
-    std::random_device m_rd;
-    std::mt19937 m_gen;
-
-    // Input
-    std::string m_currentInput;
+    GameRng m_gen;
 
-    // Stats
-    GameStats m_stats;
+    // Input and stats, indexed by PlayerId
+    std::vector<PlayerState> m_players;
+    std::vector<std::unique_ptr<BotTypist>> m_bots;
 
     // Effects
     bool m_flashRedBorder = false;
-    std::chrono::steady_clock::time_point m_flashStartTime;
+    float m_flashStartTime = 0.0f;
 
     // Private methods
     void spawnWord();
     void updateFallingWords(float deltaTime);
     void updateDifficulty(float deltaTime);
-    bool checkMatch(const std::string& input);
+    bool checkMatch(const std::string& input, PlayerId player);
     void removeWord(size_t index);
-    void onCorrectMatch();
-    void onWrongMatch();
+    void onCorrectMatch(PlayerId player);
+    void onWrongMatch(PlayerId player);
+    bool acceptsInput(PlayerId player) const;
+    void handleCharRun(std::span<const KeyPress> keys, PlayerId player);
+    // First visible word the input spells out (exact) or starts (prefix)
+    const FallingWord* findTypedWord(const std::string& input, bool exact) const;
+    void recordKeystroke(char key, bool correct, const FallingWord* target);
+    GameStats& localStats() { return m_players[kLocalPlayer].stats; }
+    const GameStats& localStats() const { return m_players[kLocalPlayer].stats; }
     void onWordMissed();
     float getRandomSpawnInterval();
     float getRandomYPosition();
@@ -0,0 +1,227 @@
+#include "GameSimulation.h"
+#include "GhostRunner.h"
+#include "../utils/Trace.h"
+#include <algorithm>
+
+namespace
+{
+uint64_t packArea(int width, int height)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(width)) << 32) | static_cast<uint32_t>(height);
+}
+} // namespace
+
+GameSimulation::GameSimulation(GameEngine& engine, GhostRunner* ghost, JitterStats* pacing)
+    : m_engine(engine)
+    , m_ghost(ghost)
+    , m_pacing(pacing)
+    , m_visibleArea(packArea(engine.getVisibleWidth(), engine.getVisibleHeight()))
+{
+    publish();
+}
+
+GameSimulation::~GameSimulation()
+{
+    stop();
+}
+
+void GameSimulation::start(std::function<void()> onPublish, std::function<void()> onFinished)
+{
+    if (m_running.exchange(true))
+        return;
+    if (m_thread.joinable())
+    {
+        // The previous run ended on its own
+        m_thread.join();
+    }
+
+    m_thread = std::thread([this, onPublish = std::move(onPublish), onFinished = std::move(onFinished)] { run(onPublish, onFinished); });
+}
+
+void GameSimulation::stop()
+{
+    m_running = false;
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+bool GameSimulation::pushInput(KeyPress::Type type, char letter)
+{
+    return m_inputs.push(KeyPress{type, letter, Clock::now()});
+}
+
+void GameSimulation::setVisibleArea(int width, int height)
+{
+    m_visibleArea.store(packArea(width, height), std::memory_order_relaxed);
+}
+
+void GameSimulation::run(const std::function<void()>& onPublish, const std::function<void()>& onFinished)
+{
+    trace::setThreadName("simulation");
+    const auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(GameEngine::kTickSeconds));
+    // Wall-clock moment the game has been simulated up to
+    auto simulated = Clock::now();
+    auto lastWake = simulated;
+    auto deadline = simulated + period;
+
+    while (m_running.load(std::memory_order_relaxed))
+    {
+        std::this_thread::sleep_until(deadline);
+        const auto now = Clock::now();
+        if (m_pacing)
+        {
+            m_pacing->record(now - lastWake, period);
+        }
+        lastWake = now;
+        deadline += period;
+        if (deadline <= now)
+        {
+            // Missed a whole period; start again from here rather than
+            // catching up with a burst of wake-ups
+            deadline = now + period;
+        }
+
+        TYPEIT_TRACE_SCOPE("GameSimulation::wake");
+        bool changed = false;
+        for (int steps = 0; simulated + period <= now; ++steps)
+        {
+            if (steps == kMaxStepsPerWake || gameEnded())
+            {
+                simulated = now;
+                break;
+            }
+
+            // Keys pressed during this step's slice of time go in before it
+            applyInputs(simulated, simulated + period);
+            applyVisibleArea();
+            m_engine.update(GameEngine::kTickSeconds);
+            if (m_ghost)
+            {
+                m_ghost->step();
+            }
+            simulated += period;
+            changed = true;
+        }
+        if (!gameEnded())
+        {
+            changed |= applyInputs(simulated, simulated);
+        }
+
+        if (changed)
+        {
+            publish();
+            if (onPublish)
+            {
+                onPublish();
+            }
+        }
+
+        if (gameEnded())
+        {
+            m_running = false;
+            if (onFinished)
+            {
+                onFinished();
+            }
+            return;
+        }
+    }
+}
+
+bool GameSimulation::applyInputs(Clock::time_point stepStart, Clock::time_point until)
+{
+    if (m_engine.isGameOver())
+        return false;
+
+    // A burst of keys (fast typing, a paste) costs one engine call
+    size_t count = 0;
+    for (const KeyPress* key = m_inputs.front(); key && key->arrival <= until && count < m_batch.size(); key = m_inputs.front())
+    {
+        KeyPress& batched = m_batch[count++];
+        batched = *key;
+        batched.secondsIntoTick = std::clamp(std::chrono::duration<float>(key->arrival - stepStart).count(), 0.0f, GameEngine::kTickSeconds);
+        m_inputs.pop();
+    }
+    if (count == 0)
+        return false;
+
+    TYPEIT_TRACE_SCOPE("GameSimulation::applyInputs");
+    m_engine.handleKeys(std::span<const KeyPress>(m_batch.data(), count));
+    return true;
+}
+
+void GameSimulation::applyVisibleArea()
+{
+    const uint64_t area = m_visibleArea.load(std::memory_order_relaxed);
+    const int width = static_cast<int>(area >> 32);
+    const int height = static_cast<int>(area & 0xffffffffu);
+    // A no-op unless the size changed
+    m_engine.updateVisibleArea(width, height);
+}
+
+bool GameSimulation::gameEnded() const
+{
+    return !m_engine.isRunning() || m_engine.isGameOver();
+}
+
+void GameSimulation::publish()
+{
+    TYPEIT_TRACE_SCOPE("GameSimulation::publish");
+    // Assigned member by member so the slot's buffers are reused
+    GameView& view = m_views.back();
+    const auto& words = m_engine.getFallingWords();
+    view.words.assign(words.begin(), words.end());
+    view.stats = m_engine.getStats();
+    view.input = m_engine.getCurrentInput();
+    view.elapsedTime = m_engine.getElapsedTime();
+    view.health = m_engine.getHealthPercentage();
+    view.flashRedBorder = m_engine.shouldFlashRedBorder();
+
+    view.rivals.resize(m_engine.getPlayerCount() - 1);
+    for (size_t player = 1; player < m_engine.getPlayerCount(); ++player)
+    {
+        const auto id = static_cast<PlayerId>(player);
+        view.rivals[player - 1].input = m_engine.getCurrentInput(id);
+        view.rivals[player - 1].score = m_engine.getStats(id).correctWords;
+    }
+
+    const bool ghostActive = m_ghost && m_ghost->isActive();
+    view.ghostCleared.assign(words.size(), 0);
+    view.ghostWords.clear();
+    if (ghostActive)
+    {
+        for (size_t i = 0; i < words.size(); ++i)
+        {
+            view.ghostCleared[i] = m_ghost->hasCleared(words[i].id);
+        }
+
+        // Both boards come from the same seed, so the ghost's words sit where
+        // the player's would; only those the player has already cleared count
+        const uint32_t spawned = m_engine.getSpawnedWordCount();
+        for (const auto& fw : m_ghost->getEngine().getFallingWords())
+        {
+            if (fw.id >= spawned)
+                continue;
+            const auto it =
+                std::lower_bound(words.begin(), words.end(), fw.id, [](const FallingWord& word, uint32_t id) { return word.id < id; });
+            if (it != words.end() && it->id == fw.id)
+                continue;
+            view.ghostWords.push_back(fw);
+        }
+    }
+
+    view.ghostShown = m_ghost && (m_ghost->isActive() || m_ghost->isFinished());
+    view.ghostFinished = m_ghost && m_ghost->isFinished();
+    view.ghostFinishTime = m_ghost ? m_ghost->getFinishTime() : 0.0f;
+    view.ghostInput = view.ghostShown ? m_ghost->getEngine().getCurrentInput() : std::string_view();
+    view.ghostScore = view.ghostShown ? m_ghost->getEngine().getStats().correctWords : 0;
+    view.traceFlow = 0;
+    if (trace::enabled())
+    {
+        view.traceFlow = trace::newFlowId();
+        trace::flowBegin("view", view.traceFlow);
+    }
+    m_views.publish();
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "GameEngine.h"
+#include "../utils/JitterStats.h"
+#include "../utils/SpscQueue.h"
+#include "../utils/TripleBuffer.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+class GhostRunner;
+
+// What a frame shows of the game, copied out of the engine after each step
+struct GameView
+{
+    struct Rival
+    {
+        std::string input;
+        int score = 0;
+    };
+
+    std::vector<FallingWord> words;
+    std::vector<uint8_t> ghostCleared; // Per word: the ghost has already typed it
+    std::vector<FallingWord> ghostWords; // Words of the ghost's board the player has cleared
+    GameStats stats;
+    std::string input;
+    float elapsedTime = 0.0f;
+    float health = 0.0f;
+    bool flashRedBorder = false;
+    std::vector<Rival> rivals;
+
+    bool ghostShown = false; // Replaying, or finished with its result on show
+    bool ghostFinished = false;
+    float ghostFinishTime = 0.0f;
+    std::string ghostInput;
+    int ghostScore = 0;
+
+    // Trace flow from the step that published this view to the frame that
+    // draws it; 0 while tracing is off
+    uint64_t traceFlow = 0;
+};
+
+// Runs an engine (and the ghost racing it) on a thread of its own, in fixed
+// GameEngine::kTickSeconds steps scheduled on absolute deadlines, so a slow
+// terminal can't delay the game. Keystrokes come in through a wait-free
+// queue stamped with their arrival time. Those due before a step reach the
+// engine together in one handleKeys() call; each step ends by publishing a
+// GameView.
+//
+// While the thread runs it owns the engine and the ghost; the UI reads only
+// view(). stop() hands both back.
+class GameSimulation
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t kInputCapacity = 256;
+    // After a stall the game skips ahead instead of running a burst of steps
+    static constexpr int kMaxStepsPerWake = 8;
+
+    // Publishes a first view straight away. Wake-up jitter goes to pacing.
+    GameSimulation(GameEngine& engine, GhostRunner* ghost, JitterStats* pacing = nullptr);
+    ~GameSimulation();
+    GameSimulation(const GameSimulation&) = delete;
+    GameSimulation& operator=(const GameSimulation&) = delete;
+
+    // Both callbacks run on the simulation thread: onPublish after every new
+    // view, onFinished once the game is over or stopped, after the last step
+    void start(std::function<void()> onPublish, std::function<void()> onFinished);
+    void stop();
+    bool isRunning() const { return m_running.load(std::memory_order_relaxed); }
+
+    // UI thread. False when the queue is full and the key was dropped.
+    bool pushInput(KeyPress::Type type, char letter = 0);
+    // UI thread; applied before the next step
+    void setVisibleArea(int width, int height);
+    // UI thread; the newest view, stable until the next call
+    const GameView& view() { return m_views.read(); }
+
+private:
+    GameEngine& m_engine;
+    GhostRunner* m_ghost;
+    JitterStats* m_pacing;
+
+    SpscQueue<KeyPress, kInputCapacity> m_inputs;
+    std::array<KeyPress, kInputCapacity> m_batch; // Simulation thread only
+    TripleBuffer<GameView> m_views;
+    // Width in the high half, height in the low one, so both change together
+    std::atomic<uint64_t> m_visibleArea;
+
+    std::atomic<bool> m_running = false;
+    std::thread m_thread;
+
+    void run(const std::function<void()>& onPublish, const std::function<void()>& onFinished);
+    // Applies the inputs that arrived before until, timed against the start
+    // of the step they go into; true if there were any
+    bool applyInputs(Clock::time_point stepStart, Clock::time_point until);
+    void applyVisibleArea();
+    bool gameEnded() const;
+    void publish();
+};
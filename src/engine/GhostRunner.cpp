@@ -0,0 +1,98 @@
+#include "GhostRunner.h"
+#include "../utils/SnapshotIO.h"
+#include "../utils/Trace.h"
+#include <algorithm>
+#include <utility>
+
+GhostRunner::GhostRunner(const WordManager& wordManager) : m_engine(wordManager) {}
+
+void GhostRunner::start(InputLog log, const GameSettings& settings)
+{
+    m_log = std::move(log);
+    m_nextEvent = 0;
+    m_finished = false;
+    m_finishTime = 0.0f;
+    // The log's first event sets the board size the game was played on
+    m_engine.start(100, settings, m_log.seed);
+    m_active = true;
+}
+
+void GhostRunner::step()
+{
+    if (!m_active)
+        return;
+
+    TYPEIT_TRACE_SCOPE("GhostRunner::step");
+    const uint32_t tick = m_engine.getTickCount();
+    while (m_nextEvent < m_log.events.size() && m_log.events[m_nextEvent].tick <= tick)
+    {
+        apply(m_log.events[m_nextEvent++]);
+    }
+
+    m_engine.update(GameEngine::kTickSeconds);
+
+    // The recording ends with the game; the tick limit only guards against a drifted replay
+    if (m_engine.isGameOver() || m_engine.getTickCount() >= m_log.totalTicks)
+    {
+        m_active = false;
+        m_finished = true;
+        m_finishTime = m_engine.getElapsedTime();
+    }
+}
+
+void GhostRunner::stop()
+{
+    m_active = false;
+}
+
+void GhostRunner::saveState(std::string& out) const
+{
+    snapshot::putBool(out, m_active);
+    snapshot::putBool(out, m_finished);
+    snapshot::putFloat(out, m_finishTime);
+    varint::put(out, m_nextEvent);
+    varint::putString(out, m_log.encode());
+    varint::putString(out, m_engine.saveSnapshot());
+}
+
+bool GhostRunner::restoreState(std::string_view& in)
+{
+    m_active = false;
+    std::string log, engine;
+    if (!snapshot::getBool(in, m_active) || !snapshot::getBool(in, m_finished) || !snapshot::getFloat(in, m_finishTime) ||
+        !snapshot::getInt(in, m_nextEvent) || !varint::getString(in, log) || !varint::getString(in, engine) || !m_log.decode(log) ||
+        m_nextEvent > m_log.events.size() || !m_engine.restoreSnapshot(engine))
+    {
+        m_active = false;
+        return false;
+    }
+    return true;
+}
+
+bool GhostRunner::hasCleared(uint32_t wordId) const
+{
+    if (wordId >= m_engine.getSpawnedWordCount())
+        return false;
+    const auto& words = m_engine.getFallingWords();
+    const auto it = std::lower_bound(words.begin(), words.end(), wordId, [](const FallingWord& word, uint32_t id) { return word.id < id; });
+    return it == words.end() || it->id != wordId;
+}
+
+void GhostRunner::apply(const InputEvent& event)
+{
+    switch (event.type)
+    {
+    case InputEvent::Type::Char:
+        m_engine.handleCharInput(event.letter);
+        break;
+    case InputEvent::Type::Backspace:
+        m_engine.handleBackspace();
+        break;
+    case InputEvent::Type::Space:
+        m_engine.handleSpace();
+        break;
+    case InputEvent::Type::Resize:
+        m_engine.updateVisibleArea(event.width, event.height);
+        break;
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "GameEngine.h"
+#include "../models/InputLog.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Replays a recorded game on its own engine, one fixed tick at a time, so it
+// can run in lockstep with a live game started from the same seed. The ghost
+// costs one extra engine update per tick and never touches the clock.
+class GhostRunner
+{
+public:
+    explicit GhostRunner(const WordManager& wordManager);
+
+    // Starts the replay; the settings must be the ones the log was recorded
+    // with (compare InputLog::settingsFingerprint), or the ghost drifts
+    void start(InputLog log, const GameSettings& settings);
+    // Applies the inputs due at the current tick, then advances one tick
+    void step();
+    void stop();
+
+    // Replay position, log and engine, so a suspended ghost race resumes in lockstep
+    void saveState(std::string& out) const;
+    // Returns false for a malformed state, leaving the ghost stopped
+    bool restoreState(std::string_view& in);
+
+    // Replaying and still alive
+    bool isActive() const { return m_active; }
+    // The recorded game ended; game time at which it did
+    bool isFinished() const { return m_finished; }
+    float getFinishTime() const { return m_finishTime; }
+
+    const GameEngine& getEngine() const { return m_engine; }
+    const InputLog& getLog() const { return m_log; }
+    // Whether the ghost's board no longer holds this word: typed, or escaped
+    bool hasCleared(uint32_t wordId) const;
+
+private:
+    GameEngine m_engine;
+    InputLog m_log;
+    size_t m_nextEvent = 0;
+    bool m_active = false;
+    bool m_finished = false;
+    float m_finishTime = 0.0f;
+
+    void apply(const InputEvent& event);
+};
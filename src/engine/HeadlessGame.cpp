@@ -0,0 +1,31 @@
+#include "HeadlessGame.h"
+#include "GameEngine.h"
+#include <random>
+
+HeadlessGameResult runHeadlessGame(const WordManager& words, const GameSettings& settings, const BotProfile& bot, uint32_t seed,
+                                   const HeadlessGameOptions& options)
+{
+    // Independent streams for the game and the bot
+    std::seed_seq seeds{seed, 0x9e3779b9u};
+    uint32_t streams[2];
+    seeds.generate(streams, streams + 2);
+
+    GameEngine engine(words);
+    engine.start(options.screenWidth, settings, streams[0]);
+    BotTypist typist(bot, streams[1]);
+
+    HeadlessGameResult result;
+    while (!engine.isGameOver())
+    {
+        if (engine.getElapsedTime() >= options.maxSeconds)
+        {
+            result.timedOut = true;
+            break;
+        }
+        typist.update(engine, options.tickSeconds);
+        engine.update(options.tickSeconds);
+    }
+
+    result.record = engine.getResult();
+    return result;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "BotTypist.h"
+#include "../managers/WordManager.h"
+#include "../models/GameRecord.h"
+#include "../utils/GameConfig.h"
+#include <cstdint>
+
+struct HeadlessGameOptions
+{
+    float tickSeconds = 1.0f / 60.0f;
+    float maxSeconds = 900.0f; // Games still alive at this point count as timed out
+    int screenWidth = 100;
+};
+
+struct HeadlessGameResult
+{
+    GameRecord record;
+    bool timedOut = false;
+};
+
+// Plays one full game with a bot at a fixed timestep, no terminal and no clock.
+// Deterministic for a given seed; safe to run on many threads at once.
+HeadlessGameResult runHeadlessGame(const WordManager& words, const GameSettings& settings, const BotProfile& bot, uint32_t seed,
+                                   const HeadlessGameOptions& options = {});
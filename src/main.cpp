@@ -1,11 +1,25 @@
 #include "Application.h"
+#include "utils/AppOptions.h"
 #include <iostream>
+#include <string>
 
-int main()
+int main(int argc, char* argv[])
 {
+    AppOptions options;
+    std::string error;
+    if (!AppOptions::parse(argc, argv, options, error))
+    {
+        std::cerr << error << "\n" << AppOptions::usage();
+        return 1;
+    }
+    if (options.showHelp)
+    {
+        std::cout << AppOptions::usage();
+        return 0;
+    }
 
-        Application app;
-        app.run();
+    Application app(options);
+    app.run();
 
     return 0;
 }
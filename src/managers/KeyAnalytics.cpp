@@ -0,0 +1,194 @@
+#include "KeyAnalytics.h"
+#include "../utils/Varint.h"
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+namespace
+{
+constexpr std::string_view kMagic = "TKA";
+
+int letterIndex(char c)
+{
+    return c >= 'a' && c <= 'z' ? c - 'a' : -1;
+}
+} // namespace
+
+void KeyAnalytics::clear()
+{
+    m_confusion.fill(0);
+    m_bigramCount.fill(0);
+    m_bigramTotalMs.fill(0);
+    m_games = 0;
+}
+
+void KeyAnalytics::addGame(const KeystrokeLog& log)
+{
+    // The input is rebuilt alongside, so each letter can be lined up with the
+    // letter of the target word at the same position
+    std::string input;
+    bool onTrack = true; // Input so far is a prefix of a word on screen
+    const Keystroke* previousLetter = nullptr;
+
+    const std::vector<Keystroke> strokes = log.keystrokes();
+    for (const auto& keystroke : strokes)
+    {
+        if (keystroke.key == '\b')
+        {
+            if (!input.empty())
+                input.pop_back();
+            onTrack = keystroke.correct;
+            previousLetter = nullptr;
+            continue;
+        }
+        if (keystroke.key == ' ')
+        {
+            input.clear();
+            onTrack = true;
+            previousLetter = nullptr;
+            continue;
+        }
+
+        input.push_back(keystroke.key);
+        if (keystroke.correct)
+        {
+            addPress(keystroke.key, keystroke.key);
+            if (previousLetter && keystroke.timeMs - previousLetter->timeMs <= kMaxBigramGapMs)
+            {
+                addBigram(previousLetter->key, keystroke.key, keystroke.timeMs - previousLetter->timeMs);
+            }
+            previousLetter = &keystroke;
+        }
+        else
+        {
+            // Only the first slip counts; once off track the later letters
+            // no longer line up with the word
+            const std::string_view word = log.wordText(keystroke.wordId);
+            if (onTrack && input.size() > 1 && input.size() <= word.size())
+            {
+                addPress(word[input.size() - 1], keystroke.key);
+            }
+            previousLetter = nullptr;
+        }
+        onTrack = keystroke.correct;
+    }
+    ++m_games;
+}
+
+void KeyAnalytics::addPress(char expected, char typed)
+{
+    const int row = letterIndex(expected);
+    const int column = letterIndex(typed);
+    if (row >= 0 && column >= 0)
+    {
+        ++m_confusion[cell(row, column)];
+    }
+}
+
+void KeyAnalytics::addBigram(char first, char second, uint32_t elapsedMs)
+{
+    const int row = letterIndex(first);
+    const int column = letterIndex(second);
+    if (row >= 0 && column >= 0)
+    {
+        ++m_bigramCount[cell(row, column)];
+        m_bigramTotalMs[cell(row, column)] += elapsedMs;
+    }
+}
+
+uint32_t KeyAnalytics::pressesOf(int expected) const
+{
+    uint32_t total = 0;
+    for (int typed = 0; typed < kLetters; ++typed)
+    {
+        total += m_confusion[cell(expected, typed)];
+    }
+    return total;
+}
+
+double KeyAnalytics::bigramMeanMs(int first, int second) const
+{
+    const uint32_t count = m_bigramCount[cell(first, second)];
+    return count > 0 ? static_cast<double>(m_bigramTotalMs[cell(first, second)]) / count : 0.0;
+}
+
+std::string KeyAnalytics::encode() const
+{
+    // Mostly zeros and small counts, so varints keep the three tables to a
+    // couple of kilobytes
+    std::string out(kMagic);
+    varint::put(out, kVersion);
+    varint::put(out, m_games);
+    for (uint32_t count : m_confusion)
+    {
+        varint::put(out, count);
+    }
+    for (size_t i = 0; i < m_bigramCount.size(); ++i)
+    {
+        varint::put(out, m_bigramCount[i]);
+        varint::put(out, m_bigramTotalMs[i]);
+    }
+    return out;
+}
+
+bool KeyAnalytics::decode(std::string_view data)
+{
+    clear();
+    if (data.substr(0, kMagic.size()) != kMagic)
+        return false;
+    data.remove_prefix(kMagic.size());
+
+    KeyAnalytics decoded;
+    uint64_t version = 0, games = 0;
+    if (!varint::get(data, version) || version != kVersion || !varint::get(data, games))
+        return false;
+    decoded.m_games = static_cast<uint32_t>(games);
+    for (auto& count : decoded.m_confusion)
+    {
+        uint64_t value = 0;
+        if (!varint::get(data, value))
+            return false;
+        count = static_cast<uint32_t>(value);
+    }
+    for (size_t i = 0; i < decoded.m_bigramCount.size(); ++i)
+    {
+        uint64_t count = 0;
+        if (!varint::get(data, count) || !varint::get(data, decoded.m_bigramTotalMs[i]))
+            return false;
+        decoded.m_bigramCount[i] = static_cast<uint32_t>(count);
+    }
+    if (!data.empty())
+        return false;
+
+    *this = decoded;
+    return true;
+}
+
+bool KeyAnalytics::loadFromFile(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+    {
+        clear();
+        return false;
+    }
+    const std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return decode(data);
+}
+
+bool KeyAnalytics::saveToFile(const std::string& path) const
+{
+    std::error_code ec;
+    const std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty())
+    {
+        std::filesystem::create_directories(parent, ec);
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+        return false;
+    const std::string data = encode();
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "../models/KeystrokeLog.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Per-letter typing habits summed over every game: a confusion matrix of which
+// letter was typed where another was expected, and the time taken for each
+// pair of letters typed in a row. Both are fixed 26x26 counter arrays, so a
+// keystroke is one increment and the heatmaps are drawn straight from them.
+class KeyAnalytics
+{
+public:
+    static constexpr int kLetters = 26;
+    // Longer gaps between two correct letters are pauses, not typing rhythm
+    static constexpr uint32_t kMaxBigramGapMs = 2000;
+    static constexpr uint32_t kVersion = 1;
+
+    void clear();
+    // Replays one game's keystrokes into the counters
+    void addGame(const KeystrokeLog& log);
+    // expected == typed counts a correct press of that letter
+    void addPress(char expected, char typed);
+    void addBigram(char first, char second, uint32_t elapsedMs);
+
+    uint32_t games() const { return m_games; }
+    // Indexes are letters counted from 'a'
+    uint32_t presses(int expected, int typed) const { return m_confusion[cell(expected, typed)]; }
+    // Every press where expected was the right letter, correct or not
+    uint32_t pressesOf(int expected) const;
+    uint32_t bigramCount(int first, int second) const { return m_bigramCount[cell(first, second)]; }
+    // Mean milliseconds from first to second, 0 when never typed
+    double bigramMeanMs(int first, int second) const;
+
+    std::string encode() const;
+    bool decode(std::string_view data);
+    bool loadFromFile(const std::string& path);
+    bool saveToFile(const std::string& path) const;
+
+private:
+    static size_t cell(int row, int column) { return static_cast<size_t>(row) * kLetters + static_cast<size_t>(column); }
+
+    std::array<uint32_t, kLetters * kLetters> m_confusion{}; // [expected][typed]
+    std::array<uint32_t, kLetters * kLetters> m_bigramCount{};
+    std::array<uint64_t, kLetters * kLetters> m_bigramTotalMs{};
+    uint32_t m_games = 0;
+};
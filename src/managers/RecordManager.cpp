@@ -6,135 +6,446 @@
 #include <sstream>
 #include <filesystem>
 
-RecordManager::RecordManager(const std::string& csvPath)
-    : m_csvPath(csvPath) {
+RecordManager::RecordManager(const std::string& recordsDir, const std::string& legacyCsvPath)
+    : m_recordsDir(recordsDir), m_legacyCsvPath(legacyCsvPath) {
 }
 
-void RecordManager::ensureFileExists() {
-    // 确保目录存在
-    std::filesystem::path filePath(m_csvPath);
-    if (!filePath.parent_path().empty()) {
-        std::filesystem::create_directories(filePath.parent_path());
+std::string RecordManager::monthOf(const std::string& date) {
+    std::string month = RecordRollups::periodKey(RollupPeriod::Month, date);
+    // 日期格式异常的记录统一放进一个分片，不丢数据
+    return month.empty() ? RecordRollups::kUndatedMonth : month;
+}
+
+std::string RecordManager::shardPath(const std::string& month) const {
+    return (std::filesystem::path(m_recordsDir) / (month + ".csv")).string();
+}
+
+std::string RecordManager::inputLogPath(const GameRecord& record) const {
+    return gameFilePath(record, kInputLogDirName, ".til");
+}
+
+std::string RecordManager::keystrokeLogPath(const GameRecord& record) const {
+    return gameFilePath(record, kKeystrokeDirName, ".tks");
+}
+
+std::string RecordManager::gameFilePath(const GameRecord& record, const char* dirName, const char* extension) const {
+    // "2025-03-04 12:34" + seed -> <dir>/20250304-1234-00c0ffee<ext>
+    std::string stamp;
+    for (char c : record.date) {
+        if (c >= '0' && c <= '9') {
+            stamp += c;
+        } else if (c == ' ') {
+            stamp += '-';
+        }
     }
-    
+    char seed[16];
+    std::snprintf(seed, sizeof(seed), "%08x", record.seed);
+    return (std::filesystem::path(m_recordsDir) / dirName / (stamp + "-" + seed + extension)).string();
+}
+
+std::string RecordManager::rollupsPath() const {
+    return (std::filesystem::path(m_recordsDir) / kRollupsFileName).string();
+}
+
+std::string RecordManager::keyAnalyticsPath() const {
+    return (std::filesystem::path(m_recordsDir) / kKeyAnalyticsFileName).string();
+}
+
+void RecordManager::ensureShardExists(const std::string& month) {
+    // 确保目录存在
+    std::filesystem::create_directories(m_recordsDir);
+
     // 如果文件不存在，创建并写入头部
-    std::ifstream testFile(m_csvPath);
+    const std::string path = shardPath(month);
+    std::ifstream testFile(path);
     if (!testFile.good()) {
-        std::ofstream file(m_csvPath);
-        file << "WPM,Accuracy,SurvivalTime,Date,CorrectWords,MissedWords,WrongAttempts,MaxCombo\n";
+        std::ofstream file(path);
+        file << "WPM,Accuracy,SurvivalTime,Date,CorrectWords,MissedWords,WrongAttempts,MaxCombo,Seed,RawWPM,SpeedCurve\n";
     }
 }
 
-bool RecordManager::loadRecords() {
-    std::ifstream file(m_csvPath);
+std::vector<GameRecord> RecordManager::readShard(const std::string& path) {
+    std::vector<GameRecord> records;
+    std::ifstream file(path);
     if (!file.is_open()) {
-        return false;
+        return records;
     }
-    
-    m_records.clear();
+
     std::string line;
-    
     // 跳过头部
     std::getline(file, line);
-    
+
     while (std::getline(file, line)) {
         if (line.empty()) continue;
-        
+
         try {
-            GameRecord record = GameRecord::fromCSVLine(line);
-            m_records.push_back(record);
+            records.push_back(GameRecord::fromCSVLine(line));
         } catch (...) {
             // 忽略解析错误的行
         }
     }
-    
-    sortRecordsByDate();
+    return records;
+}
+
+void RecordManager::migrateLegacyFile() {
+    if (!std::filesystem::exists(m_legacyCsvPath) || !m_shardMonths.empty()) {
+        return;
+    }
+
+    // 旧版单文件记录按月拆分，原文件保留为 .bak
+    std::vector<GameRecord> records = readShard(m_legacyCsvPath);
+    std::stable_sort(records.begin(), records.end(),
+        [](const GameRecord& a, const GameRecord& b) {
+            return a.date < b.date;
+        });
+
+    std::ofstream shard;
+    std::string currentMonth;
+    for (const auto& record : records) {
+        const std::string month = monthOf(record.date);
+        if (month != currentMonth) {
+            shard.close();
+            ensureShardExists(month);
+            shard.open(shardPath(month), std::ios::app);
+            currentMonth = month;
+        }
+        shard << record.toCSVLine() << "\n";
+    }
+    shard.close();
+
+    std::error_code ec;
+    std::filesystem::rename(m_legacyCsvPath, m_legacyCsvPath + ".bak", ec);
+}
+
+void RecordManager::scanShards() {
+    std::vector<std::string> months;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(m_recordsDir, ec)) {
+        const auto& path = entry.path();
+        const std::string stem = path.stem().string();
+        // 只认 YYYY-MM.csv
+        if (path.extension() == ".csv" && stem.size() == 7 && stem[4] == '-') {
+            months.push_back(stem);
+        }
+    }
+    std::sort(months.begin(), months.end());
+
+    std::unique_lock lock(m_mutex);
+    m_shardMonths = std::move(months);
+}
+
+void RecordManager::rebuildRollups() {
+    // 逐个分片流式累加，不需要把全部历史放进内存
+    RecordRollups rollups;
+    for (const auto& month : m_shardMonths) {
+        const std::string path = shardPath(month);
+        std::error_code ec;
+        const auto bytes = std::filesystem::file_size(path, ec);
+        if (!ec) {
+            rollups.setShardSize(month, bytes);
+        }
+        for (const auto& record : readShard(path)) {
+            rollups.add(record);
+        }
+    }
+    rollups.saveToFile(rollupsPath());
+
+    std::unique_lock lock(m_mutex);
+    m_rollups = std::move(rollups);
+}
+
+bool RecordManager::rollupsMatchShards(const RecordRollups& rollups) const {
+    // 追加分片之后、写汇总之前崩溃的话，分片大小会对不上
+    const auto& sizes = rollups.shardSizes();
+    if (sizes.size() != m_shardMonths.size()) {
+        return false;
+    }
+    for (const auto& month : m_shardMonths) {
+        auto it = sizes.find(month);
+        std::error_code ec;
+        const auto bytes = std::filesystem::file_size(shardPath(month), ec);
+        if (it == sizes.end() || ec || it->second != bytes) {
+            return false;
+        }
+    }
     return true;
 }
 
-bool RecordManager::saveRecord(const GameRecord& record) {
-    ensureFileExists();
-    
-    std::ofstream file(m_csvPath, std::ios::app);
-    if (!file.is_open()) {
+bool RecordManager::loadRecords() {
+    std::lock_guard shardLock(m_shardMutex);
+
+    scanShards();
+    migrateLegacyFile();
+    scanShards();
+
+    RecordRollups rollups;
+    if (rollups.loadFromFile(rollupsPath()) && rollupsMatchShards(rollups)) {
+        std::unique_lock lock(m_mutex);
+        m_rollups = std::move(rollups);
+    } else {
+        rebuildRollups();
+    }
+
+    {
+        std::unique_lock lock(m_mutex);
+        m_store.clear();
+        m_loadedMonths.clear();
+        ++m_version;
+    }
+
+    // 启动时只加载最新的月份，以及最佳记录所在的月份
+    std::vector<std::string> months;
+    if (!m_shardMonths.empty()) {
+        months.push_back(m_shardMonths.back());
+    }
+    {
+        std::shared_lock lock(m_mutex);
+        months.push_back(m_rollups.monthOfBestWpm());
+        months.push_back(m_rollups.monthOfLongestSurvival());
+    }
+    loadMonthsLocked(months);
+
+    notifyChanged();
+    return !m_shardMonths.empty();
+}
+
+bool RecordManager::loadMonthsLocked(const std::vector<std::string>& months) {
+    std::vector<std::string> pending;
+    {
+        std::shared_lock lock(m_mutex);
+        for (const auto& month : months) {
+            if (month.empty() || m_loadedMonths.count(month) > 0) continue;
+            if (!std::binary_search(m_shardMonths.begin(), m_shardMonths.end(), month)) continue;
+            if (std::find(pending.begin(), pending.end(), month) == pending.end()) {
+                pending.push_back(month);
+            }
+        }
+    }
+    if (pending.empty()) {
         return false;
     }
-    
-    file << record.toCSVLine() << "\n";
-    m_records.push_back(record);
-    
+
+    // 文件读取不持锁，读完再和已加载的记录合并
+    std::vector<GameRecord> loaded;
+    for (const auto& month : pending) {
+        auto records = readShard(shardPath(month));
+        loaded.insert(loaded.end(), records.begin(), records.end());
+    }
+
+    {
+        std::unique_lock lock(m_mutex);
+        std::vector<GameRecord> records;
+        records.reserve(m_store.size() + loaded.size());
+        for (uint32_t row = 0; row < m_store.size(); ++row) {
+            records.push_back(m_store.get(row));
+        }
+        records.insert(records.end(), loaded.begin(), loaded.end());
+
+        // 按日期排序后整体建立列存储和索引
+        std::stable_sort(records.begin(), records.end(),
+            [](const GameRecord& a, const GameRecord& b) {
+                return a.date < b.date;
+            });
+        m_store.clear();
+        m_store.appendBatch(records);
+        m_loadedMonths.insert(pending.begin(), pending.end());
+        ++m_version;
+    }
     return true;
 }
 
-std::vector<GameRecord> RecordManager::getAllRecords() const {
-    return m_records;
+bool RecordManager::loadMonth(const std::string& month) {
+    bool loaded = false;
+    {
+        std::lock_guard shardLock(m_shardMutex);
+        loaded = loadMonthsLocked({month});
+    }
+    if (loaded) {
+        notifyChanged();
+    }
+    return loaded;
 }
 
-GameRecord RecordManager::getBestRecord() const {
-    GameRecord best;
-    best.wpm = 0;
-    
-    for (const auto& record : m_records) {
-        if (record.wpm > best.wpm) {
-            best = record;
+bool RecordManager::loadOlderMonth() {
+    bool loaded = false;
+    {
+        std::lock_guard shardLock(m_shardMutex);
+        std::string month;
+        {
+            std::shared_lock lock(m_mutex);
+            for (auto it = m_shardMonths.rbegin(); it != m_shardMonths.rend(); ++it) {
+                if (m_loadedMonths.count(*it) == 0) {
+                    month = *it;
+                    break;
+                }
+            }
         }
+        loaded = loadMonthsLocked({month});
     }
-    
-    return best;
+    if (loaded) {
+        notifyChanged();
+    }
+    return loaded;
 }
 
-GameRecord RecordManager::getLongestSurvivalRecord() const {
-    GameRecord longest;
-    longest.survivalTime = 0.0f;
-    
-    for (const auto& record : m_records) {
-        if (record.survivalTime > longest.survivalTime) {
-            longest = record;
+bool RecordManager::loadMonthsFrom(const std::string& month) {
+    bool loaded = false;
+    {
+        std::lock_guard shardLock(m_shardMutex);
+        std::vector<std::string> months;
+        {
+            std::shared_lock lock(m_mutex);
+            auto first = std::lower_bound(m_shardMonths.begin(), m_shardMonths.end(), month);
+            months.assign(first, m_shardMonths.end());
         }
+        loaded = loadMonthsLocked(months);
     }
-    
-    return longest;
+    if (loaded) {
+        notifyChanged();
+    }
+    return loaded;
+}
+
+bool RecordManager::loadAllMonths() {
+    return loadMonthsFrom("");
+}
+
+ShardStatus RecordManager::getShardStatus() const {
+    std::shared_lock lock(m_mutex);
+    ShardStatus status;
+    status.availableMonths = m_shardMonths.size();
+    status.loadedMonths = m_loadedMonths.size();
+    if (!m_loadedMonths.empty()) {
+        status.oldestLoadedMonth = *m_loadedMonths.begin();
+    }
+    return status;
+}
+
+bool RecordManager::saveRecord(const GameRecord& record) {
+    const std::string month = monthOf(record.date);
+    {
+        std::lock_guard shardLock(m_shardMutex);
+
+        // 先把本月已有记录读进来，保证已加载的月份总是完整的
+        loadMonthsLocked({month});
+        ensureShardExists(month);
+
+        const std::string path = shardPath(month);
+        std::ofstream file(path, std::ios::app);
+        if (!file.is_open()) {
+            return false;
+        }
+        file << record.toCSVLine() << "\n";
+        file.close();
+        // 汇总记下分片写完后的大小，下次启动据此判断汇总是否过期
+        std::error_code ec;
+        const auto bytes = std::filesystem::file_size(path, ec);
+
+        RecordRollups rollups;
+        {
+            std::unique_lock lock(m_mutex);
+            m_store.append(record);
+            m_rollups.add(record);
+            if (!ec) {
+                m_rollups.setShardSize(month, bytes);
+            }
+            if (!std::binary_search(m_shardMonths.begin(), m_shardMonths.end(), month)) {
+                m_shardMonths.insert(std::upper_bound(m_shardMonths.begin(), m_shardMonths.end(), month), month);
+            }
+            m_loadedMonths.insert(month);
+            rollups = m_rollups;
+            ++m_version;
+        }
+        rollups.saveToFile(rollupsPath());
+    }
+    notifyChanged();
+
+    return true;
+}
+
+void RecordManager::setChangeListener(std::function<void()> listener) {
+    std::lock_guard lock(m_listenerMutex);
+    m_changeListener = std::move(listener);
+}
+
+void RecordManager::notifyChanged() {
+    std::function<void()> listener;
+    {
+        std::lock_guard lock(m_listenerMutex);
+        listener = m_changeListener;
+    }
+    if (listener) {
+        listener();
+    }
+}
+
+size_t RecordManager::getRecordCount() const {
+    std::shared_lock lock(m_mutex);
+    return m_store.size();
+}
+
+GameRecord RecordManager::getRecord(size_t index) const {
+    std::shared_lock lock(m_mutex);
+    return m_store.get(static_cast<uint32_t>(index));
+}
+
+std::vector<uint32_t> RecordManager::query(const RecordQuery& query) const {
+    std::shared_lock lock(m_mutex);
+    return m_store.query(query);
+}
+
+std::vector<GameRecord> RecordManager::getAllRecords() const {
+    std::shared_lock lock(m_mutex);
+    std::vector<GameRecord> records;
+    records.reserve(m_store.size());
+    for (uint32_t row = 0; row < m_store.size(); ++row) {
+        records.push_back(m_store.get(row));
+    }
+    return records;
+}
+
+GameRecord RecordManager::getBestRecord() const {
+    std::shared_lock lock(m_mutex);
+    return m_store.topRecord(RecordColumn::WPM);
+}
+
+GameRecord RecordManager::getLongestSurvivalRecord() const {
+    std::shared_lock lock(m_mutex);
+    return m_store.topRecord(RecordColumn::Survival);
 }
 
 bool RecordManager::isNewRecord(const GameRecord& record) const {
-    GameRecord best = getBestRecord();
-    return record.wpm > best.wpm;
+    // 汇总覆盖全部历史，不依赖分片是否加载
+    std::shared_lock lock(m_mutex);
+    return record.wpm > m_rollups.bestWpm();
 }
 
 std::vector<double> RecordManager::getRecentWPMAverage(int lastN) const {
+    std::shared_lock lock(m_mutex);
     std::vector<double> result;
-    int count = std::min(lastN, static_cast<int>(m_records.size()));
+    const auto& wpm = m_store.wpmColumn();
+    int count = std::min(lastN, static_cast<int>(wpm.size()));
     
     if (count == 0) return result;
     
     // 从最后开始取N条记录
-    for (int i = std::max(0, static_cast<int>(m_records.size()) - count); 
-         i < static_cast<int>(m_records.size()); ++i) {
-        result.push_back(m_records[i].wpm);
-    }
-    
+    result.assign(wpm.end() - count, wpm.end());
     return result;
 }
 
 std::vector<std::pair<std::string, double>> RecordManager::getWPMTimeSeries(int lastN) const {
+    std::shared_lock lock(m_mutex);
     std::vector<std::pair<std::string, double>> result;
-    int count = std::min(lastN, static_cast<int>(m_records.size()));
+    const int size = static_cast<int>(m_store.size());
+    int count = std::min(lastN, size);
+    result.reserve(count);
     
-    for (int i = std::max(0, static_cast<int>(m_records.size()) - count); 
-         i < static_cast<int>(m_records.size()); ++i) {
-        const auto& record = m_records[i];
+    for (int i = size - count; i < size; ++i) {
+        const auto row = static_cast<uint32_t>(i);
+        const auto& date = m_store.date(row);
         // 只取日期部分（前10个字符）
-        std::string date = record.date.substr(0, std::min(10, static_cast<int>(record.date.length())));
-        result.emplace_back(date, record.wpm);
+        result.emplace_back(date.substr(0, std::min<size_t>(10, date.length())), m_store.wpm(row));
     }
     
     return result;
 }
-
-void RecordManager::sortRecordsByDate() {
-    std::sort(m_records.begin(), m_records.end(),
-        [](const GameRecord& a, const GameRecord& b) {
-            return a.date < b.date;
-        });
-}
-
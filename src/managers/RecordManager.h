@@ -1,32 +1,126 @@
 #pragma once
 
+#include "RecordQuery.h"
+#include "RecordRollups.h"
+#include "RecordStore.h"
 #include "../models/GameRecord.h"
 #include "../utils/GameConfig.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
 #include <vector>
 #include <string>
 #include <utility>
 
+// Which monthly shards are in memory
+struct ShardStatus {
+    size_t availableMonths = 0;
+    size_t loadedMonths = 0;
+    std::string oldestLoadedMonth; // "YYYY-MM", empty when nothing is loaded
+
+    bool fullyLoaded() const { return loadedMonths >= availableMonths; }
+};
+
+// History is stored as one CSV per month ("data/records/2025-03.csv") plus a
+// rollups file with daily/weekly/monthly aggregates. Startup only reads the
+// rollups, the newest month and the months holding the all-time bests; older
+// months are loaded when the Stats screen pages into them. Rollups that no
+// longer match the shards (a crash between the two writes) are rebuilt.
+//
+// Thread-safe: readers (UI, StatsWorker) take a shared lock, load/save an
+// exclusive one. Change listeners run on the thread that modified the records.
 class RecordManager {
 public:
-    RecordManager(const std::string& csvPath = GamePaths::RECORDS_FILE);
-    
+    RecordManager(const std::string& recordsDir = GamePaths::RECORDS_DIR,
+                  const std::string& legacyCsvPath = GamePaths::RECORDS_FILE);
+
     bool loadRecords();
     bool saveRecord(const GameRecord& record);
-    
+
+    // Lazy shard loading, each returns true if new records were loaded.
+    // Older shards are merged in date order, so row ids change on every load.
+    bool loadMonth(const std::string& month);
+    // Newest month that is not loaded yet
+    bool loadOlderMonth();
+    // Every month from the given "YYYY-MM" onwards
+    bool loadMonthsFrom(const std::string& month);
+    bool loadAllMonths();
+    ShardStatus getShardStatus() const;
+
+    // All games loaded so far; getBestRecord()/getLongestSurvivalRecord() are
+    // always exact because their months are loaded at startup
     std::vector<GameRecord> getAllRecords() const;
+
+    // Windowed access without copying the history
+    size_t getRecordCount() const;
+    GameRecord getRecord(size_t index) const;
+    // Row ids matching the filters, in the requested order
+    std::vector<uint32_t> query(const RecordQuery& query) const;
+    // Runs fn with shared access to the columnar store
+    template <typename Fn>
+    decltype(auto) readStore(Fn&& fn) const {
+        std::shared_lock lock(m_mutex);
+        return fn(m_store);
+    }
+    // Runs fn with shared access to the rollups of the whole history
+    template <typename Fn>
+    decltype(auto) readRollups(Fn&& fn) const {
+        std::shared_lock lock(m_mutex);
+        return fn(m_rollups);
+    }
+    // Bumped whenever the record set changes, lets views drop cached data
+    uint64_t getVersion() const { return m_version.load(); }
+    void setChangeListener(std::function<void()> listener);
     GameRecord getBestRecord() const;
     GameRecord getLongestSurvivalRecord() const;
     bool isNewRecord(const GameRecord& record) const;
-    
+
     // Stats methods
     std::vector<double> getRecentWPMAverage(int lastN = 100) const;
     std::vector<std::pair<std::string, double>> getWPMTimeSeries(int lastN = 100) const;
-    
+
+    // Where the keystroke log of a game is kept (see InputLog)
+    std::string inputLogPath(const GameRecord& record) const;
+    // Where the per-keystroke telemetry of a game is kept (see KeystrokeLog)
+    std::string keystrokeLogPath(const GameRecord& record) const;
+    // Where the letter confusion and timing counters are kept (see KeyAnalytics)
+    std::string keyAnalyticsPath() const;
+
+    static constexpr const char* kRollupsFileName = "rollups.csv";
+    static constexpr const char* kKeyAnalyticsFileName = "analytics.bin";
+    static constexpr const char* kInputLogDirName = "inputs";
+    static constexpr const char* kKeystrokeDirName = "keystrokes";
+
 private:
-    std::string m_csvPath;
-    std::vector<GameRecord> m_records;
-    
-    void sortRecordsByDate();
-    void ensureFileExists();
-};
+    std::string m_recordsDir;
+    std::string m_legacyCsvPath;
+    RecordStore m_store;
+    RecordRollups m_rollups;
+    std::vector<std::string> m_shardMonths; // Ascending
+    std::set<std::string> m_loadedMonths;
+    std::atomic<uint64_t> m_version = 0;
+    mutable std::shared_mutex m_mutex;
+    // Serializes shard file access, taken before m_mutex
+    std::mutex m_shardMutex;
+    std::function<void()> m_changeListener;
+    std::mutex m_listenerMutex;
 
+    void notifyChanged();
+    std::string shardPath(const std::string& month) const;
+    std::string rollupsPath() const;
+    std::string gameFilePath(const GameRecord& record, const char* dirName, const char* extension) const;
+    void ensureShardExists(const std::string& month);
+    void migrateLegacyFile();
+    void scanShards();
+    void rebuildRollups();
+    // False when a shard was added, removed or written since the rollups were saved
+    bool rollupsMatchShards(const RecordRollups& rollups) const;
+    // Caller holds m_shardMutex
+    bool loadMonthsLocked(const std::vector<std::string>& months);
+    static std::vector<GameRecord> readShard(const std::string& path);
+    static std::string monthOf(const std::string& date);
+};
@@ -0,0 +1,309 @@
+#include "RecordQuery.h"
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+constexpr size_t kDateKeyDigits = 12; // YYYYMMDDhhmm
+
+struct FilterKey
+{
+    const char* name;
+    RecordColumn column;
+};
+
+constexpr FilterKey kFilterKeys[] = {
+    {"wpm", RecordColumn::WPM},
+    {"acc", RecordColumn::Accuracy},
+    {"time", RecordColumn::Survival},
+    {"combo", RecordColumn::Combo},
+    {"date", RecordColumn::Date},
+};
+
+const char* filterName(RecordColumn column)
+{
+    for (const auto& key : kFilterKeys)
+    {
+        if (key.column == column)
+            return key.name;
+    }
+    return "?";
+}
+
+bool parseBound(RecordColumn column, const std::string& text, char padDigit, double& out)
+{
+    if (text.empty())
+        return false;
+
+    if (column == RecordColumn::Date)
+    {
+        // Same YYYY-MM[-DD] rule the month and day rollups use
+        if (!isDatePrefix(text))
+            return false;
+        out = static_cast<double>(dateKey(text, padDigit));
+        return true;
+    }
+
+    try
+    {
+        size_t consumed = 0;
+        out = std::stod(text, &consumed);
+        // stod takes "nan" and "inf", which would filter silently
+        return consumed == text.size() && std::isfinite(out);
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+// WPM, combo and date keys only take whole values
+bool isIntegral(RecordColumn column)
+{
+    return column == RecordColumn::WPM || column == RecordColumn::Combo || column == RecordColumn::Date;
+}
+
+// Smallest value of the column greater than value, and largest one below it.
+// A date prefix is first padded to the end of its period for '>' and to the
+// start of it for '<', so date>2025-03 starts in April.
+double nextAbove(RecordColumn column, double value)
+{
+    return isIntegral(column) ? std::floor(value) + 1.0 : std::nextafter(value, std::numeric_limits<double>::infinity());
+}
+
+double nextBelow(RecordColumn column, double value)
+{
+    return isIntegral(column) ? std::ceil(value) - 1.0 : std::nextafter(value, -std::numeric_limits<double>::infinity());
+}
+
+std::string formatBound(RecordColumn column, double value, char padDigit)
+{
+    if (column != RecordColumn::Date)
+    {
+        std::ostringstream oss;
+        oss << value;
+        return oss.str();
+    }
+
+    // Print the shortest prefix that round-trips, so "2025-03" stays "2025-03"
+    const std::string digits = std::to_string(static_cast<int64_t>(value));
+    size_t length = kDateKeyDigits;
+    for (size_t candidate : {size_t(4), size_t(6), size_t(8), size_t(10)})
+    {
+        if (digits.find_first_not_of(padDigit, candidate) == std::string::npos)
+        {
+            length = candidate;
+            break;
+        }
+    }
+
+    std::string result = digits.substr(0, 4);
+    if (length > 4)
+        result += "-" + digits.substr(4, 2);
+    if (length > 6)
+        result += "-" + digits.substr(6, 2);
+    if (length > 8)
+        result += " " + digits.substr(8, 2) + ":" + digits.substr(10, 2);
+    return result;
+}
+// A fractional bound that only prints exactly as the value next to it in
+// direction, i.e. one parsed from '>' or '<'
+bool isStrictBound(RecordColumn column, double value, double direction)
+{
+    if (isIntegral(column))
+        return false;
+    const double neighbour = std::nextafter(value, direction * std::numeric_limits<double>::infinity());
+    return std::stod(formatBound(column, value, '0')) != value && std::stod(formatBound(column, neighbour, '0')) == neighbour;
+}
+} // namespace
+
+int64_t dateKey(const std::string& date, char padDigit)
+{
+    std::string digits;
+    digits.reserve(kDateKeyDigits);
+    for (char c : date)
+    {
+        if (std::isdigit(static_cast<unsigned char>(c)))
+        {
+            digits += c;
+            if (digits.size() == kDateKeyDigits)
+                break;
+        }
+    }
+    digits.append(kDateKeyDigits - digits.size(), padDigit);
+    return std::stoll(digits);
+}
+
+bool isDatePrefix(const std::string& text)
+{
+    if (text.size() != 7 && text.size() != 10)
+        return false;
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+        const bool separator = i == 4 || i == 7;
+        if (separator ? text[i] != '-' : !std::isdigit(static_cast<unsigned char>(text[i])))
+            return false;
+    }
+
+    const int month = std::stoi(text.substr(5, 2));
+    if (month < 1 || month > 12)
+        return false;
+    if (text.size() == 7)
+        return true;
+
+    using namespace std::chrono;
+    const year_month_day day{year{std::stoi(text.substr(0, 4))}, std::chrono::month{static_cast<unsigned>(month)},
+                             std::chrono::day{static_cast<unsigned>(std::stoi(text.substr(8, 2)))}};
+    return day.ok();
+}
+
+RecordQuery& RecordQuery::where(RecordColumn column, double min, double max)
+{
+    auto& range = ranges[static_cast<size_t>(column)];
+    range.min = min;
+    range.max = max;
+    return *this;
+}
+
+RecordQuery& RecordQuery::dateBetween(const std::string& fromPrefix, const std::string& toPrefix)
+{
+    auto& range = ranges[static_cast<size_t>(RecordColumn::Date)];
+    range = ColumnRange{};
+    if (!fromPrefix.empty())
+        range.min = static_cast<double>(dateKey(fromPrefix, '0'));
+    if (!toPrefix.empty())
+        range.max = static_cast<double>(dateKey(toPrefix, '9'));
+    return *this;
+}
+
+RecordQuery& RecordQuery::orderBy(RecordColumn column, bool ascendingOrder)
+{
+    sortColumn = column;
+    ascending = ascendingOrder;
+    return *this;
+}
+
+bool RecordQuery::hasFilters() const
+{
+    for (const auto& range : ranges)
+    {
+        if (range.isBounded())
+            return true;
+    }
+    return false;
+}
+
+std::string RecordQuery::describeFilters() const
+{
+    std::string result;
+    for (size_t i = 0; i < kRecordColumnCount; ++i)
+    {
+        const auto& range = ranges[i];
+        if (!range.isBounded())
+            continue;
+
+        const auto column = static_cast<RecordColumn>(i);
+        if (!result.empty())
+            result += " ";
+        result += filterName(column);
+
+        const bool hasMin = range.min != -std::numeric_limits<double>::infinity();
+        const bool hasMax = range.max != std::numeric_limits<double>::infinity();
+        const std::string from = hasMin ? formatBound(column, range.min, '0') : "";
+        const std::string to = hasMax ? formatBound(column, range.max, '9') : "";
+        if (hasMin && hasMax)
+            result += from == to ? "=" + from : "=" + from + ".." + to;
+        else if (hasMin)
+            result += isStrictBound(column, range.min, -1.0) ? ">" + formatBound(column, nextBelow(column, range.min), '0') : ">=" + from;
+        else
+            result += isStrictBound(column, range.max, 1.0) ? "<" + formatBound(column, nextAbove(column, range.max), '9') : "<=" + to;
+    }
+    return result;
+}
+
+bool RecordQuery::parseFilters(const std::string& text, RecordQuery& query, std::string& error)
+{
+    RecordQuery parsed;
+    parsed.sortColumn = query.sortColumn;
+    parsed.ascending = query.ascending;
+
+    std::istringstream iss(text);
+    std::string term;
+    while (iss >> term)
+    {
+        size_t opPos = term.find_first_of("<>=");
+        if (opPos == std::string::npos || opPos == 0)
+        {
+            error = "Expected key>=value, key>value, key<=value, key<value or key=a..b: " + term;
+            return false;
+        }
+
+        const std::string name = term.substr(0, opPos);
+        const FilterKey* key = nullptr;
+        for (const auto& candidate : kFilterKeys)
+        {
+            if (name == candidate.name)
+                key = &candidate;
+        }
+        if (!key)
+        {
+            error = "Unknown filter '" + name + "' (use wpm, acc, time, combo, date)";
+            return false;
+        }
+
+        std::string op = term.substr(opPos, 1);
+        if (opPos + 1 < term.size() && term[opPos + 1] == '=')
+            op += "=";
+        const std::string value = term.substr(opPos + op.size());
+
+        auto& range = parsed.ranges[static_cast<size_t>(key->column)];
+        bool ok = true;
+        if (op == ">=")
+        {
+            ok = parseBound(key->column, value, '0', range.min);
+        }
+        else if (op == ">")
+        {
+            ok = parseBound(key->column, value, '9', range.min);
+            range.min = nextAbove(key->column, range.min);
+        }
+        else if (op == "<=")
+        {
+            ok = parseBound(key->column, value, '9', range.max);
+        }
+        else if (op == "<")
+        {
+            ok = parseBound(key->column, value, '0', range.max);
+            range.max = nextBelow(key->column, range.max);
+        }
+        else
+        {
+            size_t dots = value.find("..");
+            if (dots == std::string::npos)
+            {
+                // Exact value, or a whole day/month for dates
+                ok = parseBound(key->column, value, '0', range.min) && parseBound(key->column, value, '9', range.max);
+            }
+            else
+            {
+                const std::string from = value.substr(0, dots);
+                const std::string to = value.substr(dots + 2);
+                ok = (from.empty() || parseBound(key->column, from, '0', range.min)) &&
+                     (to.empty() || parseBound(key->column, to, '9', range.max));
+            }
+        }
+
+        if (!ok)
+        {
+            error = key->column == RecordColumn::Date ? "Invalid date in '" + term + "' (use YYYY-MM or YYYY-MM-DD)"
+                                                      : "Invalid value in '" + term + "'";
+            return false;
+        }
+    }
+
+    query = parsed;
+    return true;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+enum class RecordColumn
+{
+    WPM = 0,
+    Accuracy,
+    Survival,
+    Combo,
+    Date,
+    Count
+};
+
+constexpr size_t kRecordColumnCount = static_cast<size_t>(RecordColumn::Count);
+
+// Inclusive [min, max] bound on a single column. Dates are compared through
+// their numeric key YYYYMMDDhhmm, see dateKey().
+struct ColumnRange
+{
+    double min = -std::numeric_limits<double>::infinity();
+    double max = std::numeric_limits<double>::infinity();
+
+    bool isBounded() const { return min != -std::numeric_limits<double>::infinity() || max != std::numeric_limits<double>::infinity(); }
+    bool contains(double value) const { return value >= min && value <= max; }
+};
+
+// Filter + sort description evaluated by RecordStore::query()
+struct RecordQuery
+{
+    std::array<ColumnRange, kRecordColumnCount> ranges;
+    RecordColumn sortColumn = RecordColumn::Date;
+    bool ascending = true;
+
+    RecordQuery& where(RecordColumn column, double min, double max);
+    // Both prefixes are inclusive and may be partial ("2025", "2025-03")
+    RecordQuery& dateBetween(const std::string& fromPrefix, const std::string& toPrefix);
+    RecordQuery& orderBy(RecordColumn column, bool ascendingOrder);
+
+    bool hasFilters() const;
+    std::string describeFilters() const;
+
+    // Parses space separated terms such as "wpm>=40 acc=90..100 date=2025-01..2025-03 time<=120".
+    // '>' and '<' are strict: wpm>40 starts at 41 and date<2025-03 ends in February.
+    // Numbers must be finite and dates whole YYYY-MM or YYYY-MM-DD.
+    // Returns false and fills error on malformed input, leaving query untouched.
+    static bool parseFilters(const std::string& text, RecordQuery& query, std::string& error);
+};
+
+// "2025-03-14 09:30" -> 202503140930. Missing trailing digits are filled with
+// padDigit, so a prefix can produce both ends of a range.
+int64_t dateKey(const std::string& date, char padDigit = '0');
+
+// True for a whole "YYYY-MM" or "YYYY-MM-DD" naming a real month or day
+bool isDatePrefix(const std::string& text);
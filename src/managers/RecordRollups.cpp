@@ -0,0 +1,272 @@
+#include "RecordRollups.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+const char* kPeriodNames[] = {"day", "week", "month"};
+// Rows recording the size of each shard the rollups were built from
+const char* kShardRow = "shard";
+
+// "YYYY-MM" (length 7) or "YYYY-MM-DD" (length 10) at the start of date
+bool hasDatePrefix(const std::string& date, size_t length)
+{
+    if (date.size() < length)
+        return false;
+    for (size_t i = 0; i < length; ++i)
+    {
+        const bool separator = i == 4 || i == 7;
+        if (separator ? date[i] != '-' : (date[i] < '0' || date[i] > '9'))
+            return false;
+    }
+    return true;
+}
+
+// ISO-8601 week ("2025-W03"); the week belongs to the year holding its Thursday
+std::string isoWeekKey(const std::string& date)
+{
+    int y = 0;
+    unsigned m = 0;
+    unsigned d = 0;
+    if (std::sscanf(date.c_str(), "%d-%u-%u", &y, &m, &d) != 3)
+        return "";
+
+    using namespace std::chrono;
+    const year_month_day ymd{year{y}, month{m}, day{d}};
+    if (!ymd.ok())
+        return "";
+
+    const sys_days today{ymd};
+    const int isoWeekday = static_cast<int>(weekday{today}.iso_encoding());
+    const sys_days thursday = today + days{4 - isoWeekday};
+    const year_month_day thursdayDate{thursday};
+    const sys_days januaryFirst{thursdayDate.year() / January / 1};
+    const int week = static_cast<int>((thursday - januaryFirst).count() / 7) + 1;
+
+    // Room for any int year and week, so the format can never truncate
+    char key[32];
+    std::snprintf(key, sizeof(key), "%04d-W%02d", static_cast<int>(thursdayDate.year()), week);
+    return key;
+}
+} // namespace
+
+void RollupBucket::add(const GameRecord& record)
+{
+    ++count;
+    sumWpm += record.wpm;
+    maxWpm = std::max(maxWpm, record.wpm);
+    sumAccuracy += record.accuracy;
+    totalSurvival += record.survivalTime;
+    maxSurvival = std::max(maxSurvival, record.survivalTime);
+}
+
+std::string RecordRollups::periodKey(RollupPeriod period, const std::string& date)
+{
+    switch (period)
+    {
+    case RollupPeriod::Day:
+        return hasDatePrefix(date, 10) ? date.substr(0, 10) : "";
+    case RollupPeriod::Week:
+        return isoWeekKey(date);
+    case RollupPeriod::Month:
+    case RollupPeriod::Count:
+        break;
+    }
+    return hasDatePrefix(date, 7) ? date.substr(0, 7) : "";
+}
+
+void RecordRollups::clear()
+{
+    for (auto& buckets : m_buckets)
+    {
+        buckets.clear();
+    }
+    m_shardSizes.clear();
+}
+
+void RecordRollups::setShardSize(const std::string& month, uintmax_t bytes)
+{
+    m_shardSizes[month] = bytes;
+}
+
+void RecordRollups::add(const GameRecord& record)
+{
+    for (size_t p = 0; p < m_buckets.size(); ++p)
+    {
+        const auto period = static_cast<RollupPeriod>(p);
+        std::string key = periodKey(period, record.date);
+        if (key.empty() && period == RollupPeriod::Month)
+        {
+            // Kept in the undated shard, so the all-time figures count it too
+            key = kUndatedMonth;
+        }
+        if (!key.empty())
+        {
+            m_buckets[p][key].add(record);
+        }
+    }
+}
+
+RollupBucket RecordRollups::bucketFor(RollupPeriod period, const std::string& date) const
+{
+    const auto& buckets = m_buckets[static_cast<size_t>(period)];
+    auto it = buckets.find(periodKey(period, date));
+    return it != buckets.end() ? it->second : RollupBucket{};
+}
+
+int RecordRollups::totalGames() const
+{
+    int total = 0;
+    for (const auto& [key, bucket] : buckets(RollupPeriod::Month))
+    {
+        total += bucket.count;
+    }
+    return total;
+}
+
+int RecordRollups::bestWpm() const
+{
+    int best = 0;
+    for (const auto& [key, bucket] : buckets(RollupPeriod::Month))
+    {
+        best = std::max(best, bucket.maxWpm);
+    }
+    return best;
+}
+
+std::string RecordRollups::monthOfBestWpm() const
+{
+    std::string month;
+    int best = 0;
+    for (const auto& [key, bucket] : buckets(RollupPeriod::Month))
+    {
+        if (bucket.maxWpm > best)
+        {
+            best = bucket.maxWpm;
+            month = key;
+        }
+    }
+    return month;
+}
+
+std::string RecordRollups::monthOfLongestSurvival() const
+{
+    std::string month;
+    float longest = 0.0f;
+    for (const auto& [key, bucket] : buckets(RollupPeriod::Month))
+    {
+        if (bucket.maxSurvival > longest)
+        {
+            longest = bucket.maxSurvival;
+            month = key;
+        }
+    }
+    return month;
+}
+
+bool RecordRollups::loadFromFile(const std::string& filepath)
+{
+    std::ifstream file(filepath);
+    if (!file.is_open())
+        return false;
+
+    clear();
+    std::string line;
+    std::getline(file, line); // Header
+
+    while (std::getline(file, line))
+    {
+        if (line.empty())
+            continue;
+
+        std::istringstream iss(line);
+        std::string token;
+        std::vector<std::string> tokens;
+        while (std::getline(iss, token, ','))
+        {
+            tokens.push_back(token);
+        }
+        if (tokens.size() >= 3 && tokens[0] == kShardRow)
+        {
+            try
+            {
+                m_shardSizes[tokens[1]] = std::stoull(tokens[2]);
+            }
+            catch (...)
+            {
+                // Left out, which fails the check against the shards
+            }
+            continue;
+        }
+        if (tokens.size() < 8)
+            continue;
+
+        try
+        {
+            for (size_t p = 0; p < m_buckets.size(); ++p)
+            {
+                if (tokens[0] != kPeriodNames[p])
+                    continue;
+
+                RollupBucket bucket;
+                bucket.count = std::stoi(tokens[2]);
+                bucket.sumWpm = std::stoll(tokens[3]);
+                bucket.maxWpm = std::stoi(tokens[4]);
+                bucket.sumAccuracy = std::stod(tokens[5]);
+                bucket.totalSurvival = std::stod(tokens[6]);
+                bucket.maxSurvival = std::stof(tokens[7]);
+                m_buckets[p][tokens[1]] = bucket;
+            }
+        }
+        catch (...)
+        {
+            // Ignore malformed rows, the bucket is rebuilt on the next full scan
+        }
+    }
+
+    return true;
+}
+
+bool RecordRollups::saveToFile(const std::string& filepath) const
+{
+    std::filesystem::path path(filepath);
+    if (!path.parent_path().empty())
+    {
+        std::filesystem::create_directories(path.parent_path());
+    }
+
+    // Write next to the target and swap, so a crash never leaves a half file
+    const std::string tempPath = filepath + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::trunc);
+        if (!file.is_open())
+            return false;
+
+        file << std::setprecision(12);
+        file << "Period,Key,Count,SumWPM,MaxWPM,SumAccuracy,TotalSurvival,MaxSurvival\n";
+        for (size_t p = 0; p < m_buckets.size(); ++p)
+        {
+            for (const auto& [key, bucket] : m_buckets[p])
+            {
+                file << kPeriodNames[p] << "," << key << "," << bucket.count << "," << bucket.sumWpm << "," << bucket.maxWpm << ","
+                     << bucket.sumAccuracy << "," << bucket.totalSurvival << "," << bucket.maxSurvival << "\n";
+            }
+        }
+        for (const auto& [month, bytes] : m_shardSizes)
+        {
+            file << kShardRow << "," << month << "," << bytes << "\n";
+        }
+        if (!file.flush())
+            return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, filepath, ec);
+    return !ec;
+}
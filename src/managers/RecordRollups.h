@@ -0,0 +1,72 @@
+#pragma once
+
+#include "../models/GameRecord.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+
+enum class RollupPeriod
+{
+    Day = 0,
+    Week,
+    Month,
+    Count
+};
+
+// Aggregate of every game played in one day, ISO week or month
+struct RollupBucket
+{
+    int count = 0;
+    long long sumWpm = 0;
+    int maxWpm = 0;
+    double sumAccuracy = 0.0;
+    double totalSurvival = 0.0;
+    float maxSurvival = 0.0f;
+
+    void add(const GameRecord& record);
+    double meanWpm() const { return count > 0 ? static_cast<double>(sumWpm) / count : 0.0; }
+    double meanAccuracy() const { return count > 0 ? sumAccuracy / count : 0.0; }
+};
+
+// Daily, weekly and monthly rollups of the whole history. They stay in memory
+// even when the raw monthly shards are not loaded, so all-time figures never
+// need a full scan. Records without a valid date only count towards the
+// months, under kUndatedMonth.
+//
+// The file also keeps the size of every shard the rollups cover, so a shard
+// written after the rollups were saved is caught on the next load.
+class RecordRollups
+{
+public:
+    using Buckets = std::map<std::string, RollupBucket>;
+    using ShardSizes = std::map<std::string, uintmax_t>;
+
+    static constexpr const char* kUndatedMonth = "0000-00";
+
+    void clear();
+    void add(const GameRecord& record);
+
+    bool loadFromFile(const std::string& filepath);
+    bool saveToFile(const std::string& filepath) const;
+
+    const Buckets& buckets(RollupPeriod period) const { return m_buckets[static_cast<size_t>(period)]; }
+    // Size in bytes of each month's shard when these rollups last matched it
+    void setShardSize(const std::string& month, uintmax_t bytes);
+    const ShardSizes& shardSizes() const { return m_shardSizes; }
+    // Bucket for the period containing date, or an empty bucket
+    RollupBucket bucketFor(RollupPeriod period, const std::string& date) const;
+
+    int totalGames() const;
+    int bestWpm() const;
+    // Month keys ("YYYY-MM") holding the all-time maxima, empty without games
+    std::string monthOfBestWpm() const;
+    std::string monthOfLongestSurvival() const;
+
+    static std::string periodKey(RollupPeriod period, const std::string& date);
+
+private:
+    std::array<Buckets, static_cast<size_t>(RollupPeriod::Count)> m_buckets;
+    ShardSizes m_shardSizes;
+};
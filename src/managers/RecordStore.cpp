@@ -0,0 +1,300 @@
+#include "RecordStore.h"
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+// Below this share of the table the most selective index range is scanned
+// directly, above it a sequential column scan plus an index walk is cheaper.
+constexpr size_t kIndexScanDivisor = 8;
+// Candidate sets smaller than this share are sorted directly, larger ones are
+// flagged and picked up by walking the sort column's index.
+constexpr size_t kCandidateSortDivisor = 64;
+
+struct IndexRange
+{
+    size_t begin = 0;
+    size_t end = 0;
+    size_t count() const { return end - begin; }
+};
+
+template <typename Column>
+IndexRange findRange(const Column& values, const std::vector<uint32_t>& index, const ColumnRange& range)
+{
+    auto first = std::partition_point(index.begin(), index.end(), [&](uint32_t row) { return values[row] < range.min; });
+    auto last = std::partition_point(first, index.end(), [&](uint32_t row) { return values[row] <= range.max; });
+    return {static_cast<size_t>(first - index.begin()), static_cast<size_t>(last - index.begin())};
+}
+} // namespace
+
+void RecordStore::clear()
+{
+    m_wpm.clear();
+    m_accuracy.clear();
+    m_survival.clear();
+    m_combo.clear();
+    m_dateKey.clear();
+    m_date.clear();
+    m_correctWords.clear();
+    m_missedWords.clear();
+    m_wrongAttempts.clear();
+    m_seed.clear();
+    m_rawWpm.clear();
+    m_curveStart.assign(1, 0);
+    m_curveValues.clear();
+    for (auto& index : m_indexes)
+    {
+        index.clear();
+    }
+}
+
+void RecordStore::pushColumns(const GameRecord& record)
+{
+    m_wpm.push_back(record.wpm);
+    m_accuracy.push_back(record.accuracy);
+    m_survival.push_back(record.survivalTime);
+    m_combo.push_back(record.maxCombo);
+    m_dateKey.push_back(dateKey(record.date));
+    m_date.push_back(record.date);
+    m_correctWords.push_back(record.correctWords);
+    m_missedWords.push_back(record.missedWords);
+    m_wrongAttempts.push_back(record.wrongAttempts);
+    m_seed.push_back(record.seed);
+    m_rawWpm.push_back(record.rawWpm);
+    m_curveValues.insert(m_curveValues.end(), record.speedCurve.begin(), record.speedCurve.end());
+    m_curveStart.push_back(static_cast<uint32_t>(m_curveValues.size()));
+}
+
+void RecordStore::append(const GameRecord& record)
+{
+    pushColumns(record);
+    const auto row = static_cast<uint32_t>(size() - 1);
+
+    for (size_t c = 0; c < kRecordColumnCount; ++c)
+    {
+        auto& index = m_indexes[c];
+        visitColumn(
+            static_cast<RecordColumn>(c),
+            [&](const auto& values)
+            {
+                // The new row has the largest id, so inserting after equal values keeps ties in row order
+                auto pos = std::upper_bound(
+                    index.begin(), index.end(), values[row], [&](const auto& value, uint32_t other) { return value < values[other]; }
+                );
+                index.insert(pos, row);
+            }
+        );
+    }
+}
+
+void RecordStore::appendBatch(const std::vector<GameRecord>& records)
+{
+    const size_t newSize = size() + records.size();
+    m_wpm.reserve(newSize);
+    m_accuracy.reserve(newSize);
+    m_survival.reserve(newSize);
+    m_combo.reserve(newSize);
+    m_dateKey.reserve(newSize);
+    m_date.reserve(newSize);
+    m_correctWords.reserve(newSize);
+    m_missedWords.reserve(newSize);
+    m_wrongAttempts.reserve(newSize);
+    m_seed.reserve(newSize);
+    m_rawWpm.reserve(newSize);
+    m_curveStart.reserve(newSize + 1);
+
+    for (const auto& record : records)
+    {
+        pushColumns(record);
+    }
+
+    for (size_t c = 0; c < kRecordColumnCount; ++c)
+    {
+        rebuildIndex(static_cast<RecordColumn>(c));
+    }
+}
+
+void RecordStore::rebuildIndex(RecordColumn column)
+{
+    auto& index = m_indexes[static_cast<size_t>(column)];
+    index.resize(size());
+    std::iota(index.begin(), index.end(), 0u);
+    visitColumn(
+        column,
+        [&](const auto& values)
+        { std::stable_sort(index.begin(), index.end(), [&](uint32_t a, uint32_t b) { return values[a] < values[b]; }); }
+    );
+}
+
+GameRecord RecordStore::get(uint32_t row) const
+{
+    GameRecord record;
+    record.wpm = m_wpm[row];
+    record.accuracy = m_accuracy[row];
+    record.survivalTime = m_survival[row];
+    record.date = m_date[row];
+    record.correctWords = m_correctWords[row];
+    record.missedWords = m_missedWords[row];
+    record.wrongAttempts = m_wrongAttempts[row];
+    record.seed = m_seed[row];
+    record.maxCombo = m_combo[row];
+    record.rawWpm = m_rawWpm[row];
+    record.speedCurve.assign(m_curveValues.begin() + m_curveStart[row], m_curveValues.begin() + m_curveStart[row + 1]);
+    return record;
+}
+
+GameRecord RecordStore::topRecord(RecordColumn column) const
+{
+    const auto& index = sortedIndex(column);
+    if (index.empty())
+        return GameRecord();
+
+    return visitColumn(
+        column,
+        [&](const auto& values)
+        {
+            const auto maxValue = values[index.back()];
+            if (!(maxValue > 0))
+                return GameRecord();
+
+            // Ties are ordered by row id, so the first maximum is the earliest game
+            auto first = std::partition_point(index.begin(), index.end(), [&](uint32_t row) { return values[row] < maxValue; });
+            return get(*first);
+        }
+    );
+}
+
+std::vector<uint32_t> RecordStore::query(const RecordQuery& query) const
+{
+    const size_t rowCount = size();
+    const auto& sortIndex = sortedIndex(query.sortColumn);
+    std::vector<uint32_t> result;
+
+    // Locate every bounded column inside its own index and keep the narrowest
+    std::vector<RecordColumn> filters;
+    RecordColumn driver = RecordColumn::Count;
+    IndexRange driverRange{0, rowCount};
+    for (size_t c = 0; c < kRecordColumnCount; ++c)
+    {
+        const auto& range = query.ranges[c];
+        if (!range.isBounded())
+            continue;
+
+        const auto column = static_cast<RecordColumn>(c);
+        filters.push_back(column);
+        IndexRange found = visitColumn(column, [&](const auto& values) { return findRange(values, sortedIndex(column), range); });
+        if (driver == RecordColumn::Count || found.count() < driverRange.count())
+        {
+            driver = column;
+            driverRange = found;
+        }
+    }
+
+    if (filters.empty())
+    {
+        result = sortIndex;
+        if (!query.ascending)
+            std::reverse(result.begin(), result.end());
+        return result;
+    }
+    if (driverRange.count() == 0)
+        return result;
+
+    auto matchesOthers = [&](uint32_t row)
+    {
+        for (RecordColumn column : filters)
+        {
+            if (column == driver)
+                continue;
+            const auto& range = query.ranges[static_cast<size_t>(column)];
+            const bool inside = visitColumn(column, [&](const auto& values) { return range.contains(static_cast<double>(values[row])); });
+            if (!inside)
+                return false;
+        }
+        return true;
+    };
+
+    if (driverRange.count() * kIndexScanDivisor < rowCount)
+    {
+        // Narrow driver: test the few candidates, then order them
+        const auto& driverIndex = sortedIndex(driver);
+        result.reserve(driverRange.count());
+        for (size_t i = driverRange.begin; i < driverRange.end; ++i)
+        {
+            if (matchesOthers(driverIndex[i]))
+                result.push_back(driverIndex[i]);
+        }
+
+        if (driver != query.sortColumn)
+        {
+            if (result.size() * kCandidateSortDivisor < rowCount)
+            {
+                visitColumn(
+                    query.sortColumn,
+                    [&](const auto& values)
+                    {
+                        std::sort(
+                            result.begin(),
+                            result.end(),
+                            [&](uint32_t a, uint32_t b) { return values[a] < values[b] || (!(values[b] < values[a]) && a < b); }
+                        );
+                    }
+                );
+            }
+            else
+            {
+                std::vector<uint8_t> flagged(rowCount, 0);
+                for (uint32_t row : result)
+                {
+                    flagged[row] = 1;
+                }
+                result.clear();
+                for (uint32_t row : sortIndex)
+                {
+                    if (flagged[row])
+                        result.push_back(row);
+                }
+            }
+        }
+        if (!query.ascending)
+            std::reverse(result.begin(), result.end());
+        return result;
+    }
+
+    // Wide selection: sequential pass per filtered column, then walk the sort index
+    std::vector<uint8_t> matches(rowCount, 1);
+    for (RecordColumn column : filters)
+    {
+        const auto& range = query.ranges[static_cast<size_t>(column)];
+        visitColumn(
+            column,
+            [&](const auto& values)
+            {
+                for (size_t row = 0; row < rowCount; ++row)
+                {
+                    const double value = static_cast<double>(values[row]);
+                    matches[row] &= static_cast<uint8_t>(value >= range.min && value <= range.max);
+                }
+            }
+        );
+    }
+
+    result.reserve(driverRange.count());
+    if (query.ascending)
+    {
+        for (uint32_t row : sortIndex)
+        {
+            if (matches[row])
+                result.push_back(row);
+        }
+    }
+    else
+    {
+        for (auto it = sortIndex.rbegin(); it != sortIndex.rend(); ++it)
+        {
+            if (matches[*it])
+                result.push_back(*it);
+        }
+    }
+    return result;
+}
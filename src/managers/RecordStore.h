@@ -0,0 +1,83 @@
+#pragma once
+
+#include "RecordQuery.h"
+#include "../models/GameRecord.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Column-oriented game history. Every sortable column keeps a permutation of
+// row ids ordered by value (ties by row id), so range filters resolve with a
+// binary search and sorted output is a walk over the index.
+class RecordStore
+{
+public:
+    size_t size() const { return m_wpm.size(); }
+    bool empty() const { return m_wpm.empty(); }
+
+    void clear();
+    // Keeps the indexes current, O(n) per column for the insertion
+    void append(const GameRecord& record);
+    // Appends everything, then rebuilds the indexes once
+    void appendBatch(const std::vector<GameRecord>& records);
+
+    GameRecord get(uint32_t row) const;
+    int wpm(uint32_t row) const { return m_wpm[row]; }
+    double accuracy(uint32_t row) const { return m_accuracy[row]; }
+    float survivalTime(uint32_t row) const { return m_survival[row]; }
+    int maxCombo(uint32_t row) const { return m_combo[row]; }
+    int64_t dateKeyAt(uint32_t row) const { return m_dateKey[row]; }
+    const std::string& date(uint32_t row) const { return m_date[row]; }
+    const std::vector<int>& wpmColumn() const { return m_wpm; }
+    // Earliest record holding the column maximum, default record if the maximum is not positive
+    GameRecord topRecord(RecordColumn column) const;
+
+    // Row ids ordered by the column value, ascending
+    const std::vector<uint32_t>& sortedIndex(RecordColumn column) const { return m_indexes[static_cast<size_t>(column)]; }
+
+    std::vector<uint32_t> query(const RecordQuery& query) const;
+
+private:
+    std::vector<int> m_wpm;
+    std::vector<double> m_accuracy;
+    std::vector<float> m_survival;
+    std::vector<int> m_combo;
+    std::vector<int64_t> m_dateKey;
+    std::vector<std::string> m_date;
+    std::vector<int> m_correctWords;
+    std::vector<int> m_missedWords;
+    std::vector<int> m_wrongAttempts;
+    std::vector<uint32_t> m_seed;
+    std::vector<int> m_rawWpm;
+    // Speed curves back to back; row r's runs from m_curveStart[r] to m_curveStart[r + 1]
+    std::vector<uint32_t> m_curveStart{0};
+    std::vector<uint16_t> m_curveValues;
+
+    std::array<std::vector<uint32_t>, kRecordColumnCount> m_indexes;
+
+    void pushColumns(const GameRecord& record);
+    void rebuildIndex(RecordColumn column);
+
+    // Calls fn with the typed value vector backing a sortable column
+    template <typename Fn>
+    decltype(auto) visitColumn(RecordColumn column, Fn&& fn) const
+    {
+        switch (column)
+        {
+        case RecordColumn::WPM:
+            return fn(m_wpm);
+        case RecordColumn::Accuracy:
+            return fn(m_accuracy);
+        case RecordColumn::Survival:
+            return fn(m_survival);
+        case RecordColumn::Combo:
+            return fn(m_combo);
+        case RecordColumn::Date:
+        case RecordColumn::Count:
+            break;
+        }
+        return fn(m_dateKey);
+    }
+};
@@ -0,0 +1,258 @@
+#include "StatsWorker.h"
+#include "../utils/Trace.h"
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace
+{
+std::string currentDate()
+{
+    const auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    std::tm timeInfo{};
+#ifdef _WIN32
+    localtime_s(&timeInfo, &now);
+#else
+    localtime_r(&now, &timeInfo);
+#endif
+    std::ostringstream oss;
+    oss << std::put_time(&timeInfo, "%Y-%m-%d");
+    return oss.str();
+}
+} // namespace
+
+StatsWorker::StatsWorker(RecordManager& recordManager) : m_recordManager(recordManager) {}
+
+StatsWorker::~StatsWorker()
+{
+    stop();
+}
+
+void StatsWorker::start()
+{
+    std::lock_guard lock(m_mutex);
+    if (m_running)
+        return;
+
+    m_running = true;
+    m_thread = std::thread([this] { run(); });
+}
+
+void StatsWorker::stop()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_running = false;
+    }
+    m_wakeup.notify_all();
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+void StatsWorker::notifyRecordsChanged()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_recordsDirty = true;
+    }
+    m_wakeup.notify_one();
+}
+
+uint64_t StatsWorker::requestQuery(const RecordQuery& query)
+{
+    uint64_t generation = 0;
+    {
+        std::lock_guard lock(m_mutex);
+        m_pendingQuery = query;
+        m_queryDirty = true;
+        generation = ++m_queryGeneration;
+    }
+    m_wakeup.notify_one();
+    return generation;
+}
+
+void StatsWorker::requestOlderMonth()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_loadOlder = true;
+    }
+    m_wakeup.notify_one();
+}
+
+void StatsWorker::requestMonthsFrom(const std::string& month)
+{
+    {
+        std::lock_guard lock(m_mutex);
+        if (!m_loadFromMonth || month < *m_loadFromMonth)
+        {
+            m_loadFromMonth = month;
+        }
+    }
+    m_wakeup.notify_one();
+}
+
+void StatsWorker::setPublishCallback(std::function<void()> callback)
+{
+    std::lock_guard lock(m_mutex);
+    m_publishCallback = std::move(callback);
+}
+
+void StatsWorker::run()
+{
+    trace::setThreadName("stats worker");
+    while (true)
+    {
+        bool recordsDirty = false;
+        bool loadOlder = false;
+        std::optional<std::string> loadFromMonth;
+        RecordQuery query;
+        uint64_t generation = 0;
+        std::function<void()> publishCallback;
+        {
+            std::unique_lock lock(m_mutex);
+            m_wakeup.wait(lock, [this] { return !m_running || m_recordsDirty || m_queryDirty || m_loadOlder || m_loadFromMonth.has_value(); });
+            if (!m_running)
+                return;
+
+            loadOlder = m_loadOlder;
+            loadFromMonth = std::move(m_loadFromMonth);
+            m_loadOlder = false;
+            m_loadFromMonth.reset();
+        }
+
+        // Shard reads happen outside the lock; the change listener marks the
+        // records dirty again, which is picked up just below
+        if (loadFromMonth)
+        {
+            m_recordManager.loadMonthsFrom(*loadFromMonth);
+        }
+        else if (loadOlder)
+        {
+            m_recordManager.loadOlderMonth();
+        }
+
+        {
+            std::lock_guard lock(m_mutex);
+            if (!m_running)
+                return;
+
+            recordsDirty = m_recordsDirty;
+            query = m_pendingQuery;
+            generation = m_queryGeneration;
+            m_recordsDirty = false;
+            m_queryDirty = false;
+            publishCallback = m_publishCallback;
+        }
+
+        TYPEIT_TRACE_SCOPE("StatsWorker::recompute");
+        // Start from the previous view so a query-only change keeps the aggregates
+        auto previous = m_view.load();
+        auto next = previous ? std::make_shared<StatsView>(*previous) : std::make_shared<StatsView>();
+
+        if (recordsDirty || !previous)
+        {
+            computeRollupSummary(*next);
+        }
+        m_recordManager.readStore(
+            [&](const RecordStore& store)
+            {
+                if (recordsDirty || !previous)
+                {
+                    next->recordsVersion = m_recordManager.getVersion();
+                    computeAggregates(store, *next);
+                }
+
+                const auto queryStart = std::chrono::steady_clock::now();
+                next->rows = store.query(query);
+                next->queryMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - queryStart).count();
+            }
+        );
+        next->query = query;
+        next->queryGeneration = generation;
+
+        m_view.store(std::move(next));
+        if (publishCallback)
+        {
+            publishCallback();
+        }
+    }
+}
+
+void StatsWorker::computeRollupSummary(StatsView& view) const
+{
+    view.shards = m_recordManager.getShardStatus();
+    const std::string today = currentDate();
+    m_recordManager.readRollups(
+        [&](const RecordRollups& rollups)
+        {
+            view.allTimeGames = rollups.totalGames();
+            view.allTimeBestWpm = rollups.bestWpm();
+            view.today = rollups.bucketFor(RollupPeriod::Day, today);
+            view.thisWeek = rollups.bucketFor(RollupPeriod::Week, today);
+            view.thisMonth = rollups.bucketFor(RollupPeriod::Month, today);
+        }
+    );
+}
+
+void StatsWorker::computeAggregates(const RecordStore& store, StatsView& view) const
+{
+    view.recordCount = store.size();
+    view.bestRecord = store.topRecord(RecordColumn::WPM);
+    view.longestRecord = store.topRecord(RecordColumn::Survival);
+    view.trendWpm.clear();
+    view.movingAverage.clear();
+
+    const auto& wpm = store.wpmColumn();
+    const size_t count = wpm.size();
+    if (count == 0)
+        return;
+
+    // Long histories are averaged into buckets so the chart stays a fixed size
+    const size_t bucketSize = (count + kMaxTrendPoints - 1) / kMaxTrendPoints;
+    view.trendWpm.reserve(count / bucketSize + 1);
+    view.movingAverage.reserve(count / bucketSize + 1);
+
+    double windowSum = 0.0;
+    double bucketSum = 0.0;
+    size_t bucketFill = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        windowSum += wpm[i];
+        if (i >= static_cast<size_t>(kMovingAverageWindow))
+        {
+            windowSum -= wpm[i - kMovingAverageWindow];
+        }
+
+        bucketSum += wpm[i];
+        ++bucketFill;
+        if (bucketFill == bucketSize || i + 1 == count)
+        {
+            const size_t divisor = std::min(static_cast<size_t>(kMovingAverageWindow), i + 1);
+            view.trendWpm.push_back(bucketSum / static_cast<double>(bucketFill));
+            view.movingAverage.push_back(windowSum / static_cast<double>(divisor));
+            bucketSum = 0.0;
+            bucketFill = 0;
+        }
+    }
+
+    double minWPM = std::numeric_limits<double>::max();
+    double maxWPM = std::numeric_limits<double>::lowest();
+    for (double value : view.trendWpm)
+    {
+        minWPM = std::min(minWPM, value);
+        maxWPM = std::max(maxWPM, value);
+    }
+    if (maxWPM - minWPM < 5.0)
+    {
+        maxWPM += 5.0;
+        minWPM = std::max(0.0, maxWPM - 20.0);
+    }
+    view.trendMin = minWPM;
+    view.trendMax = maxWPM;
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "RecordManager.h"
+#include "RecordQuery.h"
+#include "RecordRollups.h"
+#include "../models/GameRecord.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Everything the Stats screen shows, computed off the UI thread. Instances are
+// immutable once published.
+struct StatsView
+{
+    uint64_t recordsVersion = 0;
+    size_t recordCount = 0;
+    GameRecord bestRecord;
+    GameRecord longestRecord;
+
+    // Whole-history figures from the rollups, valid with shards unloaded
+    ShardStatus shards;
+    int allTimeGames = 0;
+    int allTimeBestWpm = 0;
+    RollupBucket today;
+    RollupBucket thisWeek;
+    RollupBucket thisMonth;
+
+    // WPM trend over the loaded games, bucket-averaged down to StatsWorker::kMaxTrendPoints
+    std::vector<double> trendWpm;
+    std::vector<double> movingAverage;
+    double trendMin = 0.0; // Axis range, already padded for display
+    double trendMax = 0.0;
+
+    // Result of the latest table query
+    uint64_t queryGeneration = 0;
+    RecordQuery query;
+    std::vector<uint32_t> rows;
+    double queryMs = 0.0;
+};
+
+// Background thread that recomputes StatsView whenever the records or the
+// requested table query change, and publishes it by swapping a shared_ptr.
+// Shard loads requested by the UI run here too, before the next query.
+class StatsWorker
+{
+public:
+    static constexpr int kMovingAverageWindow = 50;
+    static constexpr size_t kMaxTrendPoints = 240;
+
+    explicit StatsWorker(RecordManager& recordManager);
+    ~StatsWorker();
+
+    void start();
+    void stop();
+
+    void notifyRecordsChanged();
+    // Returns the generation the published view will carry once the query ran
+    uint64_t requestQuery(const RecordQuery& query);
+    // Loads the newest month that is not in memory yet
+    void requestOlderMonth();
+    // Loads every month from "YYYY-MM" onwards, an empty month loads everything
+    void requestMonthsFrom(const std::string& month);
+
+    // Null until the first view has been computed
+    std::shared_ptr<const StatsView> getView() const { return m_view.load(); }
+    // Invoked on the worker thread after each publish, e.g. to request a redraw
+    void setPublishCallback(std::function<void()> callback);
+
+private:
+    RecordManager& m_recordManager;
+    std::atomic<std::shared_ptr<const StatsView>> m_view;
+
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    bool m_running = false;
+    bool m_recordsDirty = true;
+    bool m_queryDirty = false;
+    RecordQuery m_pendingQuery;
+    uint64_t m_queryGeneration = 0;
+    bool m_loadOlder = false;
+    std::optional<std::string> m_loadFromMonth;
+    std::function<void()> m_publishCallback;
+
+    void run();
+    void computeAggregates(const RecordStore& store, StatsView& view) const;
+    void computeRollupSummary(StatsView& view) const;
+};
@@ -46,6 +46,15 @@ Word WordManager::getRandomWord() {
     return m_words[dist(m_gen)];
 }
 
+Word WordManager::getRandomWord(GameRng& gen) const {
+    if (m_words.empty()) {
+        return Word("ERROR", "No words loaded");
+    }
+    
+    std::uniform_int_distribution<size_t> dist(0, m_words.size() - 1);
+    return m_words[dist(gen)];
+}
+
 void WordManager::updateDistribution() {
     // Distribution is created in getRandomWord()
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../models/Word.h"
+#include "../utils/GameRng.h"
 #include <vector>
 #include <random>
 #include <string>
@@ -11,6 +12,9 @@ public:
     
     bool loadFromFile(const std::string& filepath);
     Word getRandomWord();
+    // Draws from the caller's generator; safe to call from several threads
+    // once loading has finished
+    Word getRandomWord(GameRng& gen) const;
     size_t getWordCount() const { return m_words.size(); }
     bool isEmpty() const { return m_words.empty(); }
     
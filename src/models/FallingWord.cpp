@@ -6,27 +6,23 @@
 FallingWord::FallingWord(const Word& word, float y, float teleportInterval)
     : word(word), x(0.0f), y(y),
       lifeProgress(0.0f), isActive(true),
-      spawnTime(std::chrono::steady_clock::now()),
-      lastTeleportTime(std::chrono::steady_clock::now()),
+      age(0.0f), sinceTeleport(0.0f),
       teleportInterval(teleportInterval),
       teleportCount(0) {
 }
 
-void FallingWord::update(float deltaTime, int screenWidth) {
-    (void)deltaTime; // Not used for teleport-style movement
+void FallingWord::update(float deltaTime, int screenWidth, float teleportStepRatio) {
     if (!isActive) return;
     
-    const auto& cfg = ConfigManager::instance().settings();
-    
-    auto now = std::chrono::steady_clock::now();
-    float timeSinceLastTeleport = std::chrono::duration<float>(now - lastTeleportTime).count();
+    age += deltaTime;
+    sinceTeleport += deltaTime;
     
     // Check if it's time to teleport
-    if (timeSinceLastTeleport >= teleportInterval) {
+    if (sinceTeleport >= teleportInterval) {
         // Teleport to next position
-        float stepSize = static_cast<float>(screenWidth) * cfg.teleportStepRatio;
+        float stepSize = static_cast<float>(screenWidth) * teleportStepRatio;
         x += stepSize;
-        lastTeleportTime = now;
+        sinceTeleport = 0.0f;
         teleportCount++;
     }
     
@@ -44,9 +40,7 @@ bool FallingWord::isVisible(int screenWidth) const {
     return isActive && x >= 0 && x < screenWidth;
 }
 
-FallingWord::ColorRGB FallingWord::getCurrentColor() const {
-    const auto& cfg = ConfigManager::instance().settings();
-    
+FallingWord::ColorRGB FallingWord::gradientColor(float lifeProgress, const GameSettings& cfg) {
     if (lifeProgress < cfg.colorWhiteThreshold) {
         // White phase
         return {255, 255, 255};
@@ -1,11 +1,9 @@
 #pragma once
 
 #include "Word.h"
-#include <chrono>
+#include <cstdint>
 
-namespace ftxui {
-    class Color;
-}
+struct GameSettings;
 
 class FallingWord {
 public:
@@ -13,21 +11,25 @@ public:
     float x, y;
     float lifeProgress;  // 0.0 (just spawned) -> 1.0 (about to disappear)
     bool isActive;
-    std::chrono::steady_clock::time_point spawnTime;
-    std::chrono::steady_clock::time_point lastTeleportTime;
+    // Game time, advanced only by update(), so a word behaves the same in a
+    // live game, a paused one and a headless simulation
+    float age;               // Seconds since spawn
+    float sinceTeleport;     // Seconds since the last teleport
     float teleportInterval;  // Current teleport interval for this word
     int teleportCount;       // Number of teleports done
-    
+    uint32_t id = 0;         // Spawn order within a game, stable while the word lives
+
     FallingWord() = default;
     FallingWord(const Word& word, float y, float teleportInterval);
     
-    void update(float deltaTime, int screenWidth);
+    void update(float deltaTime, int screenWidth, float teleportStepRatio);
     bool isVisible(int screenWidth) const;
     
     // Returns RGB values (0-255)
     struct ColorRGB {
         int r, g, b;
     };
-    ColorRGB getCurrentColor() const;
+    // Colour of a word at the given life progress under the settings' thresholds
+    static ColorRGB gradientColor(float lifeProgress, const GameSettings& settings);
 };
 
@@ -12,7 +12,14 @@ std::string GameRecord::toCSVLine() const {
         << correctWords << ","
         << missedWords << ","
         << wrongAttempts << ","
-        << maxCombo;
+        << maxCombo << ","
+        << seed << ","
+        << rawWpm << ",";
+    // 速度曲线用分号分隔，整条记录仍是一行
+    for (size_t i = 0; i < speedCurve.size(); ++i) {
+        if (i > 0) oss << ";";
+        oss << speedCurve[i];
+    }
     return oss.str();
 }
 
@@ -36,6 +43,21 @@ GameRecord GameRecord::fromCSVLine(const std::string& line) {
         record.wrongAttempts = std::stoi(tokens[6]);
         record.maxCombo = std::stoi(tokens[7]);
     }
+    if (tokens.size() >= 9) {
+        record.seed = static_cast<uint32_t>(std::stoul(tokens[8]));
+    }
+    if (tokens.size() >= 10) {
+        record.rawWpm = std::stoi(tokens[9]);
+    }
+    if (tokens.size() >= 11) {
+        std::istringstream curve(tokens[10]);
+        std::string value;
+        while (std::getline(curve, value, ';')) {
+            if (!value.empty()) {
+                record.speedCurve.push_back(static_cast<uint16_t>(std::stoul(value)));
+            }
+        }
+    }
     
     return record;
 }
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <vector>
 
 class GameRecord
 {
@@ -13,6 +15,9 @@ public:
     int missedWords = 0;
     int wrongAttempts = 0;
     int maxCombo = 0;
+    uint32_t seed = 0; // Game seed, links the record to its input log; 0 for games recorded before logs existed
+    int rawWpm = 0; // Every character typed, hit or not; 0 for older games
+    std::vector<uint16_t> speedCurve; // Net WPM of every TypingSpeed::kIntervalSeconds of the game; empty for older games
 
     GameRecord() = default;
 
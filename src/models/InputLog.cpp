@@ -0,0 +1,179 @@
+#include "InputLog.h"
+#include "../utils/Varint.h"
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <utility>
+
+namespace
+{
+constexpr std::string_view kMagic = "TIL";
+constexpr uint32_t kTypeBits = 2;
+} // namespace
+
+void InputLog::clear()
+{
+    seed = 0;
+    tickRate = 60;
+    settingsFingerprint = 0;
+    totalTicks = 0;
+    events.clear();
+}
+
+void InputLog::addChar(uint32_t tick, char letter)
+{
+    InputEvent event;
+    event.tick = tick;
+    event.type = InputEvent::Type::Char;
+    event.letter = letter;
+    events.push_back(event);
+}
+
+void InputLog::addBackspace(uint32_t tick)
+{
+    InputEvent event;
+    event.tick = tick;
+    event.type = InputEvent::Type::Backspace;
+    events.push_back(event);
+}
+
+void InputLog::addSpace(uint32_t tick)
+{
+    InputEvent event;
+    event.tick = tick;
+    event.type = InputEvent::Type::Space;
+    events.push_back(event);
+}
+
+void InputLog::addResize(uint32_t tick, int width, int height)
+{
+    InputEvent event;
+    event.tick = tick;
+    event.type = InputEvent::Type::Resize;
+    event.width = static_cast<uint16_t>(width);
+    event.height = static_cast<uint16_t>(height);
+    events.push_back(event);
+}
+
+std::string InputLog::encode() const
+{
+    std::string out(kMagic);
+    varint::put(out, kVersion);
+    varint::put(out, seed);
+    varint::put(out, tickRate);
+    for (int i = 0; i < 8; ++i)
+    {
+        out.push_back(static_cast<char>(settingsFingerprint >> (8 * i)));
+    }
+    varint::put(out, totalTicks);
+    varint::put(out, events.size());
+
+    uint32_t previousTick = 0;
+    for (const auto& event : events)
+    {
+        // Events are recorded in tick order, so the delta is never negative
+        const uint64_t delta = event.tick - previousTick;
+        previousTick = event.tick;
+        varint::put(out, (delta << kTypeBits) | static_cast<uint64_t>(event.type));
+        if (event.type == InputEvent::Type::Char)
+        {
+            out.push_back(event.letter);
+        }
+        else if (event.type == InputEvent::Type::Resize)
+        {
+            varint::put(out, event.width);
+            varint::put(out, event.height);
+        }
+    }
+    return out;
+}
+
+bool InputLog::decode(std::string_view data)
+{
+    clear();
+    if (data.substr(0, kMagic.size()) != kMagic)
+        return false;
+    data.remove_prefix(kMagic.size());
+
+    uint64_t version = 0, seedValue = 0, rate = 0;
+    if (!varint::get(data, version) || version != kVersion || !varint::get(data, seedValue) || !varint::get(data, rate) || data.size() < 8)
+        return false;
+    uint64_t fingerprint = 0;
+    for (int i = 0; i < 8; ++i)
+    {
+        fingerprint |= static_cast<uint64_t>(static_cast<uint8_t>(data[i])) << (8 * i);
+    }
+    data.remove_prefix(8);
+
+    uint64_t ticks = 0, count = 0;
+    // Every event takes at least one byte, which bounds a corrupt count
+    if (!varint::get(data, ticks) || !varint::get(data, count) || count > data.size())
+        return false;
+
+    std::vector<InputEvent> decoded;
+    decoded.reserve(count);
+    uint64_t tick = 0;
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        uint64_t header = 0;
+        if (!varint::get(data, header))
+            return false;
+
+        InputEvent event;
+        tick += header >> kTypeBits;
+        event.tick = static_cast<uint32_t>(tick);
+        event.type = static_cast<InputEvent::Type>(header & ((1u << kTypeBits) - 1));
+        if (event.type == InputEvent::Type::Char)
+        {
+            if (data.empty())
+                return false;
+            event.letter = data.front();
+            data.remove_prefix(1);
+        }
+        else if (event.type == InputEvent::Type::Resize)
+        {
+            uint64_t width = 0, height = 0;
+            if (!varint::get(data, width) || !varint::get(data, height))
+                return false;
+            event.width = static_cast<uint16_t>(width);
+            event.height = static_cast<uint16_t>(height);
+        }
+        decoded.push_back(event);
+    }
+
+    seed = static_cast<uint32_t>(seedValue);
+    tickRate = static_cast<uint32_t>(rate);
+    settingsFingerprint = fingerprint;
+    totalTicks = static_cast<uint32_t>(ticks);
+    events = std::move(decoded);
+    return true;
+}
+
+bool InputLog::saveToFile(const std::string& path) const
+{
+    std::error_code ec;
+    const std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty())
+    {
+        std::filesystem::create_directories(parent, ec);
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+        return false;
+    const std::string data = encode();
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(file);
+}
+
+bool InputLog::loadFromFile(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+    {
+        clear();
+        return false;
+    }
+    const std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return decode(data);
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Everything the local player fed into a game, tagged with the fixed engine
+// tick it was applied before. Together with the seed and settings this
+// replays the game exactly (see GhostRunner).
+//
+// File layout: "TIL" and varints for version, seed, tick rate, settings
+// fingerprint (8 raw bytes), total ticks and event count. Each event is
+// varint((tick delta << 2) | type) followed by the letter for Char or a
+// width/height varint pair for Resize. Most keystrokes take two bytes.
+struct InputEvent
+{
+    enum class Type : uint8_t
+    {
+        Char = 0,
+        Backspace = 1,
+        Space = 2,
+        Resize = 3, // The visible board changed size
+    };
+
+    uint32_t tick = 0; // Engine updates done before this event was applied
+    Type type = Type::Char;
+    char letter = 0;
+    uint16_t width = 0;
+    uint16_t height = 0;
+};
+
+class InputLog
+{
+public:
+    static constexpr uint32_t kVersion = 1;
+
+    uint32_t seed = 0;
+    uint32_t tickRate = 60;
+    uint64_t settingsFingerprint = 0;
+    uint32_t totalTicks = 0; // Length of the game in ticks
+    std::vector<InputEvent> events;
+
+    void clear();
+    void addChar(uint32_t tick, char letter);
+    void addBackspace(uint32_t tick);
+    void addSpace(uint32_t tick);
+    void addResize(uint32_t tick, int width, int height);
+
+    std::string encode() const;
+    // Returns false (leaving the log cleared) for a foreign or damaged blob
+    bool decode(std::string_view data);
+
+    bool saveToFile(const std::string& path) const;
+    bool loadFromFile(const std::string& path);
+};
@@ -0,0 +1,315 @@
+#include "KeystrokeLog.h"
+#include "../utils/Varint.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+
+namespace
+{
+constexpr std::string_view kMagic = "TKS";
+constexpr size_t kBlockSize = 128;
+constexpr uint32_t kBackspaceCode = 26;
+constexpr uint32_t kSubmitCode = 27;
+
+uint32_t keyCode(char key)
+{
+    if (key == '\b')
+        return kBackspaceCode;
+    if (key == ' ')
+        return kSubmitCode;
+    return static_cast<uint32_t>(key - 'a');
+}
+
+char keyOf(uint32_t code)
+{
+    if (code == kBackspaceCode)
+        return '\b';
+    if (code == kSubmitCode)
+        return ' ';
+    return static_cast<char>('a' + code);
+}
+
+int bitWidth(uint32_t value)
+{
+    int width = 0;
+    while (value != 0)
+    {
+        ++width;
+        value >>= 1;
+    }
+    return width;
+}
+
+// Each block of up to kBlockSize values: one width byte, then the values
+// packed LSB first in that many bits
+void packColumn(std::string& out, const std::vector<uint32_t>& values)
+{
+    for (size_t start = 0; start < values.size(); start += kBlockSize)
+    {
+        const size_t end = std::min(values.size(), start + kBlockSize);
+        uint32_t all = 0;
+        for (size_t i = start; i < end; ++i)
+        {
+            all |= values[i];
+        }
+        const int width = bitWidth(all);
+        out.push_back(static_cast<char>(width));
+
+        uint64_t buffer = 0;
+        int buffered = 0;
+        for (size_t i = start; i < end; ++i)
+        {
+            buffer |= static_cast<uint64_t>(values[i]) << buffered;
+            buffered += width;
+            while (buffered >= 8)
+            {
+                out.push_back(static_cast<char>(buffer & 0xff));
+                buffer >>= 8;
+                buffered -= 8;
+            }
+        }
+        if (buffered > 0)
+        {
+            out.push_back(static_cast<char>(buffer & 0xff));
+        }
+    }
+}
+
+bool unpackColumn(std::string_view& in, size_t count, std::vector<uint32_t>& values)
+{
+    values.clear();
+    values.reserve(count);
+    while (values.size() < count)
+    {
+        if (in.empty())
+            return false;
+        const int width = static_cast<uint8_t>(in.front());
+        in.remove_prefix(1);
+        if (width > 32)
+            return false;
+
+        const size_t blockCount = std::min(kBlockSize, count - values.size());
+        const size_t bytes = (blockCount * static_cast<size_t>(width) + 7) / 8;
+        if (in.size() < bytes)
+            return false;
+
+        uint64_t buffer = 0;
+        int buffered = 0;
+        size_t next = 0;
+        const uint64_t mask = width == 32 ? 0xffffffffull : (1ull << width) - 1;
+        for (size_t i = 0; i < blockCount; ++i)
+        {
+            while (buffered < width)
+            {
+                buffer |= static_cast<uint64_t>(static_cast<uint8_t>(in[next++])) << buffered;
+                buffered += 8;
+            }
+            values.push_back(static_cast<uint32_t>(buffer & mask));
+            buffer = width == 0 ? buffer : buffer >> width;
+            buffered -= width;
+        }
+        in.remove_prefix(bytes);
+    }
+    return true;
+}
+
+uint32_t zigzag32(int64_t value)
+{
+    return static_cast<uint32_t>(varint::zigzag(value));
+}
+} // namespace
+
+KeystrokeLog::KeystrokeLog(size_t capacity) : m_ring(std::max<size_t>(1, capacity)), m_words(std::max<size_t>(1, capacity / 4)) {}
+
+void KeystrokeLog::begin(uint32_t seed)
+{
+    m_count = 0;
+    m_droppedEarlier = 0;
+    m_seed = seed;
+    m_currentWord = Keystroke::kNoWord;
+    std::fill(m_words.begin(), m_words.end(), WordSlot{});
+    m_origin = Clock::now();
+}
+
+void KeystrokeLog::record(char key, bool correct, uint32_t wordId, std::string_view text, Clock::time_point at)
+{
+    if (!text.empty() && wordId != m_currentWord)
+    {
+        m_currentWord = wordId;
+        storeWord(wordId, text);
+    }
+
+    Keystroke& keystroke = m_ring[m_count % m_ring.size()];
+    // A key pressed just before begin() counts as the first millisecond
+    keystroke.timeMs = static_cast<uint32_t>(std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::milliseconds>(at - m_origin).count()));
+    keystroke.wordId = m_currentWord;
+    keystroke.key = key;
+    keystroke.correct = correct;
+    ++m_count;
+}
+
+void KeystrokeLog::storeWord(uint32_t wordId, std::string_view text)
+{
+    WordSlot& slot = m_words[wordId % m_words.size()];
+    slot.id = wordId;
+    slot.length = static_cast<uint8_t>(std::min(text.size(), kMaxWordLength));
+    std::copy_n(text.begin(), slot.length, slot.text.begin());
+}
+
+std::vector<Keystroke> KeystrokeLog::keystrokes() const
+{
+    std::vector<Keystroke> result;
+    result.reserve(size());
+    for (uint64_t i = m_count - size(); i < m_count; ++i)
+    {
+        result.push_back(m_ring[i % m_ring.size()]);
+    }
+    return result;
+}
+
+std::string_view KeystrokeLog::wordText(uint32_t wordId) const
+{
+    const WordSlot& slot = m_words[wordId % m_words.size()];
+    if (wordId == Keystroke::kNoWord || slot.id != wordId)
+        return {};
+    return std::string_view(slot.text.data(), slot.length);
+}
+
+std::string KeystrokeLog::encode() const
+{
+    const std::vector<Keystroke> strokes = keystrokes();
+
+    // Words in order of first use; the word column refers to them by index
+    std::vector<uint32_t> dictionary;
+    std::unordered_map<uint32_t, uint32_t> indexOf;
+    std::vector<uint32_t> times, keys, correct, words;
+    times.reserve(strokes.size());
+    keys.reserve(strokes.size());
+    correct.reserve(strokes.size());
+    words.reserve(strokes.size());
+
+    uint32_t previousTime = 0;
+    int64_t previousWord = 0;
+    for (const auto& keystroke : strokes)
+    {
+        auto [it, added] = indexOf.try_emplace(keystroke.wordId, static_cast<uint32_t>(dictionary.size()));
+        if (added)
+        {
+            dictionary.push_back(keystroke.wordId);
+        }
+
+        // Times never go backwards; the word index mostly repeats or moves on by one
+        times.push_back(keystroke.timeMs - previousTime);
+        previousTime = keystroke.timeMs;
+        keys.push_back(keyCode(keystroke.key));
+        correct.push_back(keystroke.correct ? 1 : 0);
+        words.push_back(zigzag32(static_cast<int64_t>(it->second) - previousWord));
+        previousWord = it->second;
+    }
+
+    std::string out(kMagic);
+    varint::put(out, kVersion);
+    varint::put(out, m_seed);
+    varint::put(out, strokes.size());
+    varint::put(out, dropped());
+    varint::put(out, dictionary.size());
+    for (uint32_t wordId : dictionary)
+    {
+        // Ids shifted by one so "no word" is zero
+        varint::put(out, wordId == Keystroke::kNoWord ? 0 : static_cast<uint64_t>(wordId) + 1);
+        varint::putString(out, wordText(wordId));
+    }
+    packColumn(out, times);
+    packColumn(out, keys);
+    packColumn(out, correct);
+    packColumn(out, words);
+    return out;
+}
+
+bool KeystrokeLog::decode(std::string_view data)
+{
+    begin(0);
+    if (data.substr(0, kMagic.size()) != kMagic)
+        return false;
+    data.remove_prefix(kMagic.size());
+
+    // Every block costs each column at least its width byte, which bounds a corrupt count
+    uint64_t version = 0, seed = 0, count = 0, droppedCount = 0, dictionarySize = 0;
+    if (!varint::get(data, version) || version != kVersion || !varint::get(data, seed) || !varint::get(data, count) ||
+        !varint::get(data, droppedCount) || !varint::get(data, dictionarySize) || dictionarySize > data.size() ||
+        count > data.size() * kBlockSize / 4)
+        return false;
+
+    std::vector<uint32_t> dictionary;
+    dictionary.reserve(dictionarySize);
+    for (uint64_t i = 0; i < dictionarySize; ++i)
+    {
+        uint64_t shiftedId = 0;
+        std::string text;
+        if (!varint::get(data, shiftedId) || !varint::getString(data, text))
+            return false;
+        const uint32_t wordId = shiftedId == 0 ? Keystroke::kNoWord : static_cast<uint32_t>(shiftedId - 1);
+        dictionary.push_back(wordId);
+        if (!text.empty())
+        {
+            storeWord(wordId, text);
+        }
+    }
+
+    std::vector<uint32_t> times, keys, correct, words;
+    if (!unpackColumn(data, count, times) || !unpackColumn(data, count, keys) || !unpackColumn(data, count, correct) ||
+        !unpackColumn(data, count, words) || !data.empty())
+    {
+        begin(0);
+        return false;
+    }
+
+    // Only the newest keystrokes fit when the file came from a bigger ring
+    const uint64_t skip = count > m_ring.size() ? count - m_ring.size() : 0;
+    uint32_t time = 0;
+    int64_t word = 0;
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        time += times[i];
+        word += varint::unzigzag(words[i]);
+        if (keys[i] > kSubmitCode || word < 0 || static_cast<uint64_t>(word) >= dictionary.size())
+        {
+            begin(0);
+            return false;
+        }
+        if (i < skip)
+            continue;
+
+        Keystroke& keystroke = m_ring[i - skip];
+        keystroke.timeMs = time;
+        keystroke.key = keyOf(keys[i]);
+        keystroke.correct = correct[i] != 0;
+        keystroke.wordId = dictionary[static_cast<size_t>(word)];
+    }
+
+    m_seed = static_cast<uint32_t>(seed);
+    m_count = count - skip;
+    m_droppedEarlier = droppedCount + skip;
+    m_currentWord = count > 0 ? dictionary[static_cast<size_t>(word)] : Keystroke::kNoWord;
+    // New keystrokes continue the decoded timeline
+    m_origin = Clock::now() - std::chrono::milliseconds(time);
+    return true;
+}
+
+bool KeystrokeLog::saveToFile(const std::string& path) const
+{
+    std::error_code ec;
+    const std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty())
+    {
+        std::filesystem::create_directories(parent, ec);
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+        return false;
+    const std::string data = encode();
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// One key the player pressed during a game
+struct Keystroke
+{
+    uint32_t timeMs = 0;  // Since the game started
+    uint32_t wordId = 0;  // Word being typed, FallingWord::id; kNoWord before any
+    char key = 0;         // 'a'-'z', '\b' for backspace, ' ' for submit
+    bool correct = false; // Input is still a prefix of a word on screen (submit: a word was hit)
+
+    static constexpr uint32_t kNoWord = UINT32_MAX;
+};
+
+// Per-keystroke telemetry of the current game. record() runs on the input
+// path, so everything it touches is allocated up front: keystrokes go into a
+// fixed ring (the oldest are overwritten in very long games) and the text of
+// each word typed into a fixed table of short slots.
+//
+// encode() writes the columnar session file: a word dictionary, then one
+// column each for time, key, correctness and word. Every column is delta
+// coded where that helps and bit-packed in blocks of 128 values, each block
+// carrying its own bit width, so a typical keystroke costs about two bytes.
+class KeystrokeLog
+{
+public:
+    static constexpr size_t kDefaultCapacity = 1 << 15;
+    static constexpr size_t kMaxWordLength = 31;
+    static constexpr uint32_t kVersion = 1;
+
+    explicit KeystrokeLog(size_t capacity = kDefaultCapacity);
+
+    // Starts a new game; timestamps count from here
+    void begin(uint32_t seed);
+    using Clock = std::chrono::steady_clock;
+
+    // text is the word being typed, empty to keep the previous one. at is when
+    // the key was pressed, which can be a little before it is recorded.
+    void record(char key, bool correct, uint32_t wordId, std::string_view text, Clock::time_point at = Clock::now());
+
+    uint32_t seed() const { return m_seed; }
+    size_t size() const { return m_count < m_ring.size() ? m_count : m_ring.size(); }
+    // Keystrokes overwritten because the ring was full
+    uint64_t dropped() const { return m_droppedEarlier + (m_count - size()); }
+    // Oldest first
+    std::vector<Keystroke> keystrokes() const;
+    // Text of a recorded word, empty when unknown
+    std::string_view wordText(uint32_t wordId) const;
+
+    std::string encode() const;
+    // Replaces the contents with a decoded session; later record() calls
+    // continue its timeline. Returns false (log emptied) for a damaged blob.
+    bool decode(std::string_view data);
+    bool saveToFile(const std::string& path) const;
+
+private:
+    struct WordSlot
+    {
+        uint32_t id = Keystroke::kNoWord;
+        uint8_t length = 0;
+        std::array<char, kMaxWordLength> text{};
+    };
+
+    std::vector<Keystroke> m_ring;
+    std::vector<WordSlot> m_words; // Indexed by id modulo size
+    uint64_t m_count = 0;
+    uint64_t m_droppedEarlier = 0; // Dropped before the session was decoded
+    uint32_t m_seed = 0;
+    uint32_t m_currentWord = Keystroke::kNoWord;
+    Clock::time_point m_origin;
+
+    void storeWord(uint32_t wordId, std::string_view text);
+};
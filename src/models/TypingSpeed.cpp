@@ -0,0 +1,93 @@
+#include "TypingSpeed.h"
+#include "../utils/Varint.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+TypingSpeed::TypingSpeed()
+{
+    m_intervalChars.reserve(kReservedIntervals);
+}
+
+void TypingSpeed::reset()
+{
+    m_typed = 0;
+    m_correct = 0;
+    m_intervalChars.clear();
+}
+
+void TypingSpeed::addWord(float seconds, size_t length)
+{
+    const size_t chars = length + 1;
+    m_correct += static_cast<uint32_t>(chars);
+    addToInterval(seconds, chars);
+}
+
+void TypingSpeed::addToInterval(float seconds, size_t chars)
+{
+    const size_t interval = static_cast<size_t>(std::max(0.0f, seconds) / kIntervalSeconds);
+    if (interval >= m_intervalChars.size())
+    {
+        m_intervalChars.resize(interval + 1, 0);
+    }
+    uint16_t& count = m_intervalChars[interval];
+    count = static_cast<uint16_t>(std::min<size_t>(count + chars, std::numeric_limits<uint16_t>::max()));
+}
+
+double TypingSpeed::wpm(uint32_t chars, float seconds)
+{
+    if (seconds <= 0.0f)
+        return 0.0;
+    return (chars / 5.0) / (seconds / 60.0);
+}
+
+std::vector<uint16_t> TypingSpeed::curve(float seconds) const
+{
+    std::vector<uint16_t> result;
+    if (seconds <= 0.0f)
+        return result;
+
+    const auto intervals = static_cast<size_t>(std::ceil(seconds / kIntervalSeconds));
+    result.reserve(intervals);
+    for (size_t i = 0; i < intervals; ++i)
+    {
+        const float length = std::min(kIntervalSeconds, seconds - static_cast<float>(i) * kIntervalSeconds);
+        if (length < 1.0f)
+            break;
+        const uint32_t chars = i < m_intervalChars.size() ? m_intervalChars[i] : 0;
+        result.push_back(static_cast<uint16_t>(std::min<long>(std::lround(wpm(chars, length)), 65535)));
+    }
+    return result;
+}
+
+void TypingSpeed::save(std::string& out) const
+{
+    varint::put(out, m_typed);
+    varint::put(out, m_correct);
+    varint::put(out, m_intervalChars.size());
+    for (const uint16_t chars : m_intervalChars)
+    {
+        varint::put(out, chars);
+    }
+}
+
+bool TypingSpeed::restore(std::string_view& in)
+{
+    uint64_t typed = 0, correct = 0, count = 0;
+    // Every interval takes at least a byte, which bounds a corrupt count
+    if (!varint::get(in, typed) || !varint::get(in, correct) || !varint::get(in, count) || count > in.size())
+        return false;
+    std::vector<uint16_t> intervals;
+    intervals.reserve(std::max<size_t>(count, kReservedIntervals));
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        uint64_t chars = 0;
+        if (!varint::get(in, chars) || chars > std::numeric_limits<uint16_t>::max())
+            return false;
+        intervals.push_back(static_cast<uint16_t>(chars));
+    }
+    m_typed = static_cast<uint32_t>(typed);
+    m_correct = static_cast<uint32_t>(correct);
+    m_intervalChars = std::move(intervals);
+    return true;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Typing speed of one game in the usual units: a word is five characters
+// and a submitted word counts its space. Net speed counts the characters of
+// words that hit; raw speed counts every letter and space typed, hit or not.
+// Keys are counted as they arrive, into fixed intervals of game time, so the
+// speed curve of the whole game is ready the moment it ends.
+class TypingSpeed
+{
+public:
+    static constexpr float kIntervalSeconds = 5.0f;
+    // Reserved up front, about 20 minutes; longer games grow the curve
+    static constexpr size_t kReservedIntervals = 256;
+
+    TypingSpeed();
+
+    void reset();
+    // Every letter, and the space that submits a word
+    void addTyped(uint32_t chars = 1) { m_typed += chars; }
+    // A word that hit, submitted at seconds: its letters and the space
+    void addWord(float seconds, size_t length);
+
+    uint32_t typedChars() const { return m_typed; }
+    uint32_t correctChars() const { return m_correct; }
+    // Over a game of the given length
+    double netWpm(float seconds) const { return wpm(m_correct, seconds); }
+    double rawWpm(float seconds) const { return wpm(m_typed, seconds); }
+    // Net WPM of each interval of a game of the given length. The last one
+    // is scaled to its own length and left out when shorter than a second.
+    std::vector<uint16_t> curve(float seconds) const;
+
+    static double wpm(uint32_t chars, float seconds);
+
+    // For suspended games
+    void save(std::string& out) const;
+    bool restore(std::string_view& in);
+
+private:
+    uint32_t m_typed = 0;
+    uint32_t m_correct = 0;
+    std::vector<uint16_t> m_intervalChars; // Correct characters per interval
+
+    void addToInterval(float seconds, size_t chars);
+};
@@ -0,0 +1,355 @@
+#include "RaceProtocol.h"
+#include "../utils/Varint.h"
+#include <algorithm>
+#include <cmath>
+
+namespace race
+{
+namespace
+{
+enum SnapshotFlags : uint64_t
+{
+    kKeyframe = 1,
+};
+
+enum class WordOp : uint8_t
+{
+    Spawn = 0,
+    Move = 1,
+    Remove = 2,
+};
+
+uint32_t cellOf(float x)
+{
+    return static_cast<uint32_t>(std::max(0.0f, std::round(x)));
+}
+
+// Fields every snapshot starts with
+void putHeader(std::string& out, const GameEngine& engine, uint64_t tick, uint64_t flags)
+{
+    varint::put(out, flags);
+    varint::put(out, tick);
+    varint::put(out, static_cast<uint64_t>(std::max(0.0f, engine.getElapsedTime() * 1000.0f)));
+    varint::put(out, static_cast<uint64_t>(std::max(0.0f, engine.getHealthPercentage() * 10.0f)));
+    varint::put(out, static_cast<uint64_t>(engine.getVisibleWidth()));
+    varint::put(out, static_cast<uint64_t>(engine.getVisibleHeight()));
+}
+
+void putSpawn(std::string& out, const FallingWord& fw, uint32_t& lastId)
+{
+    varint::put(out, static_cast<uint64_t>(WordOp::Spawn));
+    varint::putSigned(out, static_cast<int64_t>(fw.id) - lastId);
+    varint::put(out, cellOf(fw.x));
+    varint::put(out, static_cast<uint64_t>(std::max(0.0f, std::round(fw.y * 2.0f))));
+    varint::putString(out, fw.word.text);
+    lastId = fw.id;
+}
+
+void putScore(std::string& out, const PlayerScore& score)
+{
+    varint::put(out, score.player);
+    varint::put(out, static_cast<uint64_t>(score.correctWords));
+    varint::put(out, static_cast<uint64_t>(score.wrongAttempts));
+}
+} // namespace
+
+void appendFrame(std::string& out, MessageType type, std::string_view body)
+{
+    varint::put(out, body.size() + 1);
+    out.push_back(static_cast<char>(type));
+    out.append(body);
+}
+
+void FrameReader::append(const char* data, size_t size)
+{
+    // Drop consumed frames before growing, so the buffer stays one frame or so
+    if (m_offset > 0)
+    {
+        m_buffer.erase(0, m_offset);
+        m_offset = 0;
+    }
+    m_buffer.append(data, size);
+}
+
+bool FrameReader::next(MessageType& type, std::string_view& body)
+{
+    if (m_broken)
+        return false;
+
+    std::string_view in(m_buffer);
+    in.remove_prefix(m_offset);
+    uint64_t size = 0;
+    if (!varint::get(in, size))
+    {
+        // Either incomplete or a corrupt prefix; ten bytes cover any varint
+        m_broken = in.size() >= 10;
+        return false;
+    }
+    if (size == 0 || size > kMaxFrameSize)
+    {
+        m_broken = true;
+        return false;
+    }
+    if (in.size() < size)
+        return false;
+
+    type = static_cast<MessageType>(in.front());
+    body = in.substr(1, size - 1);
+    m_offset = m_buffer.size() - in.size() + size;
+    return true;
+}
+
+std::string encodeHello(std::string_view name)
+{
+    std::string body;
+    varint::put(body, kProtocolVersion);
+    varint::putString(body, name);
+    return body;
+}
+
+bool decodeHello(std::string_view body, std::string& name)
+{
+    uint64_t version = 0;
+    return varint::get(body, version) && version == kProtocolVersion && varint::getString(body, name);
+}
+
+std::string encodeWelcome(const Welcome& welcome)
+{
+    std::string body;
+    varint::put(body, kProtocolVersion);
+    varint::put(body, welcome.player);
+    varint::put(body, welcome.raceNumber);
+    return body;
+}
+
+bool decodeWelcome(std::string_view body, Welcome& welcome)
+{
+    uint64_t version = 0;
+    uint64_t player = 0;
+    uint64_t raceNumber = 0;
+    if (!varint::get(body, version) || version != kProtocolVersion || !varint::get(body, player) || !varint::get(body, raceNumber))
+        return false;
+    welcome.player = static_cast<PlayerId>(player);
+    welcome.raceNumber = static_cast<uint32_t>(raceNumber);
+    return true;
+}
+
+std::string SnapshotEncoder::encodeDelta(const GameEngine& engine, uint64_t tick)
+{
+    const auto& words = engine.getFallingWords();
+    m_current.clear();
+    for (const auto& fw : words)
+    {
+        m_current.push_back({fw.id, cellOf(fw.x)});
+    }
+
+    // Both lists are in spawn order, so one merge pass finds every change
+    std::string ops;
+    size_t opCount = 0;
+    uint32_t lastId = 0;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < m_previous.size() || j < m_current.size())
+    {
+        if (j == m_current.size() || (i < m_previous.size() && m_previous[i].id < m_current[j].id))
+        {
+            varint::put(ops, static_cast<uint64_t>(WordOp::Remove));
+            varint::putSigned(ops, static_cast<int64_t>(m_previous[i].id) - lastId);
+            lastId = m_previous[i].id;
+            ++opCount;
+            ++i;
+        }
+        else if (i == m_previous.size() || m_previous[i].id > m_current[j].id)
+        {
+            putSpawn(ops, words[j], lastId);
+            ++opCount;
+            ++j;
+        }
+        else
+        {
+            if (m_previous[i].x != m_current[j].x)
+            {
+                varint::put(ops, static_cast<uint64_t>(WordOp::Move));
+                varint::putSigned(ops, static_cast<int64_t>(m_current[j].id) - lastId);
+                varint::put(ops, m_current[j].x);
+                lastId = m_current[j].id;
+                ++opCount;
+            }
+            ++i;
+            ++j;
+        }
+    }
+    m_previous.swap(m_current);
+
+    std::string scores;
+    size_t scoreCount = 0;
+    m_scores.resize(engine.getPlayerCount());
+    for (size_t p = 0; p < m_scores.size(); ++p)
+    {
+        const auto& stats = engine.getStats(static_cast<PlayerId>(p));
+        PlayerScore& known = m_scores[p];
+        if (known.correctWords != stats.correctWords || known.wrongAttempts != stats.wrongAttempts)
+        {
+            known = {static_cast<PlayerId>(p), stats.correctWords, stats.wrongAttempts};
+            putScore(scores, known);
+            ++scoreCount;
+        }
+    }
+
+    std::string body;
+    body.reserve(16 + ops.size() + scores.size());
+    putHeader(body, engine, tick, 0);
+    varint::put(body, opCount);
+    body += ops;
+    varint::put(body, scoreCount);
+    body += scores;
+    return body;
+}
+
+std::string SnapshotEncoder::encodeKeyframe(const GameEngine& engine, uint64_t tick) const
+{
+    std::string body;
+    putHeader(body, engine, tick, kKeyframe);
+
+    const auto& words = engine.getFallingWords();
+    varint::put(body, words.size());
+    uint32_t lastId = 0;
+    for (const auto& fw : words)
+    {
+        putSpawn(body, fw, lastId);
+    }
+
+    varint::put(body, engine.getPlayerCount());
+    for (size_t p = 0; p < engine.getPlayerCount(); ++p)
+    {
+        const auto& stats = engine.getStats(static_cast<PlayerId>(p));
+        putScore(body, {static_cast<PlayerId>(p), stats.correctWords, stats.wrongAttempts});
+    }
+    return body;
+}
+
+void SnapshotEncoder::reset()
+{
+    m_previous.clear();
+    m_scores.clear();
+}
+
+bool RaceMirror::apply(std::string_view body)
+{
+    uint64_t flags = 0;
+    uint64_t tick = 0;
+    uint64_t timeMs = 0;
+    uint64_t health = 0;
+    uint64_t width = 0;
+    uint64_t height = 0;
+    if (!varint::get(body, flags) || !varint::get(body, tick) || !varint::get(body, timeMs) || !varint::get(body, health) ||
+        !varint::get(body, width) || !varint::get(body, height))
+    {
+        m_synced = false;
+        return false;
+    }
+
+    if (flags & kKeyframe)
+    {
+        m_words.clear();
+        m_scores.clear();
+        m_synced = true;
+    }
+    else if (!m_synced)
+    {
+        return true;
+    }
+
+    m_tick = tick;
+    m_gameTime = static_cast<float>(timeMs) / 1000.0f;
+    m_health = static_cast<float>(health) / 10.0f;
+    m_width = std::max(1, static_cast<int>(width));
+    m_height = std::max(1, static_cast<int>(height));
+
+    uint64_t opCount = 0;
+    bool ok = varint::get(body, opCount);
+    int64_t lastId = 0;
+    for (uint64_t n = 0; ok && n < opCount; ++n)
+    {
+        uint64_t kind = 0;
+        int64_t idDelta = 0;
+        ok = varint::get(body, kind) && varint::getSigned(body, idDelta);
+        if (!ok)
+            break;
+        const auto id = static_cast<uint32_t>(lastId + idDelta);
+        lastId = id;
+
+        uint64_t x = 0;
+        switch (static_cast<WordOp>(kind))
+        {
+        case WordOp::Spawn:
+        {
+            uint64_t halfRows = 0;
+            std::string text;
+            ok = varint::get(body, x) && varint::get(body, halfRows) && varint::getString(body, text);
+            if (ok)
+            {
+                FallingWord fw(Word(text, ""), static_cast<float>(halfRows) / 2.0f, 0.0f);
+                fw.id = id;
+                fw.x = static_cast<float>(x);
+                fw.lifeProgress = std::min(fw.x / static_cast<float>(m_width), 1.0f);
+                m_words.push_back(std::move(fw));
+            }
+            break;
+        }
+        case WordOp::Move:
+            ok = varint::get(body, x);
+            if (FallingWord* fw = ok ? find(id) : nullptr)
+            {
+                fw->x = static_cast<float>(x);
+                fw->lifeProgress = std::min(fw->x / static_cast<float>(m_width), 1.0f);
+            }
+            break;
+        case WordOp::Remove:
+            m_words.erase(std::remove_if(m_words.begin(), m_words.end(), [id](const FallingWord& fw) { return fw.id == id; }), m_words.end());
+            break;
+        default:
+            ok = false;
+            break;
+        }
+    }
+
+    uint64_t scoreCount = 0;
+    ok = ok && varint::get(body, scoreCount);
+    for (uint64_t n = 0; ok && n < scoreCount; ++n)
+    {
+        uint64_t player = 0;
+        uint64_t correct = 0;
+        uint64_t wrong = 0;
+        ok = varint::get(body, player) && varint::get(body, correct) && varint::get(body, wrong);
+        if (ok && player < 0x10000)
+        {
+            if (m_scores.size() <= player)
+            {
+                m_scores.resize(player + 1);
+            }
+            m_scores[player] = {static_cast<PlayerId>(player), static_cast<int>(correct), static_cast<int>(wrong)};
+        }
+    }
+
+    if (!ok)
+    {
+        // A half-applied delta can't be trusted, wait for the next keyframe
+        m_synced = false;
+    }
+    return ok;
+}
+
+void RaceMirror::reset()
+{
+    m_synced = false;
+    m_words.clear();
+    m_scores.clear();
+}
+
+FallingWord* RaceMirror::find(uint32_t id)
+{
+    auto it = std::lower_bound(m_words.begin(), m_words.end(), id, [](const FallingWord& fw, uint32_t value) { return fw.id < value; });
+    return it != m_words.end() && it->id == id ? &*it : nullptr;
+}
+} // namespace race
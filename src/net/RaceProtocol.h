@@ -0,0 +1,133 @@
+#pragma once
+
+#include "../engine/GameEngine.h"
+#include "../models/FallingWord.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Wire format of the multiplayer race: one authoritative engine on the server,
+// clients mirroring its board. Transport-agnostic, the socket code lives with
+// the typeit_race tool.
+//
+// Every message is framed as a varint body length followed by the body, whose
+// first byte is the MessageType. Numbers are varints (see utils/Varint.h).
+namespace race
+{
+constexpr uint8_t kProtocolVersion = 1;
+// Larger frames are treated as a broken stream
+constexpr size_t kMaxFrameSize = 1 << 20;
+
+enum class MessageType : uint8_t
+{
+    // Client -> server
+    Hello = 1, // version, player name
+    Input = 2, // Keystrokes since the last batch: letters, '\b' and ' '
+
+    // Server -> client
+    Welcome = 16,  // version, player id, race number
+    Snapshot = 17, // Board changes, see SnapshotEncoder
+    RaceOver = 18, // Seconds until the next race starts
+};
+
+constexpr char kBackspaceKey = '\b';
+constexpr char kSubmitKey = ' ';
+
+void appendFrame(std::string& out, MessageType type, std::string_view body);
+
+// Splits a byte stream into frames
+class FrameReader
+{
+public:
+    void append(const char* data, size_t size);
+    // Pops the next complete frame; the body view stays valid until the next append()
+    bool next(MessageType& type, std::string_view& body);
+    // Set once the stream holds an oversized or empty frame; the peer should be dropped
+    bool broken() const { return m_broken; }
+
+private:
+    std::string m_buffer;
+    size_t m_offset = 0;
+    bool m_broken = false;
+};
+
+struct Welcome
+{
+    PlayerId player = 0;
+    uint32_t raceNumber = 0;
+};
+
+std::string encodeHello(std::string_view name);
+bool decodeHello(std::string_view body, std::string& name);
+std::string encodeWelcome(const Welcome& welcome);
+bool decodeWelcome(std::string_view body, Welcome& welcome);
+
+struct PlayerScore
+{
+    PlayerId player = 0;
+    int correctWords = 0;
+    int wrongAttempts = 0;
+};
+
+// Produces Snapshot bodies. A snapshot is a list of word operations (spawn,
+// move, remove) plus changed scores, relative to the previous delta; a
+// keyframe holds the whole board and resets a client's mirror. Word ids are
+// sent as deltas from the previous operation and positions in whole cells, so
+// a typical tick with one teleport costs a handful of bytes. Operations carry
+// absolute values, so a keyframe taken between two deltas stays consistent
+// with the next one.
+class SnapshotEncoder
+{
+public:
+    // Changes since the previous encodeDelta(); call once per tick
+    std::string encodeDelta(const GameEngine& engine, uint64_t tick);
+    // Full board, for clients joining or recovering; the next delta applies on top
+    std::string encodeKeyframe(const GameEngine& engine, uint64_t tick) const;
+    void reset();
+
+private:
+    struct WordState
+    {
+        uint32_t id;
+        uint32_t x;
+    };
+
+    std::vector<WordState> m_previous;
+    std::vector<WordState> m_current;
+    std::vector<PlayerScore> m_scores;
+};
+
+// Client-side copy of the server's board
+class RaceMirror
+{
+public:
+    // Applies a Snapshot body. Deltas before the first keyframe are ignored;
+    // returns false for a malformed body, which leaves the mirror unsynced.
+    bool apply(std::string_view body);
+    void reset();
+
+    bool synced() const { return m_synced; }
+    uint64_t tick() const { return m_tick; }
+    float gameTime() const { return m_gameTime; }
+    float health() const { return m_health; }
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+    const std::vector<FallingWord>& words() const { return m_words; }
+    // Indexed by PlayerId, missing players score zero
+    const std::vector<PlayerScore>& scores() const { return m_scores; }
+
+private:
+    bool m_synced = false;
+    uint64_t m_tick = 0;
+    float m_gameTime = 0.0f;
+    float m_health = 0.0f;
+    int m_width = 100;
+    int m_height = 15;
+    std::vector<FallingWord> m_words; // Ascending id
+    std::vector<PlayerScore> m_scores;
+
+    FallingWord* find(uint32_t id);
+};
+} // namespace race
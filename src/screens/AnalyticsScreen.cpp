@@ -0,0 +1,267 @@
+#include "AnalyticsScreen.h"
+#include "FrameText.h"
+#include "ftxui/component/event.hpp"
+#include <algorithm>
+#include <array>
+#include <memory_resource>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace ftxui;
+
+namespace
+{
+// Pairs typed fewer times than this are too noisy to colour
+constexpr uint32_t kMinBigramSamples = 3;
+constexpr int kLetters = KeyAnalytics::kLetters;
+
+std::string letter(int index)
+{
+    return std::string(1, static_cast<char>('a' + index));
+}
+
+// Cold (rare / fast) to hot (frequent / slow)
+Color heat(float t)
+{
+    const Color cold = Color::RGB(40, 160, 80);
+    const Color warm = Color::RGB(230, 200, 40);
+    const Color hot = Color::RGB(230, 50, 40);
+    return t < 0.5f ? Color::Interpolate(t * 2.0f, cold, warm) : Color::Interpolate((t - 0.5f) * 2.0f, warm, hot);
+}
+
+Element cell(float t)
+{
+    return text("  ") | bgcolor(heat(std::clamp(t, 0.0f, 1.0f)));
+}
+
+Element emptyCell()
+{
+    return text("  ");
+}
+
+Element headerRow()
+{
+    Elements header{text("  ")};
+    for (int column = 0; column < kLetters; ++column)
+    {
+        header.push_back(text(letter(column) + " ") | dim);
+    }
+    return hbox(std::move(header));
+}
+} // namespace
+
+AnalyticsScreen::AnalyticsScreen(const KeyAnalytics& analytics, std::function<void()> onClose)
+    : m_analytics(analytics), m_onClose(std::move(onClose))
+{}
+
+Component AnalyticsScreen::createComponent()
+{
+    auto renderer = Renderer(
+        [this]
+        {
+            FrameArena::Frame frame;
+            const bool confusion = m_map == Map::Confusion;
+            const std::string title = confusion ? "KEY CONFUSION" : "LETTER PAIR TIMING";
+            const std::string axes = confusion ? "expected letter down, typed letter across" : "first letter down, second letter across";
+
+            return vbox({
+                       text(title) | center | bold | color(Color::Cyan),
+                       text(axes) | center | dim,
+                       text(""),
+                       hbox({
+                           renderHeatmap(),
+                           text("  "),
+                           separator(),
+                           text("  "),
+                           confusion ? renderConfusionList() : renderBigramList(),
+                       }) | center,
+                       text(""),
+                       renderLegend() | center,
+                       text(""),
+                       textf("Games analysed: %u", m_analytics.games()) | center | dim,
+                       text("Controls: Tab=Switch map | Enter/Esc=Back") | center | dim,
+                   }) |
+                   border;
+        }
+    );
+
+    renderer |= CatchEvent(
+        [this](Event event)
+        {
+            if (event == Event::Return || event == Event::Escape)
+            {
+                if (m_onClose)
+                {
+                    m_onClose();
+                }
+                return true;
+            }
+            if (event == Event::Tab || event == Event::TabReverse)
+            {
+                m_map = m_map == Map::Confusion ? Map::Bigrams : Map::Confusion;
+                return true;
+            }
+            return false;
+        }
+    );
+
+    return renderer;
+}
+
+Element AnalyticsScreen::renderHeatmap()
+{
+    Elements rows{headerRow()};
+
+    if (m_map == Map::Confusion)
+    {
+        // Each slip as a share of the expected letter's presses, scaled to the
+        // worst one so a careful typist still sees where they slip
+        float worstRate = 0.0f;
+        std::array<uint32_t, kLetters> pressesOf{};
+        for (int expected = 0; expected < kLetters; ++expected)
+        {
+            pressesOf[expected] = m_analytics.pressesOf(expected);
+            for (int typed = 0; typed < kLetters && pressesOf[expected] > 0; ++typed)
+            {
+                if (typed != expected)
+                {
+                    worstRate = std::max(worstRate, static_cast<float>(m_analytics.presses(expected, typed)) / pressesOf[expected]);
+                }
+            }
+        }
+
+        for (int expected = 0; expected < kLetters; ++expected)
+        {
+            Elements row{text(letter(expected) + " ") | dim};
+            for (int typed = 0; typed < kLetters; ++typed)
+            {
+                const uint32_t count = m_analytics.presses(expected, typed);
+                if (typed == expected)
+                    row.push_back(text(count > 0 ? "··" : "  ") | dim);
+                else if (count == 0)
+                    row.push_back(emptyCell());
+                else
+                    row.push_back(cell(static_cast<float>(count) / pressesOf[expected] / worstRate));
+            }
+            rows.push_back(hbox(std::move(row)));
+        }
+        return vbox(std::move(rows));
+    }
+
+    // Scaled between the fastest and slowest pair with enough samples
+    double fastest = 0.0, slowest = 0.0;
+    bool any = false;
+    for (int first = 0; first < kLetters; ++first)
+    {
+        for (int second = 0; second < kLetters; ++second)
+        {
+            if (m_analytics.bigramCount(first, second) < kMinBigramSamples)
+                continue;
+            const double mean = m_analytics.bigramMeanMs(first, second);
+            fastest = any ? std::min(fastest, mean) : mean;
+            slowest = any ? std::max(slowest, mean) : mean;
+            any = true;
+        }
+    }
+    const double range = std::max(1.0, slowest - fastest);
+
+    for (int first = 0; first < kLetters; ++first)
+    {
+        Elements row{text(letter(first) + " ") | dim};
+        for (int second = 0; second < kLetters; ++second)
+        {
+            if (m_analytics.bigramCount(first, second) < kMinBigramSamples)
+                row.push_back(emptyCell());
+            else
+                row.push_back(cell(static_cast<float>((m_analytics.bigramMeanMs(first, second) - fastest) / range)));
+        }
+        rows.push_back(hbox(std::move(row)));
+    }
+    return vbox(std::move(rows));
+}
+
+Element AnalyticsScreen::renderConfusionList()
+{
+    struct Slip
+    {
+        int expected;
+        int typed;
+        uint32_t count;
+    };
+    std::pmr::vector<Slip> slips(FrameArena::local().resource());
+    for (int expected = 0; expected < kLetters; ++expected)
+    {
+        for (int typed = 0; typed < kLetters; ++typed)
+        {
+            const uint32_t count = m_analytics.presses(expected, typed);
+            if (typed != expected && count > 0)
+            {
+                slips.push_back({expected, typed, count});
+            }
+        }
+    }
+    const size_t shown = std::min(slips.size(), static_cast<size_t>(kListLength));
+    std::partial_sort(slips.begin(), slips.begin() + shown, slips.end(), [](const Slip& a, const Slip& b) { return a.count > b.count; });
+
+    Elements lines{text("Most frequent slips") | bold, text("")};
+    for (size_t i = 0; i < shown; ++i)
+    {
+        const Slip& slip = slips[i];
+        lines.push_back(textf("%c -> %c  %5u  %.1f%%", 'a' + slip.expected, 'a' + slip.typed, slip.count,
+                              100.0 * slip.count / m_analytics.pressesOf(slip.expected)));
+    }
+    if (slips.empty())
+    {
+        lines.push_back(text("No slips yet") | dim);
+    }
+    return vbox(std::move(lines));
+}
+
+Element AnalyticsScreen::renderBigramList()
+{
+    struct Pair
+    {
+        int first;
+        int second;
+        double meanMs;
+    };
+    std::pmr::vector<Pair> pairs(FrameArena::local().resource());
+    for (int first = 0; first < kLetters; ++first)
+    {
+        for (int second = 0; second < kLetters; ++second)
+        {
+            if (m_analytics.bigramCount(first, second) >= kMinBigramSamples)
+            {
+                pairs.push_back({first, second, m_analytics.bigramMeanMs(first, second)});
+            }
+        }
+    }
+    const size_t shown = std::min(pairs.size(), static_cast<size_t>(kListLength));
+    std::partial_sort(pairs.begin(), pairs.begin() + shown, pairs.end(), [](const Pair& a, const Pair& b) { return a.meanMs > b.meanMs; });
+
+    Elements lines{text("Slowest pairs") | bold, text("")};
+    for (size_t i = 0; i < shown; ++i)
+    {
+        const Pair& pair = pairs[i];
+        lines.push_back(textf("%c%c  %5d ms  x%u", 'a' + pair.first, 'a' + pair.second, static_cast<int>(pair.meanMs),
+                              m_analytics.bigramCount(pair.first, pair.second)));
+    }
+    if (pairs.empty())
+    {
+        lines.push_back(text("Not enough typing yet") | dim);
+    }
+    return vbox(std::move(lines));
+}
+
+Element AnalyticsScreen::renderLegend()
+{
+    Elements legend{text(m_map == Map::Confusion ? "rare " : "fast ") | dim};
+    constexpr int kSteps = 10;
+    for (int i = 0; i < kSteps; ++i)
+    {
+        legend.push_back(cell(static_cast<float>(i) / (kSteps - 1)));
+    }
+    legend.push_back(text(m_map == Map::Confusion ? " frequent" : " slow") | dim);
+    return hbox(std::move(legend));
+}
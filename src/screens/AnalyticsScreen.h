@@ -0,0 +1,35 @@
+#pragma once
+
+#include "BaseScreen.h"
+#include "../managers/KeyAnalytics.h"
+#include "ftxui/component/component.hpp"
+#include "ftxui/dom/elements.hpp"
+#include <functional>
+
+// Letter heatmaps from KeyAnalytics: the confusion matrix (expected letter
+// down, typed letter across) or the mean time of each letter pair. Cells are
+// coloured straight from the counter arrays on every frame.
+class AnalyticsScreen : public BaseScreen
+{
+public:
+    AnalyticsScreen(const KeyAnalytics& analytics, std::function<void()> onClose);
+
+    ftxui::Component createComponent() override;
+
+private:
+    enum class Map
+    {
+        Confusion,
+        Bigrams
+    };
+
+    const KeyAnalytics& m_analytics;
+    std::function<void()> m_onClose;
+    Map m_map = Map::Confusion;
+    static constexpr int kListLength = 8;
+
+    ftxui::Element renderHeatmap();
+    ftxui::Element renderConfusionList();
+    ftxui::Element renderBigramList();
+    ftxui::Element renderLegend();
+};
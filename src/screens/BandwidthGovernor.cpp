@@ -0,0 +1,185 @@
+#include "BandwidthGovernor.h"
+#include "ftxui/dom/node.hpp"
+#include "ftxui/screen/screen.hpp"
+#include "ftxui/screen/terminal.hpp"
+#include <algorithm>
+#include <iostream>
+
+using namespace ftxui;
+
+namespace
+{
+// Part of the budget left for the frames drawn on key presses
+constexpr double kTickShare = 0.8;
+// One busy frame shouldn't flip the colour depth back and forth
+constexpr auto kDepthDwell = std::chrono::seconds(2);
+constexpr double kSmoothing = 0.2;
+
+size_t depthIndex(WordPalette::Depth depth)
+{
+    return static_cast<size_t>(depth);
+}
+
+Terminal::Color terminalColor(WordPalette::Depth depth)
+{
+    switch (depth)
+    {
+    case WordPalette::Depth::TrueColor:
+        return Terminal::Color::TrueColor;
+    case WordPalette::Depth::Palette256:
+        return Terminal::Color::Palette256;
+    case WordPalette::Depth::Palette16:
+        break;
+    }
+    return Terminal::Color::Palette16;
+}
+
+// Transparent wrapper around the root element that clears the blink
+// attribute once everything below it has been drawn
+class NoBlinkNode : public Node
+{
+public:
+    explicit NoBlinkNode(Element child) : Node(Elements{std::move(child)}) {}
+
+    void ComputeRequirement() override
+    {
+        children_[0]->ComputeRequirement();
+        requirement_ = children_[0]->requirement();
+    }
+
+    void SetBox(Box box) override
+    {
+        Node::SetBox(box);
+        children_[0]->SetBox(box);
+    }
+
+    void Render(Screen& screen) override
+    {
+        Node::Render(screen);
+        const Box visible = Box::Intersection(box_, screen.stencil);
+        for (int y = visible.y_min; y <= visible.y_max; ++y)
+        {
+            for (int x = visible.x_min; x <= visible.x_max; ++x)
+            {
+                screen.PixelAt(x, y).blink = false;
+            }
+        }
+    }
+};
+} // namespace
+
+// Passes everything through to the original buffer and counts it
+class BandwidthGovernor::CountingBuffer : public std::streambuf
+{
+public:
+    explicit CountingBuffer(std::streambuf* target) : m_target(target) {}
+
+    uint64_t bytes() const { return m_bytes.load(std::memory_order_relaxed); }
+
+protected:
+    int_type overflow(int_type ch) override
+    {
+        if (traits_type::eq_int_type(ch, traits_type::eof()))
+            return traits_type::not_eof(ch);
+        m_bytes.fetch_add(1, std::memory_order_relaxed);
+        return m_target->sputc(traits_type::to_char_type(ch));
+    }
+
+    std::streamsize xsputn(const char* s, std::streamsize count) override
+    {
+        const std::streamsize written = m_target->sputn(s, count);
+        m_bytes.fetch_add(static_cast<uint64_t>(std::max<std::streamsize>(0, written)), std::memory_order_relaxed);
+        return written;
+    }
+
+    int sync() override { return m_target->pubsync(); }
+
+private:
+    std::streambuf* m_target;
+    std::atomic<uint64_t> m_bytes = 0;
+};
+
+BandwidthGovernor::BandwidthGovernor(double bytesPerSecond)
+    : m_budget(std::max(1.0, bytesPerSecond))
+    , m_counter(std::make_unique<CountingBuffer>(std::cout.rdbuf()))
+    , m_original(std::cout.rdbuf())
+    , m_depth(WordPalette::detectDepth())
+    , m_depthChanged(Clock::now())
+    , m_windowStart(Clock::now())
+    , m_frameIntervalUs(1'000'000 / kRestoreFps)
+    , m_fps(kRestoreFps)
+{
+    std::cout.rdbuf(m_counter.get());
+}
+
+BandwidthGovernor::~BandwidthGovernor()
+{
+    std::cout.flush();
+    std::cout.rdbuf(m_original);
+}
+
+void BandwidthGovernor::onFrame()
+{
+    const auto now = Clock::now();
+    const uint64_t bytes = m_counter->bytes();
+    const uint64_t frameBytes = bytes - m_lastBytes;
+    m_lastBytes = bytes;
+
+    if (frameBytes > 0)
+    {
+        double& mean = m_bytesPerFrame[depthIndex(m_depth)];
+        mean = mean == 0.0 ? static_cast<double>(frameBytes) : mean + kSmoothing * (static_cast<double>(frameBytes) - mean);
+    }
+
+    m_windowBytes += frameBytes;
+    const double windowSeconds = std::chrono::duration<double>(now - m_windowStart).count();
+    if (windowSeconds >= 1.0)
+    {
+        m_throughput = static_cast<double>(m_windowBytes) / windowSeconds;
+        m_windowBytes = 0;
+        m_windowStart = now;
+    }
+
+    // Fewer colours when even the budget's frame rate would be choppy, more
+    // again once the richer depth (measured before it was left) would be smooth
+    if (now - m_depthChanged >= kDepthDwell)
+    {
+        const auto poorer = static_cast<WordPalette::Depth>(depthIndex(m_depth) + 1);
+        const auto richer = static_cast<WordPalette::Depth>(depthIndex(m_depth) - 1);
+        if (m_depth != WordPalette::Depth::Palette16 && affordableFps(m_depth) < kDegradeFps)
+        {
+            applyDepth(poorer, now);
+        }
+        else if (m_depth != WordPalette::Depth::TrueColor && m_bytesPerFrame[depthIndex(richer)] > 0.0 &&
+                 affordableFps(richer) >= kRestoreFps)
+        {
+            applyDepth(richer, now);
+        }
+    }
+
+    const int fps = affordableFps(m_depth);
+    m_fps.store(fps, std::memory_order_relaxed);
+    m_frameIntervalUs.store(1'000'000 / fps, std::memory_order_relaxed);
+}
+
+int BandwidthGovernor::affordableFps(WordPalette::Depth depth) const
+{
+    const double mean = m_bytesPerFrame[depthIndex(depth)];
+    if (mean <= 0.0)
+        return kRestoreFps;
+    return std::clamp(static_cast<int>(m_budget * kTickShare / mean), kMinFps, kMaxFps);
+}
+
+void BandwidthGovernor::applyDepth(WordPalette::Depth depth, Clock::time_point now)
+{
+    m_depth = depth;
+    m_depthChanged = now;
+    // Colours built from RGB after this are mapped to the palette by FTXUI;
+    // the word palette is rebuilt by the game screen
+    Terminal::SetColorSupport(terminalColor(depth));
+}
+
+Element BandwidthGovernor::decorate(Element root) const
+{
+    return std::make_shared<NoBlinkNode>(std::move(root));
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "WordPalette.h"
+#include "ftxui/dom/elements.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <streambuf>
+
+// Low-bandwidth mode for slow links such as SSH. FTXUI writes every frame
+// through std::cout, so the governor counts the bytes that pass through it
+// and picks the frame rate and colour depth that keep the output under a
+// bytes-per-second budget. The game keeps ticking at its fixed rate; frames
+// in between are simply never drawn. Blink is stripped from every frame.
+class BandwidthGovernor
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr int kMinFps = 2;
+    static constexpr int kMaxFps = 60;
+    // Below this the colour depth steps down; above kRestoreFps at the
+    // richer depth it steps back up
+    static constexpr int kDegradeFps = 12;
+    static constexpr int kRestoreFps = 30;
+
+    // Counting starts here and stops when the governor is destroyed
+    explicit BandwidthGovernor(double bytesPerSecond);
+    ~BandwidthGovernor();
+    BandwidthGovernor(const BandwidthGovernor&) = delete;
+    BandwidthGovernor& operator=(const BandwidthGovernor&) = delete;
+
+    // Call once per frame from the UI thread, before the frame is built. The
+    // bytes written since the last call belong to the previous frame(s).
+    void onFrame();
+
+    // Thread-safe, read by the tick thread to decide when to ask for a frame
+    Clock::duration frameInterval() const { return std::chrono::microseconds(m_frameIntervalUs.load(std::memory_order_relaxed)); }
+    int framesPerSecond() const { return m_fps.load(std::memory_order_relaxed); }
+    WordPalette::Depth depth() const { return m_depth; }
+    // Measured over the last second
+    double bytesPerSecond() const { return m_throughput; }
+    double budget() const { return m_budget; }
+
+    // Strips blink from everything the element draws
+    ftxui::Element decorate(ftxui::Element root) const;
+
+private:
+    class CountingBuffer;
+
+    double m_budget;
+    std::unique_ptr<CountingBuffer> m_counter;
+    std::streambuf* m_original = nullptr;
+
+    uint64_t m_lastBytes = 0;
+    // Mean bytes per frame at each depth, 0 until measured there
+    std::array<double, 3> m_bytesPerFrame{};
+    WordPalette::Depth m_depth = WordPalette::Depth::TrueColor;
+    Clock::time_point m_depthChanged;
+
+    Clock::time_point m_windowStart;
+    uint64_t m_windowBytes = 0;
+    double m_throughput = 0.0;
+
+    std::atomic<int64_t> m_frameIntervalUs;
+    std::atomic<int> m_fps;
+
+    void applyDepth(WordPalette::Depth depth, Clock::time_point now);
+    int affordableFps(WordPalette::Depth depth) const;
+};
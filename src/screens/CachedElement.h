@@ -0,0 +1,29 @@
+#pragma once
+
+#include "ftxui/dom/elements.hpp"
+#include <utility>
+
+// A rendered sub-panel kept between frames. get() rebuilds it only when the
+// key (the values the panel shows) differs from the one it was built for, so
+// a panel that changes a few times a second costs nothing on other frames.
+template <typename Key>
+class CachedElement
+{
+public:
+    template <typename Build>
+    const ftxui::Element& get(const Key& key, Build&& build)
+    {
+        if (!m_element || !(key == m_key))
+        {
+            m_key = key;
+            m_element = std::forward<Build>(build)();
+        }
+        return m_element;
+    }
+
+    void invalidate() { m_element = nullptr; }
+
+private:
+    Key m_key{};
+    ftxui::Element m_element;
+};
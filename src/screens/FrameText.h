@@ -0,0 +1,14 @@
+#pragma once
+
+#include "../utils/FrameArena.h"
+#include "ftxui/dom/elements.hpp"
+#include <string>
+
+// printf-style text element. The formatting happens in the frame arena; the
+// only heap string left is the element's own copy, and short labels fit in
+// its small buffer.
+template <typename... Args>
+ftxui::Element textf(const char* fmt, Args... args)
+{
+    return ftxui::text(std::string(FrameArena::local().format(fmt, args...)));
+}
@@ -1,23 +1,64 @@
 #include "GameScreen.h"
+#include "FrameText.h"
 #include "../utils/GameConfig.h"
+#include "../utils/Trace.h"
 #include "ftxui/component/event.hpp"
-#include "ftxui/dom/canvas.hpp"
 #include "ftxui/dom/elements.hpp"
 #include <algorithm>
 #include <cmath>
-#include <iomanip>
-#include <sstream>
+#include <string_view>
 #include <utility>
 
 using namespace ftxui;
 
+namespace
+{
+Element clockText(const char* label, float seconds)
+{
+    const int whole = static_cast<int>(seconds);
+    return textf("%s%02d:%02d", label, whole / 60, whole % 60);
+}
+
+// The engine measures the board in half cells, two across and two down per
+// character, the resolution of the braille canvas it was first drawn on
+int boardWidth(const WordField& field)
+{
+    return field.width() * 2;
+}
+
+int boardHeight(const WordField& field)
+{
+    return field.height() * 2;
+}
+
+int cellX(const FallingWord& fw, const WordField& field)
+{
+    return std::clamp(static_cast<int>(std::round(fw.x)), 0, std::max(0, boardWidth(field) - 1)) / 2;
+}
+
+int cellY(const FallingWord& fw, const WordField& field)
+{
+    return std::clamp(static_cast<int>(std::round(fw.y * 2.0f)), 0, std::max(0, boardHeight(field) * 2 - 2)) / 4;
+}
+} // namespace
+
 GameScreen::GameScreen(
     GameEngine& engine,
     ftxui::ScreenInteractive& screen,
     std::function<void()> onGameFinished,
-    std::function<void()> onAbort
+    std::function<void()> onSuspend,
+    GhostRunner* ghost,
+    const BandwidthGovernor* governor,
+    JitterStats* pacing
 )
-    : m_engine(engine), m_screen(screen), m_onGameFinished(std::move(onGameFinished)), m_onAbort(std::move(onAbort))
+    : m_engine(engine)
+    , m_screen(screen)
+    , m_onGameFinished(std::move(onGameFinished))
+    , m_onSuspend(std::move(onSuspend))
+    , m_governor(governor)
+    , m_pacing(pacing)
+    , m_palette(engine.getSettings(), governor ? governor->depth() : WordPalette::detectDepth())
+    , m_simulation(engine, ghost, pacing)
 {}
 
 GameScreen::~GameScreen()
@@ -27,59 +68,41 @@ GameScreen::~GameScreen()
 
 void GameScreen::onEnter()
 {
-    m_lastFrameTime = std::chrono::steady_clock::now();
     m_finishNotified = false;
+    m_framePending = false;
+    m_lastFramePost = {};
 
-    if (m_updateThreadRunning)
-    {
-        return;
-    }
-
-    m_updateThreadRunning = true;
-
-    m_updateThread = std::thread(
+    m_simulation.start(
         [this]()
         {
-            auto lastUpdateTime = std::chrono::steady_clock::now();
-
-            while (m_updateThreadRunning)
-            {
-                auto now = std::chrono::steady_clock::now();
-                float deltaTime = std::chrono::duration<float>(now - lastUpdateTime).count();
-                lastUpdateTime = now;
-
-                m_screen.Post(
-                    [this, deltaTime]()
+            // At most one redraw queued; with a governor the views in between
+            // are merged into the next frame it allows
+            const auto now = std::chrono::steady_clock::now();
+            if (m_governor && now - m_lastFramePost < m_governor->frameInterval())
+                return;
+            if (m_framePending.exchange(true))
+                return;
+            m_lastFramePost = now;
+            m_screen.Post(Event::Custom);
+        },
+        [this]()
+        {
+            m_screen.Post(
+                [this]()
+                {
+                    if (!m_finishNotified.exchange(true) && m_onGameFinished)
                     {
-                        if (m_engine.isRunning() && !m_engine.isGameOver())
-                        {
-                            m_engine.update(deltaTime);
-                        }
-                        else if (!m_finishNotified.exchange(true))
-                        {
-                            m_updateThreadRunning = false;
-                            if (m_onGameFinished)
-                            {
-                                m_onGameFinished();
-                            }
-                        }
+                        m_onGameFinished();
                     }
-                );
-
-                m_screen.Post(Event::Custom);
-                std::this_thread::sleep_for(std::chrono::milliseconds(16));
-            }
+                }
+            );
         }
     );
 }
 
 void GameScreen::onExit()
 {
-    m_updateThreadRunning = false;
-    if (m_updateThread.joinable())
-    {
-        m_updateThread.join();
-    }
+    m_simulation.stop();
 }
 
 Component GameScreen::createComponent()
@@ -98,37 +121,39 @@ Component GameScreen::createComponent()
     renderer |= CatchEvent(
         [this](Event event)
         {
-            if (m_engine.isGameOver())
+            if (m_finishNotified)
             {
                 return false;
             }
 
+            // Stamped here and applied by the simulation before its next step
             if (event == Event::Character(' ') || event == Event::Return)
             {
-                m_engine.handleSpace();
+                m_simulation.pushInput(KeyPress::Type::Space);
                 return true;
             }
 
             if (event.is_character())
             {
-                m_engine.handleCharInput(event.character()[0]);
+                m_simulation.pushInput(KeyPress::Type::Char, event.character()[0]);
                 return true;
             }
 
             if (event == Event::Backspace)
             {
-                m_engine.handleBackspace();
+                m_simulation.pushInput(KeyPress::Type::Backspace);
                 return true;
             }
 
             if (event == Event::Escape)
             {
-                m_engine.stop();
-                m_updateThreadRunning = false;
+                // Paused rather than stopped, so the game can still be suspended to disk
+                m_simulation.stop();
+                m_engine.pause();
                 m_finishNotified = true;
-                if (m_onAbort)
+                if (m_onSuspend)
                 {
-                    m_onAbort();
+                    m_onSuspend();
                 }
                 return true;
             }
@@ -142,7 +167,22 @@ Component GameScreen::createComponent()
 
 Element GameScreen::render()
 {
-    auto borderColor = m_engine.shouldFlashRedBorder() ? Color::Red : Color::White;
+    TYPEIT_TRACE_SCOPE("GameScreen::render");
+    FrameArena::Frame frame;
+    m_framePending = false;
+    m_view = &m_simulation.view();
+    if (m_view->traceFlow != 0 && m_view->traceFlow != m_lastTraceFlow)
+    {
+        // Closes the arrow from the simulation step that published this view
+        trace::flowEnd("view", m_view->traceFlow);
+        m_lastTraceFlow = m_view->traceFlow;
+    }
+    if (m_governor && m_governor->depth() != m_palette.depth())
+    {
+        // The engine's copy never changes during a game, so reading it here is safe
+        m_palette.rebuild(m_engine.getSettings(), m_governor->depth());
+    }
+    auto borderColor = m_view->flashRedBorder ? Color::Red : Color::White;
 
     return vbox({
                renderHeader(),
@@ -157,159 +197,255 @@ Element GameScreen::render()
 
 Element GameScreen::renderHeader()
 {
-    float elapsed = m_engine.getElapsedTime();
-    int minutes = static_cast<int>(elapsed) / 60;
-    int seconds = static_cast<int>(elapsed) % 60;
-
-    std::ostringstream timeStr;
-    timeStr << std::setfill('0') << std::setw(2) << minutes << ":" << std::setfill('0') << std::setw(2) << seconds;
-
-    return hbox({
-        text("Time: " + timeStr.str()) | bold | color(Color::Cyan),
-        text("  "),
-        renderHealthBar() | flex,
-        text("  "),
-        renderCombo(),
-    });
+    TYPEIT_TRACE_SCOPE("GameScreen::renderHeader");
+    const int seconds = static_cast<int>(m_view->elapsedTime);
+    const Element& clock =
+        m_clockPanel.get(seconds, [&] { return clockText("Time: ", static_cast<float>(seconds)) | bold | color(Color::Cyan); });
+    const Element& health = renderHealthBar();
+    const Element& combo = renderCombo();
+    const Element* link = m_governor ? &renderLink() : nullptr;
+
+    // A child is a new node exactly when it was rebuilt
+    return m_headerPanel.get({clock.get(), health.get(), combo.get(), link ? link->get() : nullptr},
+                             [&]
+                             {
+                                 Elements row = {
+                                     clock,
+                                     text("  "),
+                                     health | flex,
+                                     text("  "),
+                                     combo,
+                                 };
+                                 if (link)
+                                 {
+                                     row.push_back(text("  "));
+                                     row.push_back(*link);
+                                 }
+                                 return hbox(std::move(row));
+                             });
 }
 
-Element GameScreen::renderHealthBar()
+const Element& GameScreen::renderHealthBar()
 {
-    float healthPercent = m_engine.getHealthPercentage();
-    int totalBlocks = 20;
-    int filledBlocks = static_cast<int>(healthPercent / 100.0f * totalBlocks);
-
-    std::string bar;
-    for (int i = 0; i < filledBlocks; ++i)
-        bar += "█";
-    for (int i = filledBlocks; i < totalBlocks; ++i)
-        bar += "░";
-
-    auto barElement = text(bar);
-
-    if (healthPercent > 60)
-    {
-        barElement = barElement | color(Color::Green);
-    }
-    else if (healthPercent > 30)
-    {
-        barElement = barElement | color(Color::Yellow);
-    }
-    else
-    {
-        barElement = barElement | color(Color::Red);
-    }
-
-    std::ostringstream oss;
-    oss << std::fixed << std::setprecision(0) << healthPercent;
+    constexpr int kTotalBlocks = 20;
+    const float healthPercent = m_view->health;
+    const int filledBlocks = std::clamp(static_cast<int>(healthPercent / 100.0f * kTotalBlocks), 0, kTotalBlocks);
+    const int band = healthPercent > 60 ? 2 : (healthPercent > 30 ? 1 : 0);
+    const int shownPercent = static_cast<int>(std::lround(healthPercent));
+
+    return m_healthPanel.get(
+        {filledBlocks, shownPercent, band},
+        [&]
+        {
+            TYPEIT_TRACE_SCOPE("GameScreen::renderHealthBar");
+            std::string bar;
+            bar.reserve(kTotalBlocks * std::string_view("█").size());
+            for (int i = 0; i < kTotalBlocks; ++i)
+            {
+                bar += i < filledBlocks ? "█" : "░";
+            }
 
-    return hbox({text("❤ "), barElement, text(" " + oss.str() + "%")});
+            const Color barColor = band == 2 ? Color::Green : (band == 1 ? Color::Yellow : Color::Red);
+            return hbox({text("❤ "), text(std::move(bar)) | color(barColor), textf(" %d%%", shownPercent)});
+        }
+    );
 }
 
-Element GameScreen::renderCombo()
+const Element& GameScreen::renderCombo()
 {
-    const auto& cfg = ConfigManager::instance().settings();
-    int combo = m_engine.getStats().currentCombo;
+    const int combo = m_view->stats.currentCombo;
+    return m_comboPanel.get(
+        combo,
+        [this, combo]
+        {
+            TYPEIT_TRACE_SCOPE("GameScreen::renderCombo");
+            const auto& cfg = m_engine.getSettings();
+            if (combo < cfg.minComboDisplay)
+            {
+                return text("");
+            }
 
-    if (combo < cfg.minComboDisplay)
-    {
-        return text("");
-    }
+            auto comboText = textf("Combo: %dx", combo);
 
-    auto comboText = text("Combo: " + std::to_string(combo) + "x");
+            if (combo >= 50)
+            {
+                return comboText | color(Color::RedLight) | bold | blink;
+            }
+            else if (combo >= 30)
+            {
+                return comboText | color(Color::YellowLight) | bold;
+            }
+            else if (combo >= 10)
+            {
+                return comboText | color(Color::Yellow);
+            }
+            else
+            {
+                return comboText | color(Color::White);
+            }
+        }
+    );
+}
 
-    if (combo >= 50)
-    {
-        return comboText | color(Color::RedLight) | bold | blink;
-    }
-    else if (combo >= 30)
-    {
-        return comboText | color(Color::YellowLight) | bold;
-    }
-    else if (combo >= 10)
-    {
-        return comboText | color(Color::Yellow);
-    }
-    else
-    {
-        return comboText | color(Color::White);
-    }
+const Element& GameScreen::renderLink()
+{
+    const int tenths = static_cast<int>(std::lround(m_governor->bytesPerSecond() / 100.0));
+    const int fps = m_governor->framesPerSecond();
+    const auto depth = m_governor->depth();
+    const bool over = m_governor->bytesPerSecond() > m_governor->budget();
+    return m_linkPanel.get(
+        {tenths, fps, static_cast<int>(depth), over},
+        [&]
+        {
+            static constexpr const char* kDepthNames[] = {"24-bit", "256", "16"};
+            return textf("%d.%d kB/s %dfps %s", tenths / 10, tenths % 10, fps, kDepthNames[static_cast<int>(depth)]) |
+                   color(over ? Color::Yellow : Color::GrayDark);
+        }
+    );
 }
 
 Element GameScreen::renderGameArea()
 {
-    // Use lambda overload, Canvas is created at render time
-    // Get actual dimensions inside lambda and update engine's visible area
-    return canvas(
-               [this](Canvas& c)
+    TYPEIT_TRACE_SCOPE("GameScreen::renderGameArea");
+    // Drawn at render time, once the field knows its size. The view stays
+    // put until the next render() asks for a newer one.
+    return wordField(
+               [this, view = m_view](WordField& field)
                {
-                   int w = c.width();
-                   int h = c.height() / 2; // Canvas height is in pixels, convert to character height
-
-                   // Update visible area at render time to handle resize correctly
-                   m_engine.updateVisibleArea(w, h);
+                   // Passed on at render time to handle resize correctly
+                   m_simulation.setVisibleArea(boardWidth(field), boardHeight(field));
 
-                   drawFallingWords(c, w, h);
+                   drawGhostWords(field, *view);
+                   drawFallingWords(field, *view);
                }
            ) |
            flex | reflect(m_gameAreaBox);
 }
 
-void GameScreen::drawFallingWords(ftxui::Canvas& canvas, int width, int height)
+void GameScreen::drawFallingWords(WordField& field, const GameView& view)
 {
-    const auto& words = m_engine.getFallingWords();
-    for (const auto& fw : words)
+    TYPEIT_TRACE_SCOPE("GameScreen::drawFallingWords");
+    const int width = boardWidth(field);
+    for (size_t i = 0; i < view.words.size(); ++i)
     {
+        const FallingWord& fw = view.words[i];
         if (!fw.isVisible(width))
         {
             continue;
         }
 
-        const auto colorRGB = fw.getCurrentColor();
-        const int x = std::clamp(static_cast<int>(std::round(fw.x)), 0, std::max(0, width - 1));
-        const int y = std::clamp(static_cast<int>(std::round(fw.y * 2.0f)), 0, std::max(0, height * 2 - 2));
+        // Words the ghost has already typed fade out
+        field.drawText(cellX(fw, field), cellY(fw, field), fw.word.text, m_palette.colorAt(fw.lifeProgress), view.ghostCleared[i] != 0);
+    }
+}
 
-        canvas.DrawText(
-            x,
-            y,
-            fw.word.text,
-            Color::RGB(static_cast<uint8_t>(colorRGB.r), static_cast<uint8_t>(colorRGB.g), static_cast<uint8_t>(colorRGB.b))
-        );
+void GameScreen::drawGhostWords(WordField& field, const GameView& view)
+{
+    if (view.ghostWords.empty())
+        return;
+
+    TYPEIT_TRACE_SCOPE("GameScreen::drawGhostWords");
+    const int width = boardWidth(field);
+    for (const auto& fw : view.ghostWords)
+    {
+        if (!fw.isVisible(width))
+            continue;
+        field.drawText(cellX(fw, field), cellY(fw, field), fw.word.text, Color::GrayDark, true);
     }
 }
 
 Element GameScreen::renderInputBox()
 {
-    std::string displayInput = m_engine.getCurrentInput();
-    if (displayInput.empty())
+    TYPEIT_TRACE_SCOPE("GameScreen::renderInputBox");
+    const std::string& input = m_view->input;
+    const Element& inputRow = m_inputPanel.get(
+        input,
+        [&]
+        {
+            return hbox({
+                text("Input: ") | bold,
+                text(input.empty() ? " " : input) | color(Color::Cyan) | bold, // Avoid empty line
+                text("_") | blink,
+            });
+        }
+    );
+
+    if (m_view->rivals.empty() && !m_view->ghostShown)
     {
-        displayInput = " "; // Avoid empty line
+        return inputRow;
     }
 
-    return vbox({
-        hbox({
-            text("Input: ") | bold,
-            text(displayInput) | color(Color::Cyan) | bold,
-            text("_") | blink,
-        }),
-    });
+    Elements rows = {inputRow};
+
+    // Opponents typing on the same board
+    for (const auto& rival : m_view->rivals)
+    {
+        rows.push_back(hbox({
+            text("Rival: ") | dim,
+            text(rival.input) | color(Color::Magenta),
+            filler(),
+            textf("Score: %d", rival.score) | color(Color::Magenta),
+        }));
+    }
+
+    if (m_view->ghostShown)
+    {
+        rows.push_back(renderGhostRow());
+    }
+
+    return vbox(std::move(rows));
 }
 
-Element GameScreen::renderStats()
+Element GameScreen::renderGhostRow()
 {
-    const auto& stats = m_engine.getStats();
-
-    std::ostringstream oss;
-    oss << std::fixed << std::setprecision(1) << stats.getAccuracy();
+    const int score = m_view->ghostScore;
+    if (m_view->ghostFinished)
+    {
+        return hbox({
+                   clockText("Ghost fell at ", m_view->ghostFinishTime),
+                   filler(),
+                   textf("Score: %d", score),
+               }) |
+               color(Color::GrayLight) | dim;
+    }
 
     return hbox({
-               text("Correct: " + std::to_string(stats.correctWords)),
-               text("  "),
-               text("Wrong: " + std::to_string(stats.wrongAttempts)),
-               text("  "),
-               text("Missed: " + std::to_string(stats.missedWords)),
-               text("  "),
-               text("Accuracy: " + oss.str() + "%"),
+               text("Ghost: "),
+               text(m_view->ghostInput),
+               filler(),
+               textf("Score: %d", score),
            }) |
-           dim;
+           color(Color::GrayLight) | dim;
+}
+
+const Element& GameScreen::renderStats()
+{
+    const auto& stats = m_view->stats;
+    const JitterStats::Summary pacing = m_pacing ? m_pacing->summary() : JitterStats::Summary{};
+    auto tenths = [](double ms) { return static_cast<int>(std::lround(ms * 10.0)); };
+    const int p50 = tenths(pacing.p50Ms);
+    const int p99 = tenths(pacing.p99Ms);
+    const int max = tenths(pacing.maxMs);
+    return m_statsPanel.get(
+        {stats.correctWords, stats.wrongAttempts, stats.missedWords, p50, p99, max},
+        [&]
+        {
+            TYPEIT_TRACE_SCOPE("GameScreen::renderStats");
+            Elements row = {
+                textf("Correct: %d", stats.correctWords),
+                text("  "),
+                textf("Wrong: %d", stats.wrongAttempts),
+                text("  "),
+                textf("Missed: %d", stats.missedWords),
+                text("  "),
+                textf("Accuracy: %.1f%%", stats.getAccuracy()),
+            };
+            if (pacing.samples > 0)
+            {
+                row.push_back(filler());
+                row.push_back(textf("Jitter p50 %d.%d p99 %d.%d max %d.%d ms", p50 / 10, p50 % 10, p99 / 10, p99 % 10, max / 10, max % 10));
+            }
+            return hbox(std::move(row)) | dim;
+        }
+    );
 }
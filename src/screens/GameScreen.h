@@ -1,19 +1,35 @@
 #pragma once
 
+#include "BandwidthGovernor.h"
 #include "BaseScreen.h"
+#include "CachedElement.h"
+#include "WordField.h"
+#include "WordPalette.h"
 #include "../engine/GameEngine.h"
+#include "../engine/GameSimulation.h"
+#include "../engine/GhostRunner.h"
+#include "../utils/JitterStats.h"
 #include "ftxui/component/component.hpp"
 #include "ftxui/component/screen_interactive.hpp"
 #include "ftxui/screen/box.hpp"
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <functional>
-#include <thread>
+#include <string>
 
 class GameScreen : public BaseScreen
 {
 public:
-    GameScreen(GameEngine& engine, ftxui::ScreenInteractive& screen, std::function<void()> onGameFinished, std::function<void()> onAbort);
+    // Esc pauses the engine and calls onSuspend, which decides what happens to the game.
+    // While the screen is entered the engine runs on a GameSimulation thread and frames
+    // are drawn from the views it publishes. A started ghost is stepped in lockstep
+    // with the engine and drawn over the board.
+    // With a governor the game still ticks at its fixed rate but asks for frames only
+    // as often as the link allows, and the header shows the measured throughput.
+    // Wake-up jitter of the simulation goes to pacing and is shown under the board.
+    GameScreen(GameEngine& engine, ftxui::ScreenInteractive& screen, std::function<void()> onGameFinished, std::function<void()> onSuspend,
+               GhostRunner* ghost = nullptr, const BandwidthGovernor* governor = nullptr, JitterStats* pacing = nullptr);
     ~GameScreen() override;
 
     ftxui::Component createComponent() override;
@@ -24,20 +40,39 @@ private:
     GameEngine& m_engine;
     ftxui::ScreenInteractive& m_screen;
     std::function<void()> m_onGameFinished;
-    std::function<void()> m_onAbort;
+    std::function<void()> m_onSuspend;
+    const BandwidthGovernor* m_governor;
+    JitterStats* m_pacing;
+    WordPalette m_palette; // Built from the engine's settings, rebuilt when the governor changes depth
 
-    std::chrono::steady_clock::time_point m_lastFrameTime;
-    std::atomic<bool> m_updateThreadRunning = false;
+    GameSimulation m_simulation;
+    const GameView* m_view = nullptr; // Taken at the start of each render()
+    uint64_t m_lastTraceFlow = 0; // Flow of the view last drawn, so each arrow ends once
+    // Set while a redraw is queued on the UI loop, so a slow terminal gets
+    // the newest view instead of a backlog of frames
+    std::atomic<bool> m_framePending = false;
+    std::chrono::steady_clock::time_point m_lastFramePost; // Simulation thread only
     std::atomic<bool> m_finishNotified = false;
-    std::thread m_updateThread;
     ftxui::Box m_gameAreaBox;
 
+    // Panels that change a few times a second at most, keyed on what they show
+    CachedElement<int> m_clockPanel; // Whole seconds
+    CachedElement<std::array<int, 3>> m_healthPanel; // Filled blocks, percent, colour band
+    CachedElement<int> m_comboPanel;
+    CachedElement<std::array<int, 6>> m_statsPanel; // Correct, wrong, missed, jitter p50/p99/max in 0.1 ms
+    CachedElement<std::string> m_inputPanel;
+    CachedElement<std::array<int, 4>> m_linkPanel; // kB/s in tenths, fps, depth, over budget
+    CachedElement<std::array<const ftxui::Node*, 4>> m_headerPanel; // Its cached children
+
     ftxui::Element render();
     ftxui::Element renderHeader();
-    ftxui::Element renderHealthBar();
-    ftxui::Element renderCombo();
+    const ftxui::Element& renderHealthBar();
+    const ftxui::Element& renderCombo();
+    const ftxui::Element& renderLink();
     ftxui::Element renderGameArea();
-    void drawFallingWords(ftxui::Canvas& canvas, int width, int height);
+    void drawFallingWords(WordField& field, const GameView& view);
+    void drawGhostWords(WordField& field, const GameView& view);
+    ftxui::Element renderGhostRow();
     ftxui::Element renderInputBox();
-    ftxui::Element renderStats();
+    const ftxui::Element& renderStats();
 };
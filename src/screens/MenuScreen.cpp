@@ -6,10 +6,31 @@
 
 using namespace ftxui;
 
-MenuScreen::MenuScreen(std::function<void(MenuOption)> onSelect)
-    : m_onSelect(std::move(onSelect)), m_entries({"Start Game", "Statistics", "Exit"})
+MenuScreen::MenuScreen(std::function<void(MenuOption)> onSelect, StatusProvider statusOf)
+    : m_onSelect(std::move(onSelect)), m_statusOf(std::move(statusOf)), m_entries({"Start Game", "Resume Game", "Race Your Best", "Statistics", "Exit"})
 {}
 
+std::string MenuScreen::statusOf(MenuOption option) const
+{
+    return m_statusOf ? m_statusOf(option) : std::string();
+}
+
+Element MenuScreen::renderEntry(int index, MenuOption option, const std::string& label)
+{
+    const bool selected = m_selectedIndex == index;
+    const std::string status = statusOf(option);
+    auto entry = text(selected ? "> " + label : "  " + label) | (selected ? color(Color::Yellow) | bold : color(Color::White));
+    if (status.empty())
+    {
+        return entry | center;
+    }
+    return hbox({
+               entry | dim,
+               text(" (" + status + ")") | dim,
+           }) |
+           center;
+}
+
 Component MenuScreen::createComponent()
 {
     auto menu = Menu(&m_entries, &m_selectedIndex);
@@ -31,13 +52,12 @@ Component MenuScreen::createComponent()
                        text("+===========================================+") | center | bold,
                        text("") | center,
                        vbox({
-                           text(m_selectedIndex == 0 ? "> Start Game" : "  Start Game") | center |
-                               (m_selectedIndex == 0 ? color(Color::Yellow) | bold : color(Color::White)),
+                           renderEntry(0, MenuOption::StartGame, "Start Game"),
+                           renderEntry(1, MenuOption::ResumeGame, "Resume Game"),
+                           renderEntry(2, MenuOption::GhostRace, "Race Your Best"),
                            text("") | center,
-                           text(m_selectedIndex == 1 ? "> Statistics" : "  Statistics") | center |
-                               (m_selectedIndex == 1 ? color(Color::Yellow) | bold : color(Color::White)),
-                           text(m_selectedIndex == 2 ? "> Exit" : "  Exit") | center |
-                               (m_selectedIndex == 2 ? color(Color::Yellow) | bold : color(Color::White)),
+                           renderEntry(3, MenuOption::ViewStats, "Statistics"),
+                           renderEntry(4, MenuOption::Exit, "Exit"),
                        }),
                        text("") | center,
                    }) |
@@ -57,12 +77,23 @@ Component MenuScreen::createComponent()
                     option = MenuOption::StartGame;
                     break;
                 case 1:
-                    option = MenuOption::ViewStats;
+                    option = MenuOption::ResumeGame;
                     break;
                 case 2:
+                    option = MenuOption::GhostRace;
+                    break;
+                case 3:
+                    option = MenuOption::ViewStats;
+                    break;
+                case 4:
                     option = MenuOption::Exit;
                     break;
                 }
+                // Options still waiting on their data stay on the menu
+                if (!statusOf(option).empty())
+                {
+                    return true;
+                }
                 if (m_onSelect)
                 {
                     m_onSelect(option);
@@ -3,25 +3,34 @@
 #include "BaseScreen.h"
 #include "ftxui/component/component.hpp"
 #include <functional>
+#include <string>
 #include <vector>
 
 class MenuScreen : public BaseScreen {
 public:
     enum class MenuOption {
         StartGame,
+        ResumeGame,
+        GhostRace,
         ViewStats,
         Exit
     };
     
-    explicit MenuScreen(std::function<void(MenuOption)> onSelect);
+    // Returns why an option can't be picked yet (e.g. "loading..."), empty when it can
+    using StatusProvider = std::function<std::string(MenuOption)>;
+
+    explicit MenuScreen(std::function<void(MenuOption)> onSelect, StatusProvider statusOf = nullptr);
     
     ftxui::Component createComponent() override;
     
 private:
     int m_selectedIndex = 0;
     std::function<void(MenuOption)> m_onSelect;
+    StatusProvider m_statusOf;
     std::vector<std::string> m_entries;
     
     ftxui::Element renderContent();
+    ftxui::Element renderEntry(int index, MenuOption option, const std::string& label);
+    std::string statusOf(MenuOption option) const;
 };
 
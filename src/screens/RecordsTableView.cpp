@@ -0,0 +1,397 @@
+#include "RecordsTableView.h"
+
+#include "ftxui/dom/table.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <iomanip>
+#include <limits>
+#include <optional>
+#include <sstream>
+
+using namespace ftxui;
+
+RecordsTableView::RecordsTableView(const RecordManager& recordManager, StatsWorker& statsWorker, int visibleRows)
+    : m_recordManager(recordManager)
+    , m_statsWorker(statsWorker)
+    , m_visibleRows(std::max(1, visibleRows))
+    , m_rowCache(kRowCacheCapacity)
+{
+    // Newest first, so the initial window only needs the latest shard
+    m_query.orderBy(Column::Date, false);
+    requestRows();
+}
+
+void RecordsTableView::requestRows()
+{
+    m_requestedGeneration = m_statsWorker.requestQuery(m_query);
+}
+
+bool RecordsTableView::hasCurrentRows() const
+{
+    return m_view && m_view->queryGeneration >= m_requestedGeneration;
+}
+
+void RecordsTableView::syncWithView()
+{
+    auto latest = m_statsWorker.getView();
+    if (!latest || latest == m_view)
+        return;
+
+    const bool rowsChanged = !m_view || latest->queryGeneration != m_view->queryGeneration ||
+                             latest->recordsVersion != m_view->recordsVersion;
+    m_view = std::move(latest);
+    if (m_cachedVersion != m_view->recordsVersion)
+    {
+        m_cachedVersion = m_view->recordsVersion;
+        m_rowCache.clear();
+    }
+
+    if (rowsChanged && hasCurrentRows())
+    {
+        m_topRow = std::min(m_topRow, maxTopRow());
+        applyPendingJump();
+    }
+}
+
+size_t RecordsTableView::rowCount() const
+{
+    return m_view ? m_view->rows.size() : 0;
+}
+
+size_t RecordsTableView::getRowCount()
+{
+    syncWithView();
+    return rowCount();
+}
+
+size_t RecordsTableView::maxTopRow() const
+{
+    const size_t visible = static_cast<size_t>(m_visibleRows);
+    return rowCount() > visible ? rowCount() - visible : 0;
+}
+
+void RecordsTableView::scrollBy(long long delta)
+{
+    syncWithView();
+    const long long target = static_cast<long long>(m_topRow) + delta;
+    m_topRow = static_cast<size_t>(std::clamp(target, 0LL, static_cast<long long>(maxTopRow())));
+    loadOlderIfAtEdge();
+}
+
+void RecordsTableView::scrollToTop()
+{
+    syncWithView();
+    m_topRow = 0;
+    loadOlderIfAtEdge();
+}
+
+void RecordsTableView::scrollToBottom()
+{
+    syncWithView();
+    m_topRow = maxTopRow();
+    loadOlderIfAtEdge();
+}
+
+void RecordsTableView::loadOlderIfAtEdge()
+{
+    if (!hasCurrentRows() || m_view->shards.fullyLoaded() || m_query.sortColumn != Column::Date)
+        return;
+    if (m_olderRequestedVersion == m_view->recordsVersion)
+        return;
+
+    const bool atOldest = m_query.ascending ? m_topRow == 0 : m_topRow >= maxTopRow();
+    if (atOldest)
+    {
+        m_olderRequestedVersion = m_view->recordsVersion;
+        m_statsWorker.requestOlderMonth();
+    }
+}
+
+void RecordsTableView::loadAllHistory()
+{
+    m_statsWorker.requestMonthsFrom("");
+}
+
+void RecordsTableView::sortBy(Column column)
+{
+    if (column == Column::Count)
+        return;
+
+    if (m_query.sortColumn == column)
+    {
+        m_query.ascending = !m_query.ascending;
+    }
+    else
+    {
+        // Numeric columns read best largest-first, dates newest-first
+        m_query.orderBy(column, false);
+    }
+    m_topRow = 0;
+    requestRows();
+}
+
+void RecordsTableView::setFilters(const RecordQuery& filters)
+{
+    if (filters.hasFilters())
+    {
+        // Date keys are YYYYMMDDhhmm, the shard month is the leading YYYYMM
+        const ColumnRange& dates = filters.ranges[static_cast<size_t>(Column::Date)];
+        std::string fromMonth;
+        if (dates.min > 0.0 && dates.min != std::numeric_limits<double>::infinity())
+        {
+            const auto yearMonth = static_cast<int64_t>(dates.min) / 1000000;
+            char month[16];
+            std::snprintf(month, sizeof(month), "%04d-%02d", static_cast<int>(yearMonth / 100), static_cast<int>(yearMonth % 100));
+            fromMonth = month;
+        }
+        m_statsWorker.requestMonthsFrom(fromMonth);
+    }
+
+    m_query.ranges = filters.ranges;
+    m_topRow = 0;
+    requestRows();
+}
+
+void RecordsTableView::jumpToRank(size_t rank)
+{
+    m_pendingJump = PendingJump{PendingJump::Kind::Rank, rank, {}};
+    syncWithView();
+    const bool partial = !m_view || !m_view->shards.fullyLoaded();
+    if (partial)
+    {
+        // Ranks are over the whole history
+        m_statsWorker.requestMonthsFrom("");
+    }
+    if (partial || m_query.sortColumn != Column::WPM || m_query.ascending)
+    {
+        m_query.orderBy(Column::WPM, false);
+        requestRows();
+    }
+    syncWithView();
+    if (hasCurrentRows())
+        applyPendingJump();
+}
+
+void RecordsTableView::jumpToDate(const std::string& datePrefix)
+{
+    // dateKey() would read anything else as the start of time
+    if (!isDatePrefix(datePrefix))
+    {
+        m_status = "Not a date: " + datePrefix;
+        return;
+    }
+    m_pendingJump = PendingJump{PendingJump::Kind::Date, 0, datePrefix};
+    const bool switchOrder = m_query.sortColumn != Column::Date;
+    if (switchOrder)
+    {
+        m_query.orderBy(Column::Date, true);
+    }
+    syncWithView();
+    const bool partial = !m_view || !m_view->shards.fullyLoaded();
+    if (partial)
+    {
+        // Ascending lands on or after the date, descending on or before it
+        m_statsWorker.requestMonthsFrom(m_query.ascending ? datePrefix.substr(0, 7) : "");
+    }
+    if (switchOrder || partial)
+    {
+        requestRows();
+    }
+    if (hasCurrentRows())
+        applyPendingJump();
+}
+
+void RecordsTableView::applyPendingJump()
+{
+    const PendingJump jump = std::move(m_pendingJump);
+    m_pendingJump = PendingJump{};
+    const auto& rows = m_view->rows;
+
+    if (jump.kind == PendingJump::Kind::Rank)
+    {
+        if (jump.rank == 0 || jump.rank > rows.size())
+        {
+            m_status = "No game with rank " + std::to_string(jump.rank);
+            return;
+        }
+        m_topRow = std::min(jump.rank - 1, maxTopRow());
+        m_status.clear();
+    }
+    else if (jump.kind == PendingJump::Kind::Date)
+    {
+        if (jump.datePrefix.empty())
+            return;
+
+        // Rows are already in date order, so the target is a binary search away
+        const bool ascending = m_view->query.ascending;
+        const int64_t boundKey = dateKey(jump.datePrefix, ascending ? '0' : '9');
+        const size_t row = m_recordManager.readStore(
+            [&](const RecordStore& store)
+            {
+                auto before = [&](uint32_t id)
+                {
+                    if (id >= store.size())
+                        return false;
+                    return ascending ? store.dateKeyAt(id) < boundKey : store.dateKeyAt(id) > boundKey;
+                };
+                return static_cast<size_t>(std::partition_point(rows.begin(), rows.end(), before) - rows.begin());
+            }
+        );
+
+        if (row >= rows.size())
+        {
+            m_status = (ascending ? "No games on or after " : "No games on or before ") + jump.datePrefix;
+            return;
+        }
+        m_topRow = std::min(row, maxTopRow());
+        m_status.clear();
+    }
+}
+
+const RecordsTableView::FormattedRow* RecordsTableView::formattedRow(uint32_t recordIndex)
+{
+    if (const FormattedRow* cached = m_rowCache.find(recordIndex))
+        return cached;
+
+    // Ids may briefly outrun the store while a reload is being published
+    auto row = m_recordManager.readStore(
+        [&](const RecordStore& store) -> std::optional<FormattedRow>
+        {
+            if (recordIndex >= store.size())
+                return std::nullopt;
+            return formatRow(store.get(recordIndex));
+        }
+    );
+    if (!row)
+        return nullptr;
+    return &m_rowCache.insert(recordIndex, std::move(*row));
+}
+
+RecordsTableView::FormattedRow RecordsTableView::formatRow(const GameRecord& record)
+{
+    int totalSeconds = static_cast<int>(record.survivalTime);
+    std::ostringstream time;
+    time << totalSeconds / 60 << ":" << std::setfill('0') << std::setw(2) << totalSeconds % 60;
+
+    std::ostringstream acc;
+    acc << std::fixed << std::setprecision(1) << record.accuracy << "%";
+
+    return {
+        std::to_string(record.wpm),
+        acc.str(),
+        time.str(),
+        std::to_string(record.maxCombo) + "x",
+        record.date,
+    };
+}
+
+const char* RecordsTableView::columnTitle(Column column)
+{
+    switch (column)
+    {
+    case Column::WPM:
+        return "WPM";
+    case Column::Accuracy:
+        return "Accuracy";
+    case Column::Survival:
+        return "Survival";
+    case Column::Combo:
+        return "Combo";
+    case Column::Date:
+    case Column::Count:
+        return "Date";
+    }
+    return "";
+}
+
+Element RecordsTableView::renderScrollbar() const
+{
+    const size_t count = rowCount();
+    if (count <= static_cast<size_t>(m_visibleRows))
+        return text("");
+
+    const size_t maxTop = maxTopRow();
+    const int thumb = static_cast<int>((m_topRow * static_cast<size_t>(m_visibleRows - 1) + maxTop / 2) / maxTop);
+
+    Elements track;
+    track.push_back(text(" ")); // Header row
+    for (int i = 0; i < m_visibleRows; ++i)
+    {
+        track.push_back(i == thumb ? text("┃") | color(Color::Yellow) : text("│") | color(Color::GrayDark));
+    }
+    return vbox(std::move(track));
+}
+
+Element RecordsTableView::render()
+{
+    syncWithView();
+    if (!m_view)
+        return text("Crunching statistics...") | center | dim;
+
+    const size_t count = rowCount();
+    if (count == 0)
+    {
+        return text(m_query.hasFilters() ? "No records match the filter" : "No records yet") | center | dim;
+    }
+
+    const size_t endRow = std::min(m_topRow + static_cast<size_t>(m_visibleRows), count);
+
+    std::vector<std::string> header;
+    for (size_t c = 0; c < static_cast<size_t>(Column::Count); ++c)
+    {
+        const auto column = static_cast<Column>(c);
+        std::string title = std::to_string(c + 1) + " " + columnTitle(column);
+        if (column == m_query.sortColumn)
+        {
+            title += m_query.ascending ? " ▲" : " ▼";
+        }
+        header.push_back(std::move(title));
+    }
+
+    std::vector<std::vector<std::string>> rows;
+    rows.reserve(endRow - m_topRow + 1);
+    rows.push_back(std::move(header));
+    for (size_t row = m_topRow; row < endRow; ++row)
+    {
+        if (const FormattedRow* cells = formattedRow(m_view->rows[row]))
+        {
+            rows.emplace_back(cells->begin(), cells->end());
+        }
+    }
+
+    Table table(std::move(rows));
+    table.SelectAll().DecorateCells(center);
+    table.SelectAll().DecorateCells(size(HEIGHT, GREATER_THAN, 1));
+
+    table.SelectAll().DecorateCells(size(WIDTH, GREATER_THAN, 6));
+    table.SelectRow(0).Decorate(bold | color(Color::YellowLight));
+
+    std::string summaryText = "Showing " + std::to_string(m_topRow + 1) + "-" + std::to_string(endRow) + " of " + std::to_string(count);
+    if (m_view->query.hasFilters())
+    {
+        std::ostringstream queryInfo;
+        queryInfo << std::fixed << std::setprecision(1) << m_view->queryMs;
+        summaryText += " (filtered from " + std::to_string(m_view->recordCount) + " in " + queryInfo.str() + " ms)";
+    }
+    if (!hasCurrentRows())
+    {
+        summaryText += " (updating...)";
+    }
+    const ShardStatus& shards = m_view->shards;
+    if (!shards.fullyLoaded())
+    {
+        summaryText += " | " + std::to_string(shards.loadedMonths) + "/" + std::to_string(shards.availableMonths) +
+                       " months loaded, L=Load all";
+    }
+    const Element summary = text(summaryText) | dim;
+
+    return vbox({
+        hbox({
+            filler(),
+            table.Render() | flex | size(WIDTH, GREATER_THAN, 0),
+            renderScrollbar(),
+            filler(),
+        }) | flex,
+        summary | center,
+    });
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "../managers/RecordManager.h"
+#include "../managers/StatsWorker.h"
+#include "../utils/LruCache.h"
+#include "ftxui/dom/elements.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Virtualized view over the game history. Only the visible window is ever
+// formatted, rows come from the RecordQuery that StatsWorker evaluates in the
+// background, and the formatted cells are kept in a small LRU so paging back
+// and forth is free. Scrolling past the oldest loaded game in date order asks
+// the worker to load the previous month's shard.
+class RecordsTableView
+{
+public:
+    using Column = RecordColumn;
+
+    RecordsTableView(const RecordManager& recordManager, StatsWorker& statsWorker, int visibleRows);
+
+    // Navigation
+    void scrollBy(long long delta);
+    void pageDown() { scrollBy(m_visibleRows); }
+    void pageUp() { scrollBy(-m_visibleRows); }
+    void scrollToTop();
+    void scrollToBottom();
+
+    // Pressing the active column again flips the direction
+    void sortBy(Column column);
+    // Jumps run once the worker has delivered rows in the needed order.
+    // Rank 1 is the highest WPM game, switches to WPM descending.
+    void jumpToRank(size_t rank);
+    // Takes "YYYY-MM" or "YYYY-MM-DD" (see isDatePrefix()), switches to date order
+    void jumpToDate(const std::string& datePrefix);
+    // Last jump failure, empty when the jump landed
+    const std::string& getStatus() const { return m_status; }
+
+    // Replaces the column filters, the current sort order is kept. Loads the
+    // shards the date range covers, or all of them without a date bound.
+    void setFilters(const RecordQuery& filters);
+    void loadAllHistory();
+    const RecordQuery& getQuery() const { return m_query; }
+
+    size_t getRowCount();
+    size_t getTopRow() const { return m_topRow; }
+    Column getSortColumn() const { return m_query.sortColumn; }
+    bool isAscending() const { return m_query.ascending; }
+
+    ftxui::Element render();
+
+private:
+    using FormattedRow = std::array<std::string, static_cast<size_t>(Column::Count)>;
+    static constexpr size_t kRowCacheCapacity = 256;
+
+    struct PendingJump
+    {
+        enum class Kind
+        {
+            None,
+            Rank,
+            Date
+        };
+        Kind kind = Kind::None;
+        size_t rank = 0;
+        std::string datePrefix;
+    };
+
+    const RecordManager& m_recordManager;
+    StatsWorker& m_statsWorker;
+    int m_visibleRows;
+    size_t m_topRow = 0;
+
+    RecordQuery m_query;
+    uint64_t m_requestedGeneration = 0;
+    std::shared_ptr<const StatsView> m_view; // Rows are m_view->rows
+    uint64_t m_cachedVersion = 0;
+    LruCache<uint32_t, FormattedRow> m_rowCache;
+    PendingJump m_pendingJump;
+    std::string m_status;
+    uint64_t m_olderRequestedVersion = 0; // Records version of the last older-month request
+
+    void requestRows();
+    void syncWithView();
+    bool hasCurrentRows() const;
+    size_t rowCount() const;
+    size_t maxTopRow() const;
+    void applyPendingJump();
+    // Requests the next older shard once the window touches the oldest loaded game
+    void loadOlderIfAtEdge();
+    const FormattedRow* formattedRow(uint32_t recordIndex);
+    ftxui::Element renderScrollbar() const;
+
+    static FormattedRow formatRow(const GameRecord& record);
+    static const char* columnTitle(Column column);
+};
@@ -1,9 +1,14 @@
 #include "ResultScreen.h"
+#include "FrameText.h"
+#include "../models/TypingSpeed.h"
 #include "ftxui/component/event.hpp"
 #include "ftxui/dom/elements.hpp"
-#include <iomanip>
-#include <sstream>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <string>
 #include <utility>
+#include <vector>
 
 using namespace ftxui;
 
@@ -19,6 +24,7 @@ Component ResultScreen::createComponent()
         component,
         [this]
         {
+            FrameArena::Frame frame;
             std::vector<Element> elements;
 
             elements.push_back(text(""));
@@ -33,6 +39,11 @@ Component ResultScreen::createComponent()
 
             elements.push_back(renderStats());
             elements.push_back(text(""));
+            if (!m_record.speedCurve.empty())
+            {
+                elements.push_back(renderSpeedCurve());
+                elements.push_back(text(""));
+            }
             elements.push_back(text("Press Enter to return to menu") | center | dim);
             elements.push_back(text(""));
 
@@ -71,35 +82,31 @@ Element ResultScreen::renderTitle()
 
 Element ResultScreen::renderStats()
 {
-    std::ostringstream accOss;
-    accOss << std::fixed << std::setprecision(1) << m_record.accuracy;
-
     // Format survival time
     int totalSeconds = static_cast<int>(m_record.survivalTime);
     int minutes = totalSeconds / 60;
     int seconds = totalSeconds % 60;
-    std::ostringstream timeOss;
-    timeOss << minutes << "m " << seconds << "s";
 
     return vbox({
         hbox({
             text("WPM: ") | bold,
             text(std::to_string(m_record.wpm)) | color(Color::Cyan) | bold,
+            m_record.rawWpm > 0 ? textf("  (raw %d)", m_record.rawWpm) | dim : text(""),
         }) | center,
         text(""),
         hbox({
             text("Survival Time: ") | bold,
-            text(timeOss.str()) | color(Color::Yellow) | bold,
+            textf("%dm %ds", minutes, seconds) | color(Color::Yellow) | bold,
         }) | center,
         text(""),
         hbox({
             text("Accuracy: ") | bold,
-            text(accOss.str() + "%") | color(Color::Green) | bold,
+            textf("%.1f%%", m_record.accuracy) | color(Color::Green) | bold,
         }) | center,
         text(""),
         hbox({
             text("Max Combo: ") | bold,
-            text(std::to_string(m_record.maxCombo) + "x") | color(Color::Red) | bold,
+            textf("%dx", m_record.maxCombo) | color(Color::Red) | bold,
         }) | center,
         text(""),
         hbox({
@@ -122,3 +129,43 @@ Element ResultScreen::renderNewRecordBadge()
         text("*** NEW RECORD! ***") | center | bold | color(Color::RedLight) | blink,
     });
 }
+
+Element ResultScreen::renderSpeedCurve()
+{
+    constexpr int kRows = 6;
+    constexpr size_t kMaxColumns = 48;
+    static constexpr std::array<const char*, 8> kBlocks = {"▁", "▂", "▃", "▄", "▅", "▆", "▇", "█"};
+
+    // Long games are averaged down to one column per few intervals
+    const auto& curve = m_record.speedCurve;
+    const size_t columns = std::min(curve.size(), kMaxColumns);
+    std::vector<double> values(columns, 0.0);
+    for (size_t c = 0; c < columns; ++c)
+    {
+        const size_t first = c * curve.size() / columns;
+        const size_t last = (c + 1) * curve.size() / columns;
+        for (size_t i = first; i < last; ++i)
+        {
+            values[c] += curve[i];
+        }
+        values[c] /= static_cast<double>(last - first);
+    }
+    const double peak = std::max(1.0, *std::max_element(values.begin(), values.end()));
+
+    Elements rows;
+    for (int row = kRows - 1; row >= 0; --row)
+    {
+        std::string line;
+        for (const double value : values)
+        {
+            const int eighths = std::clamp(static_cast<int>(std::lround(value / peak * kRows * 8)) - row * 8, 0, 8);
+            line += eighths == 0 ? " " : kBlocks[eighths - 1];
+        }
+        const Element axis = row == kRows - 1 ? textf("%4d ", static_cast<int>(std::lround(peak))) : (row == 0 ? text("   0 ") : text("     "));
+        rows.push_back(hbox({axis | dim, text(std::move(line)) | color(Color::Cyan)}));
+    }
+
+    const double secondsPerColumn = TypingSpeed::kIntervalSeconds * static_cast<double>(curve.size()) / static_cast<double>(columns);
+    rows.push_back(textf("WPM every %.0f s", secondsPerColumn) | dim | center);
+    return vbox(std::move(rows)) | center;
+}
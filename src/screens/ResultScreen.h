@@ -19,5 +19,6 @@ private:
     ftxui::Element renderTitle();
     ftxui::Element renderStats();
     ftxui::Element renderNewRecordBadge();
+    ftxui::Element renderSpeedCurve();
 };
 
@@ -0,0 +1,368 @@
+#include "SpectatorSink.h"
+#include "../utils/Trace.h"
+#include "ftxui/dom/node.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <filesystem>
+#include <utility>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace ftxui;
+
+namespace
+{
+enum CellStyle : uint16_t
+{
+    kBold = 1 << 0,
+    kDim = 1 << 1,
+    kItalic = 1 << 2,
+    kUnderlined = 1 << 3,
+    kBlink = 1 << 4,
+    kInverted = 1 << 5,
+    kStrikethrough = 1 << 6,
+    kUnderlinedDouble = 1 << 7,
+};
+
+// SGR parameter of each CellStyle bit, in bit order
+constexpr const char* kStyleCodes[] = {"1", "2", "3", "4", "5", "7", "9", "21"};
+
+// Cursor moves cost about as much as rewriting this many unchanged cells
+constexpr int kMaxRewriteGap = 3;
+
+uint16_t styleOf(const Pixel& pixel)
+{
+    uint16_t style = 0;
+    style |= pixel.bold ? kBold : 0;
+    style |= pixel.dim ? kDim : 0;
+    style |= pixel.italic ? kItalic : 0;
+    style |= pixel.underlined ? kUnderlined : 0;
+    style |= pixel.blink ? kBlink : 0;
+    style |= pixel.inverted ? kInverted : 0;
+    style |= pixel.strikethrough ? kStrikethrough : 0;
+    style |= pixel.underlined_double ? kUnderlinedDouble : 0;
+    return style;
+}
+
+void appendJsonEscaped(std::string& out, const std::string& text)
+{
+    for (char c : text)
+    {
+        const auto byte = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\')
+        {
+            out += '\\';
+            out += c;
+        }
+        else if (byte < 0x20)
+        {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", byte);
+            out += escaped;
+        }
+        else
+        {
+            out += c;
+        }
+    }
+}
+
+// Transparent wrapper around the root element that hands the finished
+// screen to the sink once everything below it has been drawn
+class CaptureNode : public Node
+{
+public:
+    CaptureNode(Element child, SpectatorSink& sink) : Node(Elements{std::move(child)}), m_sink(sink) {}
+
+    void ComputeRequirement() override
+    {
+        children_[0]->ComputeRequirement();
+        requirement_ = children_[0]->requirement();
+    }
+
+    void SetBox(Box box) override
+    {
+        Node::SetBox(box);
+        children_[0]->SetBox(box);
+    }
+
+    void Render(Screen& screen) override
+    {
+        Node::Render(screen);
+        m_sink.capture(screen);
+    }
+
+private:
+    SpectatorSink& m_sink;
+};
+} // namespace
+
+SpectatorSink::SpectatorSink(SpectatorOptions options) : m_options(std::move(options))
+{
+    m_options.queueDepth = std::max<size_t>(1, m_options.queueDepth);
+#ifdef SIGPIPE
+    // A viewer closing the FIFO must fail the write, not kill the game
+    std::signal(SIGPIPE, SIG_IGN);
+#endif
+    // One extra frame is always held by the writer as the diff base
+    for (size_t i = 0; i < m_options.queueDepth + 1; ++i)
+    {
+        m_free.push_back(std::make_unique<Frame>());
+    }
+    m_writer = std::thread([this] { run(); });
+}
+
+SpectatorSink::~SpectatorSink()
+{
+    stop();
+}
+
+Element SpectatorSink::decorate(Element root)
+{
+    return std::make_shared<CaptureNode>(std::move(root), *this);
+}
+
+void SpectatorSink::capture(const Screen& screen)
+{
+    TYPEIT_TRACE_SCOPE("SpectatorSink::capture");
+    const auto now = Clock::now();
+    if (m_options.maxFps > 0.0f && now - m_lastCapture < std::chrono::duration<float>(1.0f / m_options.maxFps))
+        return;
+
+    std::unique_ptr<Frame> frame;
+    {
+        std::lock_guard lock(m_mutex);
+        if (m_stopping)
+            return;
+        if (m_free.empty())
+        {
+            ++m_dropped;
+            return;
+        }
+        frame = std::move(m_free.back());
+        m_free.pop_back();
+    }
+    m_lastCapture = now;
+
+    frame->width = screen.dimx();
+    frame->height = screen.dimy();
+    frame->time = std::chrono::duration<double>(now - m_start).count();
+    frame->cells.resize(static_cast<size_t>(frame->width) * static_cast<size_t>(frame->height));
+    size_t i = 0;
+    for (int y = 0; y < frame->height; ++y)
+    {
+        for (int x = 0; x < frame->width; ++x)
+        {
+            const Pixel& pixel = screen.PixelAt(x, y);
+            Cell& cell = frame->cells[i++];
+            cell.glyph = pixel.character; // Reuses the recycled string's buffer
+            cell.foreground = pixel.foreground_color;
+            cell.background = pixel.background_color;
+            cell.style = styleOf(pixel);
+        }
+    }
+
+    {
+        std::lock_guard lock(m_mutex);
+        m_queue.push_back(std::move(frame));
+    }
+    m_ready.notify_one();
+}
+
+void SpectatorSink::stop()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true;
+    }
+    m_ready.notify_one();
+    if (m_writer.joinable())
+    {
+        m_writer.join();
+    }
+}
+
+void SpectatorSink::run()
+{
+    trace::setThreadName("spectator");
+    while (true)
+    {
+        std::unique_ptr<Frame> frame;
+        {
+            std::unique_lock lock(m_mutex);
+            m_ready.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+            if (m_queue.empty())
+                break;
+            frame = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+
+        writeFrame(*frame);
+
+        std::lock_guard lock(m_mutex);
+        if (m_previous)
+        {
+            m_free.push_back(std::move(m_previous));
+        }
+        m_previous = std::move(frame);
+    }
+    closeOutput();
+}
+
+std::FILE* SpectatorSink::openOutput()
+{
+#ifdef _WIN32
+    std::FILE* file = nullptr;
+    if (fopen_s(&file, m_options.path.c_str(), "wb") != 0)
+    {
+        m_failed = true;
+        return nullptr;
+    }
+    return file;
+#else
+    // A blocking open of a FIFO waits for a reader, and stop() would wait
+    // with it; without O_NONBLOCK no reader yet fails with ENXIO instead
+    const int fd = ::open(m_options.path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_NONBLOCK, 0644);
+    if (fd < 0)
+    {
+        m_failed = errno != ENXIO;
+        return nullptr;
+    }
+    // Writes block again, so a frame is never cut short by a full pipe
+    const int flags = fcntl(fd, F_GETFL, 0);
+    std::FILE* file = flags >= 0 && fcntl(fd, F_SETFL, flags & ~O_NONBLOCK) == 0 ? fdopen(fd, "w") : nullptr;
+    if (!file)
+    {
+        ::close(fd);
+        m_failed = true;
+    }
+    return file;
+#endif
+}
+
+void SpectatorSink::closeOutput()
+{
+    if (m_out)
+    {
+        std::fclose(m_out);
+        m_out = nullptr;
+    }
+}
+
+void SpectatorSink::writeFrame(const Frame& frame)
+{
+    TYPEIT_TRACE_SCOPE("SpectatorSink::writeFrame");
+    if (m_failed)
+        return;
+    const bool opened = !m_out;
+    if (opened)
+    {
+        // Tried again on every frame until a viewer opens the FIFO
+        m_out = openOutput();
+        if (!m_out)
+            return;
+        m_castStart = frame.time;
+        const auto timestamp = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        std::fprintf(m_out, "{\"version\": 2, \"width\": %d, \"height\": %d, \"timestamp\": %lld, \"title\": \"Typeit\", \"env\": {\"TERM\": \"xterm-256color\"}}\n",
+                     frame.width, frame.height, static_cast<long long>(timestamp));
+    }
+
+    // A new stream starts with a whole screen
+    const Frame* previous = opened ? nullptr : m_previous.get();
+    const bool full = !previous || previous->width != frame.width || previous->height != frame.height;
+    m_chunk.clear();
+    if (full)
+    {
+        if (previous)
+        {
+            writeEvent(frame.time - m_castStart, 'r', std::to_string(frame.width) + "x" + std::to_string(frame.height));
+        }
+        m_chunk += "\x1b[0m\x1b[2J\x1b[H";
+    }
+
+    const Cell* pen = nullptr;
+    for (int y = 0; y < frame.height; ++y)
+    {
+        const size_t row = static_cast<size_t>(y) * static_cast<size_t>(frame.width);
+        int cursorX = -1; // Unknown at the start of each row
+        for (int x = 0; x < frame.width; ++x)
+        {
+            const Cell& cell = frame.cells[row + x];
+            if (cell.glyph.empty() || (!full && cell == previous->cells[row + x]))
+                continue;
+
+            // Short runs of unchanged cells are rewritten rather than jumped over
+            bool rewrote = false;
+            if (cursorX >= 0 && x > cursorX && x - cursorX <= kMaxRewriteGap)
+            {
+                rewrote = std::none_of(frame.cells.begin() + row + cursorX, frame.cells.begin() + row + x, [](const Cell& c) { return c.glyph.empty(); });
+                for (int gap = cursorX; rewrote && gap < x; ++gap)
+                {
+                    appendCell(frame.cells[row + gap], pen);
+                }
+            }
+            if (!rewrote && cursorX != x)
+            {
+                m_chunk += "\x1b[" + std::to_string(y + 1) + ";" + std::to_string(x + 1) + "H";
+            }
+
+            appendCell(cell, pen);
+            // A wide glyph covers the empty cell after it
+            cursorX = x + ((x + 1 < frame.width && frame.cells[row + x + 1].glyph.empty()) ? 2 : 1);
+        }
+    }
+
+    if (!m_chunk.empty())
+    {
+        writeEvent(frame.time - m_castStart, 'o', m_chunk);
+    }
+    if (std::ferror(m_out))
+    {
+        // The viewer went away. A FIFO is reopened for the next one, which
+        // gets a cast of its own; a file that can't be written is given up.
+        closeOutput();
+        std::error_code error;
+        m_failed = !std::filesystem::is_fifo(m_options.path, error);
+        return;
+    }
+    ++m_written;
+}
+
+void SpectatorSink::writeEvent(double time, char kind, const std::string& data)
+{
+    char prefix[48];
+    std::snprintf(prefix, sizeof(prefix), "[%.6f, \"%c\", \"", time, kind);
+    std::string line = prefix;
+    appendJsonEscaped(line, data);
+    line += "\"]\n";
+    std::fwrite(line.data(), 1, line.size(), m_out);
+    // Live viewers on a FIFO see each frame as soon as it is written
+    std::fflush(m_out);
+}
+
+void SpectatorSink::appendCell(const Cell& cell, const Cell*& pen)
+{
+    if (!pen || pen->style != cell.style || pen->foreground != cell.foreground || pen->background != cell.background)
+    {
+        m_chunk += "\x1b[0";
+        for (size_t bit = 0; bit < std::size(kStyleCodes); ++bit)
+        {
+            if (cell.style & (1u << bit))
+            {
+                m_chunk += ';';
+                m_chunk += kStyleCodes[bit];
+            }
+        }
+        m_chunk += ';';
+        m_chunk += cell.foreground.Print(false);
+        m_chunk += ';';
+        m_chunk += cell.background.Print(true);
+        m_chunk += 'm';
+    }
+    m_chunk += cell.glyph;
+    pen = &cell;
+}
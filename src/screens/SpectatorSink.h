@@ -0,0 +1,103 @@
+#pragma once
+
+#include "ftxui/dom/elements.hpp"
+#include "ftxui/screen/color.hpp"
+#include "ftxui/screen/screen.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct SpectatorOptions
+{
+    std::string path;      // asciinema v2 cast file, or a FIFO for live viewing
+    float maxFps = 30.0f;  // Frames closer together than this are skipped
+    size_t queueDepth = 8; // Frames waiting for the writer before new ones are dropped
+};
+
+// Streams what the player sees as an asciinema v2 cast. capture() copies the
+// rendered cells on the UI thread, which is all it does there; a writer
+// thread diffs each frame against the previous one and emits only the cells
+// that changed. The queue between them is bounded and capture() never
+// waits: when the consumer falls behind (a slow FIFO reader), frames are
+// dropped and the next one written carries every change since. A FIFO is
+// opened without waiting for a viewer: until one has it open, frames are
+// discarded, and when a viewer leaves, the next one gets a cast of its own.
+// A viewer that keeps the FIFO open but stops reading still stalls the
+// writer thread, and stop() with it, once the pipe fills.
+class SpectatorSink
+{
+public:
+    explicit SpectatorSink(SpectatorOptions options);
+    ~SpectatorSink();
+
+    SpectatorSink(const SpectatorSink&) = delete;
+    SpectatorSink& operator=(const SpectatorSink&) = delete;
+
+    // Wraps the root element so every drawn frame is captured from the real screen
+    ftxui::Element decorate(ftxui::Element root);
+    void capture(const ftxui::Screen& screen);
+    void stop();
+
+    uint64_t framesWritten() const { return m_written.load(); }
+    uint64_t framesDropped() const { return m_dropped.load(); }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Cell
+    {
+        std::string glyph; // Empty for the second column of a wide character
+        ftxui::Color foreground;
+        ftxui::Color background;
+        uint16_t style = 0;
+
+        bool operator==(const Cell& other) const
+        {
+            return glyph == other.glyph && style == other.style && foreground == other.foreground && background == other.background;
+        }
+    };
+
+    struct Frame
+    {
+        int width = 0;
+        int height = 0;
+        double time = 0.0; // Seconds since the cast started
+        std::vector<Cell> cells;
+    };
+
+    SpectatorOptions m_options;
+    Clock::time_point m_start = Clock::now();
+    Clock::time_point m_lastCapture;
+    std::atomic<uint64_t> m_written = 0;
+    std::atomic<uint64_t> m_dropped = 0;
+
+    std::mutex m_mutex;
+    std::condition_variable m_ready;
+    std::deque<std::unique_ptr<Frame>> m_queue; // Captured, waiting for the writer
+    std::vector<std::unique_ptr<Frame>> m_free; // Recycled so steady-state capture doesn't allocate
+    bool m_stopping = false;
+    std::thread m_writer;
+
+    // Writer thread state
+    std::unique_ptr<Frame> m_previous;
+    std::FILE* m_out = nullptr;
+    bool m_failed = false;    // The file could not be opened or written; frames are discarded
+    double m_castStart = 0.0; // Time of the open cast's first frame, which every event is relative to
+    std::string m_chunk;
+
+    void run();
+    // Null when the file can't be opened yet: a FIFO nobody is reading
+    std::FILE* openOutput();
+    void closeOutput();
+    void writeFrame(const Frame& frame);
+    void writeEvent(double time, char kind, const std::string& data);
+    void appendCell(const Cell& cell, const Cell*& pen);
+};
@@ -1,4 +1,5 @@
 #include "StatsScreen.h"
+#include "FrameText.h"
 
 #include "ftxui/component/component.hpp"
 #include "ftxui/component/event.hpp"
@@ -7,16 +8,20 @@
 #include "ftxui/dom/elements.hpp"
 #include "ftxui/dom/table.hpp"
 #include <algorithm>
+#include <cctype>
 #include <cmath>
-#include <iomanip>
 #include <limits>
-#include <sstream>
 #include <utility>
 
 using namespace ftxui;
 
-StatsScreen::StatsScreen(RecordManager& recordManager, std::function<void()> onClose)
-    : m_recordManager(recordManager), m_onClose(std::move(onClose))
+StatsScreen::StatsScreen(RecordManager& recordManager, StatsWorker& statsWorker, std::function<void()> onClose,
+                         std::function<void()> onShowAnalytics)
+    : m_recordManager(recordManager)
+    , m_statsWorker(statsWorker)
+    , m_onClose(std::move(onClose))
+    , m_onShowAnalytics(std::move(onShowAnalytics))
+    , m_table(recordManager, statsWorker, kTableVisibleRows)
 {}
 
 void StatsScreen::onEnter() {}
@@ -30,25 +35,13 @@ Component StatsScreen::createComponent()
 
     auto tableRenderer = Renderer([this] { return renderRecordsTable(); });
 
-    SliderOption<float> sliderOption;
-    sliderOption.value = &m_tableScrollRatio;
-    sliderOption.min = 0.0f;
-    sliderOption.max = 1.0f;
-    sliderOption.increment = 0.05f;
-    sliderOption.direction = Direction::Down;
-    sliderOption.color_active = Color::Yellow;
-    sliderOption.color_inactive = Color::GrayDark;
-    sliderOption.on_change = [this]() { m_tableScrollRatio = std::clamp(m_tableScrollRatio, 0.0f, 1.0f); };
-    auto sliderComponent = Slider(sliderOption);
-
     // Main scroll container for the entire content
     auto contentRenderer = Renderer(
-        [this, toggleComponent, tableRenderer, sliderComponent]
+        [this, toggleComponent, tableRenderer]
         {
-            auto tableSection = hbox({
-                tableRenderer->Render() | flex,
-                sliderComponent->Render() | size(WIDTH, EQUAL, 3),
-            });
+            // Aggregates are precomputed by StatsWorker, rendering only reads them
+            FrameArena::Frame frame;
+            const auto view = m_statsWorker.getView();
 
             return vbox({
                 text("") | center,
@@ -56,24 +49,23 @@ Component StatsScreen::createComponent()
                 text("|                       STATISTICS                              |") | center | bold | color(Color::Cyan),
                 text("+===============================================================+") | center | bold,
                 text(""),
-                renderBestRecords(),
+                renderBestRecords(view),
                 text(""),
                 separator(),
-                renderTrendSection(toggleComponent),
+                renderTrendSection(toggleComponent, view),
                 text(""),
-                tableSection | flex,
+                tableRenderer->Render() | flex,
+                renderPrompt(),
                 text(""),
-                text("Controls: Enter/Esc=Back | P=Toggle Points | A=Toggle Avg | PgUp/PgDn/J/K=Scroll") | center | dim,
+                text("Controls: Enter/Esc=Back | P=Toggle Points | A=Toggle Avg | PgUp/PgDn/J/K/Home/End=Scroll") | center | dim,
+                text("1-5=Sort by column | /=Jump to date or #rank | F=Filter | X=Clear filter | L=Load all history | H=Key heatmaps") | center | dim,
             });
         }
     );
 
     auto composite = Container::Vertical({
         toggleComponent,
-        Container::Horizontal({
-            tableRenderer,
-            sliderComponent,
-        }),
+        tableRenderer,
     });
 
     // Wrap in yframe for vertical scrolling when terminal is too small
@@ -82,6 +74,11 @@ Component StatsScreen::createComponent()
     renderer |= CatchEvent(
         [this](Event event)
         {
+            if (m_promptMode != PromptMode::None)
+            {
+                return handlePromptEvent(event);
+            }
+
             if (event == Event::Return || event == Event::Escape)
             {
                 if (m_onClose)
@@ -102,25 +99,71 @@ Component StatsScreen::createComponent()
                 return true;
             }
 
-            auto applyScrollDelta = [this](float delta)
+            if (event == Event::Character('/'))
             {
-                if (m_tableTotalRows <= kTableVisibleRows)
+                openPrompt(PromptMode::Jump, "");
+                return true;
+            }
+            if (event == Event::Character('f') || event == Event::Character('F'))
+            {
+                openPrompt(PromptMode::Filter, m_table.getQuery().describeFilters());
+                return true;
+            }
+            if (event == Event::Character('l') || event == Event::Character('L'))
+            {
+                m_table.loadAllHistory();
+                return true;
+            }
+            if (event == Event::Character('x') || event == Event::Character('X'))
+            {
+                m_table.setFilters(RecordQuery{});
+                m_promptStatus.clear();
+                return true;
+            }
+            if ((event == Event::Character('h') || event == Event::Character('H')) && m_onShowAnalytics)
+            {
+                m_onShowAnalytics();
+                return true;
+            }
+
+            if (event.is_character() && event.character().size() == 1)
+            {
+                const char c = event.character()[0];
+                if (c >= '1' && c <= '5')
                 {
-                    m_tableScrollRatio = 0.0f;
-                    return false;
+                    m_table.sortBy(static_cast<RecordsTableView::Column>(c - '1'));
+                    return true;
                 }
-                m_tableScrollRatio = std::clamp(m_tableScrollRatio + delta, 0.0f, 1.0f);
-                return true;
-            };
+            }
 
-            if (event == Event::PageDown || event == Event::Character('j') || event == Event::ArrowDown)
+            if (event == Event::PageDown)
+            {
+                m_table.pageDown();
+                return true;
+            }
+            if (event == Event::PageUp)
             {
-                applyScrollDelta(0.15f);
+                m_table.pageUp();
                 return true;
             }
-            if (event == Event::PageUp || event == Event::Character('k') || event == Event::ArrowUp)
+            if (event == Event::Character('j') || event == Event::ArrowDown)
             {
-                applyScrollDelta(-0.15f);
+                m_table.scrollBy(1);
+                return true;
+            }
+            if (event == Event::Character('k') || event == Event::ArrowUp)
+            {
+                m_table.scrollBy(-1);
+                return true;
+            }
+            if (event == Event::Home || event == Event::Character('g'))
+            {
+                m_table.scrollToTop();
+                return true;
+            }
+            if (event == Event::End || event == Event::Character('G'))
+            {
+                m_table.scrollToBottom();
                 return true;
             }
 
@@ -131,34 +174,34 @@ Component StatsScreen::createComponent()
     return renderer;
 }
 
-Element StatsScreen::renderBestRecords()
+Element StatsScreen::renderBestRecords(const std::shared_ptr<const StatsView>& view)
 {
-    auto bestRecord = m_recordManager.getBestRecord();
-    auto longestRecord = m_recordManager.getLongestSurvivalRecord();
+    if (!view)
+    {
+        return vbox({
+            text("Best Records:") | bold | color(Color::Yellow),
+            text(""),
+            text("  Crunching statistics...") | dim,
+        });
+    }
+
+    const auto& bestRecord = view->bestRecord;
+    const auto& longestRecord = view->longestRecord;
 
-    auto formatWPMRecord = [](const GameRecord& rec) -> std::string
+    auto wpmRecordText = [](const GameRecord& rec)
     {
         if (rec.wpm == 0)
-            return "No records yet";
-
-        std::ostringstream oss;
-        oss << "WPM " << rec.wpm << "  Accuracy " << std::fixed << std::setprecision(1) << rec.accuracy << "%  Combo " << rec.maxCombo
-            << "x";
-        return oss.str();
+            return text("No records yet");
+        return textf("WPM %d  Accuracy %.1f%%  Combo %dx", rec.wpm, rec.accuracy, rec.maxCombo);
     };
 
-    auto formatTimeRecord = [](const GameRecord& rec) -> std::string
+    auto timeRecordText = [](const GameRecord& rec)
     {
         if (rec.survivalTime <= 0.0f)
-            return "No records yet";
+            return text("No records yet");
 
         int totalSeconds = static_cast<int>(rec.survivalTime);
-        int minutes = totalSeconds / 60;
-        int seconds = totalSeconds % 60;
-
-        std::ostringstream oss;
-        oss << minutes << "m " << seconds << "s  WPM " << rec.wpm << "  Combo " << rec.maxCombo << "x";
-        return oss.str();
+        return textf("%dm %ds  WPM %d  Combo %dx", totalSeconds / 60, totalSeconds % 60, rec.wpm, rec.maxCombo);
     };
 
     return vbox({
@@ -166,16 +209,37 @@ Element StatsScreen::renderBestRecords()
         text(""),
         hbox({
             text("  Highest WPM:      ") | bold,
-            text(formatWPMRecord(bestRecord)) | (bestRecord.wpm > 0 ? color(Color::Green) : dim),
+            wpmRecordText(bestRecord) | (bestRecord.wpm > 0 ? color(Color::Green) : dim),
         }),
         hbox({
             text("  Longest Survival: ") | bold,
-            text(formatTimeRecord(longestRecord)) | (longestRecord.survivalTime > 0.0f ? color(Color::Cyan) : dim),
+            timeRecordText(longestRecord) | (longestRecord.survivalTime > 0.0f ? color(Color::Cyan) : dim),
+        }),
+        hbox({
+            text("  Games Played:     ") | bold,
+            text(std::string(formatActivity(*view))),
         }),
     });
 }
 
-Element StatsScreen::renderTrendSection(const Component& toggleComponent)
+std::string_view StatsScreen::formatActivity(const StatsView& view)
+{
+    FrameArena& arena = FrameArena::local();
+    auto formatBucket = [&arena](const char* label, const RollupBucket& bucket)
+    {
+        if (bucket.count == 0)
+            return arena.format("%s 0", label);
+        return arena.format("%s %d (avg %.0f WPM)", label, bucket.count, bucket.meanWpm());
+    };
+
+    const std::string_view today = formatBucket("Today", view.today);
+    const std::string_view week = formatBucket("Week", view.thisWeek);
+    const std::string_view month = formatBucket("Month", view.thisMonth);
+    return arena.format("%d total  %.*s  %.*s  %.*s", view.allTimeGames, static_cast<int>(today.size()), today.data(),
+                        static_cast<int>(week.size()), week.data(), static_cast<int>(month.size()), month.data());
+}
+
+Element StatsScreen::renderTrendSection(const Component& toggleComponent, const std::shared_ptr<const StatsView>& view)
 {
     auto controls = hbox({
                         toggleComponent->Render() | center,
@@ -187,58 +251,25 @@ Element StatsScreen::renderTrendSection(const Component& toggleComponent)
         text(""),
         vbox({
 
-            renderTrendCanvas() | flex, controls
+            renderTrendCanvas(view) | flex, controls
         }),
     });
 }
 
-Element StatsScreen::renderTrendCanvas()
+Element StatsScreen::renderTrendCanvas(const std::shared_ptr<const StatsView>& view)
 {
-    auto records = m_recordManager.getAllRecords();
-    if (records.empty())
+    if (!view || view->trendWpm.empty())
     {
-        return text("No data yet") | center | dim | flex;
+        return text(view ? "No data yet" : "Crunching statistics...") | center | dim | flex;
     }
 
-    const int pointCount = static_cast<int>(records.size());
+    // Published views are immutable, so the draw lambda can hold on to this one
+    std::shared_ptr<const StatsView> data = view;
+    const int pointCount = static_cast<int>(data->trendWpm.size());
     const int width = std::max(kTrendCanvasMinWidth, pointCount);
     const int height = kTrendCanvasHeight;
-
-    double minWPM = std::numeric_limits<double>::max();
-    double maxWPM = std::numeric_limits<double>::lowest();
-    for (const auto& record : records)
-    {
-        minWPM = std::min(minWPM, static_cast<double>(record.wpm));
-        maxWPM = std::max(maxWPM, static_cast<double>(record.wpm));
-    }
-    if (maxWPM - minWPM < 5.0)
-    {
-        maxWPM += 5.0;
-        minWPM = std::max(0.0, maxWPM - 20.0);
-    }
-
-    // Calculate moving average
-    std::vector<double> movingAverage(pointCount, 0.0);
-    const int window = 50;
-    double sum = 0.0;
-    for (int i = 0; i < pointCount; ++i)
-    {
-        sum += records[i].wpm;
-        if (i >= window)
-        {
-            sum -= records[i - window].wpm;
-        }
-        int divisor = std::min(window, i + 1);
-        movingAverage[i] = sum / divisor;
-    }
-
-    // Extract WPM data for lambda capture (avoid capturing entire records)
-    std::vector<int> wpmData;
-    wpmData.reserve(pointCount);
-    for (const auto& r : records)
-    {
-        wpmData.push_back(r.wpm);
-    }
+    const double minWPM = data->trendMin;
+    const double maxWPM = data->trendMax;
 
     bool showPoints = m_showTrendPoints;
     bool showMA = m_showMovingAverage;
@@ -272,7 +303,7 @@ Element StatsScreen::renderTrendCanvas()
                        for (int i = 0; i < pointCount; ++i)
                        {
                            int x = normalizeX(i);
-                           int y = normalizeY(wpmData[i]);
+                           int y = normalizeY(data->trendWpm[i]);
                            c.DrawPoint(x, y, true, Color::YellowLight);
                        }
                    }
@@ -282,9 +313,9 @@ Element StatsScreen::renderTrendCanvas()
                        for (int i = 1; i < pointCount; ++i)
                        {
                            int x1 = normalizeX(i - 1);
-                           int y1 = normalizeY(movingAverage[i - 1]);
+                           int y1 = normalizeY(data->movingAverage[i - 1]);
                            int x2 = normalizeX(i);
-                           int y2 = normalizeY(movingAverage[i]);
+                           int y2 = normalizeY(data->movingAverage[i]);
                            c.DrawPointLine(x1, y1, x2, y2, Color::Cyan);
                        }
                    }
@@ -294,63 +325,130 @@ Element StatsScreen::renderTrendCanvas()
 }
 Element StatsScreen::renderRecordsTable()
 {
-    auto records = m_recordManager.getAllRecords();
-    if (records.empty())
-        return text("No records yet") | center | dim;
+    return m_table.render();
+}
 
-    m_tableTotalRows = static_cast<int>(records.size());
-    const int maxStart = std::max(0, m_tableTotalRows - kTableVisibleRows);
-    if (maxStart == 0)
-        m_tableScrollRatio = 0.0f;
-    else
-        m_tableScrollRatio = std::clamp(m_tableScrollRatio, 0.0f, 1.0f);
+Element StatsScreen::renderPrompt()
+{
+    if (m_promptMode != PromptMode::None)
+    {
+        const char* label = m_promptMode == PromptMode::Jump ? "Jump to (YYYY-MM[-DD] or #rank): " : "Filter (wpm>=40 acc=90..100 time>=60 date=2025-01..2025-03): ";
+        return hbox({
+                   text(label) | bold,
+                   text(m_promptInput) | color(Color::Cyan),
+                   text("_") | blink,
+               }) |
+               center;
+    }
+    if (!m_promptStatus.empty())
+    {
+        return text(m_promptStatus) | center | color(Color::Yellow);
+    }
+    if (!m_table.getStatus().empty())
+    {
+        return text(m_table.getStatus()) | center | color(Color::Yellow);
+    }
+    if (m_table.getQuery().hasFilters())
+    {
+        return text("Filter: " + m_table.getQuery().describeFilters()) | center | color(Color::Cyan);
+    }
+    return text("");
+}
 
-    const int startIndex = (maxStart == 0) ? 0 : static_cast<int>(std::round(m_tableScrollRatio * maxStart));
-    const int endIndex = std::min(startIndex + kTableVisibleRows, m_tableTotalRows);
+void StatsScreen::openPrompt(PromptMode mode, std::string initialInput)
+{
+    m_promptMode = mode;
+    m_promptInput = std::move(initialInput);
+    m_promptStatus.clear();
+}
 
-    auto formatTime = [](float seconds) -> std::string
+bool StatsScreen::handlePromptEvent(const Event& event)
+{
+    if (event == Event::Escape)
     {
-        int totalSeconds = static_cast<int>(seconds);
-        int mins = totalSeconds / 60;
-        int secs = totalSeconds % 60;
-        std::ostringstream oss;
-        oss << mins << ":" << std::setfill('0') << std::setw(2) << secs;
-        return oss.str();
-    };
-
-    std::vector<std::vector<std::string>> rows;
-    rows.push_back({"WPM", "Accuracy", "Survival", "Combo", "Date"});
-    for (int i = startIndex; i < endIndex; ++i)
+        m_promptMode = PromptMode::None;
+        return true;
+    }
+    if (event == Event::Return)
     {
-        const auto& rec = records[i];
-        std::ostringstream acc;
-        acc << std::fixed << std::setprecision(1) << rec.accuracy << "%";
-        rows.push_back({
-            std::to_string(rec.wpm),
-            acc.str(),
-            formatTime(rec.survivalTime),
-            std::to_string(rec.maxCombo) + "x",
-            rec.date,
-        });
+        const PromptMode mode = m_promptMode;
+        m_promptMode = PromptMode::None;
+        if (mode == PromptMode::Jump)
+            applyJump();
+        else
+            applyFilter();
+        return true;
+    }
+    if (event == Event::Backspace)
+    {
+        if (!m_promptInput.empty())
+        {
+            m_promptInput.pop_back();
+        }
+        return true;
     }
+    if (event.is_character())
+    {
+        const std::string ch = event.character();
+        if (ch.size() == 1 && std::isprint(static_cast<unsigned char>(ch[0])))
+        {
+            m_promptInput += ch;
+        }
+        return true;
+    }
+    // Swallow everything else so typing doesn't leak into the screen shortcuts
+    return true;
+}
 
-    Table table(rows);
-    table.SelectAll().DecorateCells(center);
-    table.SelectAll().DecorateCells(size(HEIGHT, GREATER_THAN, 1));
+void StatsScreen::applyJump()
+{
+    m_promptStatus.clear();
+    if (m_promptInput.empty())
+        return;
+
+    if (m_promptInput[0] == '#')
+    {
+        const std::string digits = m_promptInput.substr(1);
+        const bool allDigits =
+            !digits.empty() && std::all_of(digits.begin(), digits.end(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)) != 0; });
+        if (!allDigits)
+        {
+            m_promptStatus = "Not a rank: " + m_promptInput;
+            return;
+        }
+
+        size_t rank = 0;
+        try
+        {
+            rank = static_cast<size_t>(std::stoull(digits));
+        }
+        catch (...)
+        {
+            m_promptStatus = "No game with rank " + digits;
+            return;
+        }
+        m_table.jumpToRank(rank);
+        return;
+    }
 
-    table.SelectAll().DecorateCells(size(WIDTH, GREATER_THAN, 6));
-    table.SelectRow(0).Decorate(bold | color(Color::YellowLight));
+    if (!isDatePrefix(m_promptInput))
+    {
+        m_promptStatus = "Not a date: " + m_promptInput + " (use YYYY-MM or YYYY-MM-DD)";
+        return;
+    }
+    m_table.jumpToDate(m_promptInput);
+}
 
-    const Element summary =
-        text("Showing " + std::to_string(startIndex + 1) + "-" + std::to_string(endIndex) + " of " + std::to_string(m_tableTotalRows)) |
-        dim;
+void StatsScreen::applyFilter()
+{
+    RecordQuery query = m_table.getQuery();
+    std::string error;
+    if (!RecordQuery::parseFilters(m_promptInput, query, error))
+    {
+        m_promptStatus = error;
+        return;
+    }
 
-    return vbox({
-        hbox({
-            filler(),
-            table.Render() | flex | size(WIDTH, GREATER_THAN, 0),
-            filler(),
-        }) | flex,
-        summary | center,
-    });
-}
\ No newline at end of file
+    m_table.setFilters(query);
+    m_promptStatus.clear();
+}
@@ -1,33 +1,61 @@
 #pragma once
 
 #include "BaseScreen.h"
+#include "RecordsTableView.h"
 #include "../managers/RecordManager.h"
+#include "../managers/StatsWorker.h"
 #include "ftxui/component/component.hpp"
 #include "ftxui/component/component_options.hpp"
+#include "ftxui/component/event.hpp"
 #include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
 
 class StatsScreen : public BaseScreen
 {
 public:
-    StatsScreen(RecordManager& recordManager, std::function<void()> onClose);
+    StatsScreen(RecordManager& recordManager, StatsWorker& statsWorker, std::function<void()> onClose,
+                std::function<void()> onShowAnalytics = nullptr);
 
     ftxui::Component createComponent() override;
     void onEnter() override;
 
 private:
     RecordManager& m_recordManager;
+    StatsWorker& m_statsWorker;
     std::function<void()> m_onClose;
+    std::function<void()> m_onShowAnalytics;
     bool m_showTrendPoints = true;
     bool m_showMovingAverage = true;
-    float m_tableScrollRatio = 0.0f;
-    int m_tableTotalRows = 0;
     static constexpr int kTableVisibleRows = 12;
+    RecordsTableView m_table;
+
+    // Single-line prompt under the table. Jump takes "#<rank>" or a date
+    // prefix such as "2025-03-14", Filter takes RecordQuery filter terms.
+    enum class PromptMode
+    {
+        None,
+        Jump,
+        Filter
+    };
+    PromptMode m_promptMode = PromptMode::None;
+    std::string m_promptInput;
+    std::string m_promptStatus;
     static constexpr int kToggleBoxWidth = 28;
     static constexpr int kTrendCanvasMinWidth = 60;
     static constexpr int kTrendCanvasHeight = 12;
 
-    ftxui::Element renderBestRecords();
-    ftxui::Element renderTrendSection(const ftxui::Component& toggleComponent);
-    ftxui::Element renderTrendCanvas();
+    ftxui::Element renderBestRecords(const std::shared_ptr<const StatsView>& view);
+    // One line of rollup figures: all-time, today, this week and this month,
+    // valid until the frame ends
+    static std::string_view formatActivity(const StatsView& view);
+    ftxui::Element renderTrendSection(const ftxui::Component& toggleComponent, const std::shared_ptr<const StatsView>& view);
+    ftxui::Element renderTrendCanvas(const std::shared_ptr<const StatsView>& view);
     ftxui::Element renderRecordsTable();
+    ftxui::Element renderPrompt();
+    bool handlePromptEvent(const ftxui::Event& event);
+    void openPrompt(PromptMode mode, std::string initialInput);
+    void applyJump();
+    void applyFilter();
 };
@@ -0,0 +1,64 @@
+#include "WordField.h"
+#include "ftxui/dom/node.hpp"
+#include "ftxui/dom/requirement.hpp"
+#include <utility>
+
+using namespace ftxui;
+
+namespace
+{
+class WordFieldNode : public Node
+{
+public:
+    explicit WordFieldNode(std::function<void(WordField&)> draw) : m_draw(std::move(draw)) {}
+
+    void ComputeRequirement() override
+    {
+        requirement_ = Requirement{};
+        requirement_.flex_grow_x = 1;
+        requirement_.flex_grow_y = 1;
+        requirement_.flex_shrink_x = 1;
+        requirement_.flex_shrink_y = 1;
+    }
+
+    void Render(Screen& screen) override
+    {
+        if (Box::Intersection(box_, screen.stencil).IsEmpty() || !m_draw)
+            return;
+        // Coordinates stay relative to the full box, so a partly hidden field
+        // doesn't shift its words
+        WordField field(screen, box_);
+        m_draw(field);
+    }
+
+private:
+    std::function<void(WordField&)> m_draw;
+};
+} // namespace
+
+WordField::WordField(Screen& screen, const Box& box) : m_screen(screen), m_box(box) {}
+
+void WordField::drawText(int x, int y, std::string_view text, const Color& color, bool dim)
+{
+    const int row = m_box.y_min + y;
+    if (y < 0 || row > m_box.y_max)
+        return;
+
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+        const int column = m_box.x_min + x + static_cast<int>(i);
+        if (column < m_box.x_min || column > m_box.x_max || !m_screen.stencil.Contain(column, row))
+            continue;
+
+        // One byte strings stay in the small buffer, so this doesn't allocate
+        Pixel& pixel = m_screen.PixelAt(column, row);
+        pixel.character.assign(1, text[i]);
+        pixel.foreground_color = color;
+        pixel.dim = dim;
+    }
+}
+
+Element wordField(std::function<void(WordField&)> draw)
+{
+    return std::make_shared<WordFieldNode>(std::move(draw));
+}
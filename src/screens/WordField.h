@@ -0,0 +1,31 @@
+#pragma once
+
+#include "ftxui/dom/elements.hpp"
+#include "ftxui/screen/box.hpp"
+#include "ftxui/screen/color.hpp"
+#include "ftxui/screen/screen.hpp"
+#include <functional>
+#include <string_view>
+
+// Character-cell drawing surface for the game field. Text goes straight into
+// the screen cells of the element's box, with no canvas buffer or braille
+// conversion in between, so the cost of a frame is just the glyphs drawn.
+class WordField
+{
+public:
+    WordField(ftxui::Screen& screen, const ftxui::Box& box);
+
+    // In character cells
+    int width() const { return m_box.x_max - m_box.x_min + 1; }
+    int height() const { return m_box.y_max - m_box.y_min + 1; }
+
+    // ASCII text at cell (x, y) of the field, clipped at its edges
+    void drawText(int x, int y, std::string_view text, const ftxui::Color& color, bool dim = false);
+
+private:
+    ftxui::Screen& m_screen;
+    ftxui::Box m_box; // The element's whole box; cells outside the stencil are skipped
+};
+
+// Element filling the space it is given; draw is called on every render
+ftxui::Element wordField(std::function<void(WordField&)> draw);
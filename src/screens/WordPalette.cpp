@@ -0,0 +1,111 @@
+#include "WordPalette.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+
+using namespace ftxui;
+
+namespace
+{
+struct Rgb
+{
+    int r, g, b;
+};
+
+int distance(const Rgb& a, const Rgb& b)
+{
+    const int dr = a.r - b.r, dg = a.g - b.g, db = a.b - b.b;
+    return dr * dr + dg * dg + db * db;
+}
+
+// xterm's usual values for the 16 basic colours
+constexpr Rgb kBasicColors[16] = {
+    {0, 0, 0},       {205, 0, 0}, {0, 205, 0}, {205, 205, 0}, {0, 0, 238},   {205, 0, 205}, {0, 205, 205}, {229, 229, 229},
+    {127, 127, 127}, {255, 0, 0}, {0, 255, 0}, {255, 255, 0}, {92, 92, 255}, {255, 0, 255}, {0, 255, 255}, {255, 255, 255},
+};
+
+Color nearest16(const Rgb& rgb)
+{
+    int best = 0;
+    int bestDistance = std::numeric_limits<int>::max();
+    for (int i = 0; i < 16; ++i)
+    {
+        const int d = distance(rgb, kBasicColors[i]);
+        if (d < bestDistance)
+        {
+            best = i;
+            bestDistance = d;
+        }
+    }
+    return Color(static_cast<Color::Palette16>(best));
+}
+
+// Nearest of the 6x6x6 cube (16-231) and the grey ramp (232-255)
+Color nearest256(const Rgb& rgb)
+{
+    constexpr int kLevels[6] = {0, 95, 135, 175, 215, 255};
+    auto cubeIndex = [&](int value)
+    {
+        int best = 0;
+        for (int i = 1; i < 6; ++i)
+        {
+            if (std::abs(kLevels[i] - value) < std::abs(kLevels[best] - value))
+                best = i;
+        }
+        return best;
+    };
+    const int r = cubeIndex(rgb.r), g = cubeIndex(rgb.g), b = cubeIndex(rgb.b);
+    const Rgb cube{kLevels[r], kLevels[g], kLevels[b]};
+
+    const int average = (rgb.r + rgb.g + rgb.b) / 3;
+    const int greyStep = std::min(23, std::max(0, (average - 8 + 5) / 10));
+    const int greyLevel = 8 + greyStep * 10;
+    const Rgb grey{greyLevel, greyLevel, greyLevel};
+
+    const int index = distance(rgb, grey) < distance(rgb, cube) ? 232 + greyStep : 16 + 36 * r + 6 * g + b;
+    return Color(static_cast<Color::Palette256>(index));
+}
+} // namespace
+
+WordPalette::WordPalette() : WordPalette(GameSettings{}, Depth::TrueColor) {}
+
+WordPalette::WordPalette(const GameSettings& settings, Depth depth)
+{
+    rebuild(settings, depth);
+}
+
+void WordPalette::rebuild(const GameSettings& settings, Depth depth)
+{
+    m_depth = depth;
+    for (int step = 0; step < kSteps; ++step)
+    {
+        const auto c = FallingWord::gradientColor(static_cast<float>(step) / (kSteps - 1), settings);
+        const Rgb rgb{c.r, c.g, c.b};
+        switch (depth)
+        {
+        case Depth::TrueColor:
+            m_colors[step] = Color::RGB(static_cast<uint8_t>(rgb.r), static_cast<uint8_t>(rgb.g), static_cast<uint8_t>(rgb.b));
+            break;
+        case Depth::Palette256:
+            m_colors[step] = nearest256(rgb);
+            break;
+        case Depth::Palette16:
+            m_colors[step] = nearest16(rgb);
+            break;
+        }
+    }
+}
+
+WordPalette::Depth WordPalette::detectDepth()
+{
+    switch (Terminal::ColorSupport())
+    {
+    case Terminal::Color::TrueColor:
+        return Depth::TrueColor;
+    case Terminal::Color::Palette256:
+        return Depth::Palette256;
+    default:
+        return Depth::Palette16;
+    }
+}
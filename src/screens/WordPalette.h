@@ -0,0 +1,43 @@
+#pragma once
+
+#include "../models/FallingWord.h"
+#include "../utils/GameConfig.h"
+#include "ftxui/screen/color.hpp"
+#include "ftxui/screen/terminal.hpp"
+#include <array>
+
+// Word colours by life progress, quantized into kSteps ready-made ftxui::Color
+// values so drawing a word is a table lookup. On terminals without truecolor
+// the table holds the nearest 256- or 16-colour palette entries instead, which
+// also keeps the escape sequences short.
+class WordPalette
+{
+public:
+    static constexpr int kSteps = 256;
+
+    enum class Depth
+    {
+        TrueColor,
+        Palette256,
+        Palette16
+    };
+
+    WordPalette();
+    WordPalette(const GameSettings& settings, Depth depth);
+
+    void rebuild(const GameSettings& settings, Depth depth);
+    Depth depth() const { return m_depth; }
+
+    const ftxui::Color& colorAt(float lifeProgress) const
+    {
+        const float clamped = lifeProgress < 0.0f ? 0.0f : (lifeProgress > 1.0f ? 1.0f : lifeProgress);
+        return m_colors[static_cast<int>(clamped * (kSteps - 1) + 0.5f)];
+    }
+
+    // What the terminal reports it can show
+    static Depth detectDepth();
+
+private:
+    std::array<ftxui::Color, kSteps> m_colors;
+    Depth m_depth = Depth::TrueColor;
+};
@@ -0,0 +1,86 @@
+#include "AllocationCounter.h"
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+// Plain integer so the counter itself never allocates
+thread_local uint64_t t_allocations = 0;
+
+void* countedAlloc(std::size_t size)
+{
+    ++t_allocations;
+    return std::malloc(size == 0 ? 1 : size);
+}
+} // namespace
+
+namespace alloc
+{
+uint64_t threadCount()
+{
+    return t_allocations;
+}
+
+NoAllocScope::~NoAllocScope()
+{
+    const uint64_t made = t_allocations - m_start;
+    if (made != 0)
+    {
+        std::fprintf(stderr, "%s: %llu heap allocation(s) where none were expected\n", m_what, static_cast<unsigned long long>(made));
+        std::abort();
+    }
+}
+} // namespace alloc
+
+void* operator new(std::size_t size)
+{
+    if (void* p = countedAlloc(size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return countedAlloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return countedAlloc(size);
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+
+// Heap allocations made through operator new, counted per thread by the
+// replacement operators in AllocationCounter.cpp. Counting is always on: it
+// is one thread-local increment next to the malloc call. Over-aligned
+// allocations go through the library's own operator and are not counted.
+namespace alloc
+{
+// Allocations made by the calling thread so far
+uint64_t threadCount();
+
+// Aborts with a message when the calling thread allocates between
+// construction and destruction. Use through TYPEIT_NO_ALLOC_SCOPE, which is
+// compiled in only with TYPEIT_ASSERT_NO_ALLOC.
+class NoAllocScope
+{
+public:
+    explicit NoAllocScope(const char* what) : m_what(what), m_start(threadCount()) {}
+    ~NoAllocScope();
+    NoAllocScope(const NoAllocScope&) = delete;
+    NoAllocScope& operator=(const NoAllocScope&) = delete;
+
+private:
+    const char* m_what;
+    uint64_t m_start;
+};
+} // namespace alloc
+
+#ifdef TYPEIT_ASSERT_NO_ALLOC
+#define TYPEIT_NO_ALLOC_CONCAT_INNER(a, b) a##b
+#define TYPEIT_NO_ALLOC_CONCAT(a, b) TYPEIT_NO_ALLOC_CONCAT_INNER(a, b)
+#define TYPEIT_NO_ALLOC_SCOPE(what) ::alloc::NoAllocScope TYPEIT_NO_ALLOC_CONCAT(noAllocScope_, __LINE__)(what)
+#else
+#define TYPEIT_NO_ALLOC_SCOPE(what) ((void)0)
+#endif
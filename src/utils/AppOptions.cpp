@@ -0,0 +1,69 @@
+#include "AppOptions.h"
+#include <cstdlib>
+
+bool AppOptions::parse(int argc, char* argv[], AppOptions& options, std::string& error)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--startup-profile")
+        {
+            options.startupProfile = true;
+        }
+        else if (arg == "--tick-jitter")
+        {
+            options.tickJitter = true;
+        }
+        else if (arg == "--trace")
+        {
+            if (i + 1 >= argc)
+            {
+                error = "--trace needs an output file";
+                return false;
+            }
+            options.tracePath = argv[++i];
+        }
+        else if (arg == "--spectate")
+        {
+            if (i + 1 >= argc)
+            {
+                error = "--spectate needs an output file or FIFO";
+                return false;
+            }
+            options.spectatePath = argv[++i];
+        }
+        else if (arg == "--low-bandwidth")
+        {
+            char* end = nullptr;
+            const double kbps = i + 1 < argc ? std::strtod(argv[i + 1], &end) : 0.0;
+            if (i + 1 >= argc || end == argv[i + 1] || *end != '\0' || !(kbps > 0.0))
+            {
+                error = "--low-bandwidth needs a positive budget in kB/s";
+                return false;
+            }
+            options.lowBandwidthKBps = kbps;
+            ++i;
+        }
+        else if (arg == "-h" || arg == "--help")
+        {
+            options.showHelp = true;
+        }
+        else
+        {
+            error = "Unknown option: " + arg;
+            return false;
+        }
+    }
+    return true;
+}
+
+const char* AppOptions::usage()
+{
+    return "Usage: Typeit [options]\n"
+           "  --startup-profile       Print startup phase timings on exit\n"
+           "  --tick-jitter           Print game tick jitter (p50/p99/max) on exit\n"
+           "  --trace <file>          Record engine/render spans, written as Chrome trace JSON on exit\n"
+           "  --spectate <file>       Stream the screen as an asciinema v2 cast to a file or FIFO\n"
+           "  --low-bandwidth <kB/s>  Keep screen output under a kB/s budget for slow links\n"
+           "  -h, --help              Show this help\n";
+}
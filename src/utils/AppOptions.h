@@ -0,0 +1,18 @@
+#pragma once
+
+#include <string>
+
+// Command line switches
+struct AppOptions
+{
+    bool startupProfile = false; // Print startup phase timings on exit
+    bool tickJitter = false;     // Print how far game ticks landed from their deadlines on exit
+    std::string tracePath;       // Chrome trace output, empty disables tracing
+    std::string spectatePath;    // asciinema cast (file or FIFO) of every frame, empty disables it
+    double lowBandwidthKBps = 0.0; // Output budget in kB/s, 0 draws at full rate
+    bool showHelp = false;
+
+    // Returns false and fills error on an unknown or malformed argument
+    static bool parse(int argc, char* argv[], AppOptions& options, std::string& error);
+    static const char* usage();
+};
@@ -0,0 +1,46 @@
+#include "FrameArena.h"
+#include <cstdarg>
+#include <cstdio>
+
+FrameArena::FrameArena(size_t bytes) : m_buffer(bytes), m_resource(m_buffer.data(), m_buffer.size()) {}
+
+FrameArena& FrameArena::local()
+{
+    thread_local FrameArena arena(kDefaultBytes);
+    return arena;
+}
+
+FrameArena::Frame::Frame()
+{
+    ++local().m_depth;
+}
+
+FrameArena::Frame::~Frame()
+{
+    FrameArena& arena = local();
+    if (--arena.m_depth == 0)
+    {
+        // Back to the start of the buffer; heap blocks from an overflow are freed
+        arena.m_resource.release();
+    }
+}
+
+std::string_view FrameArena::format(const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    va_list measure;
+    va_copy(measure, args);
+    const int length = std::vsnprintf(nullptr, 0, fmt, measure);
+    va_end(measure);
+    if (length <= 0)
+    {
+        va_end(args);
+        return {};
+    }
+
+    char* text = static_cast<char*>(m_resource.allocate(static_cast<size_t>(length) + 1, 1));
+    std::vsnprintf(text, static_cast<size_t>(length) + 1, fmt, args);
+    va_end(args);
+    return std::string_view(text, static_cast<size_t>(length));
+}
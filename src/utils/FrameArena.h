@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+// Scratch memory for building one frame's element tree. Formatting helpers
+// and temporary containers take it from a monotonic buffer that is released
+// in one go when the outermost Frame ends, so render code leaves the global
+// heap alone for data that dies with the frame. Anything a canvas or
+// WordField callback reads must not live here: those run after the tree is
+// returned. Each thread has its own arena.
+class FrameArena
+{
+public:
+    static constexpr size_t kDefaultBytes = 64 * 1024;
+
+    // Marks the frame being built; nested frames belong to the outermost one
+    class Frame
+    {
+    public:
+        Frame();
+        ~Frame();
+        Frame(const Frame&) = delete;
+        Frame& operator=(const Frame&) = delete;
+    };
+
+    static FrameArena& local();
+
+    // For std::pmr containers and strings that live until the frame ends
+    std::pmr::memory_resource* resource() { return &m_resource; }
+
+    // printf-style text that lives until the frame ends
+#if defined(__GNUC__)
+    __attribute__((format(printf, 2, 3)))
+#endif
+    std::string_view format(const char* fmt, ...);
+
+private:
+    explicit FrameArena(size_t bytes);
+
+    std::vector<std::byte> m_buffer;
+    // Falls back to the heap when a frame outgrows the buffer
+    std::pmr::monotonic_buffer_resource m_resource;
+    int m_depth = 0;
+};
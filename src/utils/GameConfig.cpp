@@ -27,6 +27,81 @@ bool ConfigManager::parseBool(const std::string& value)
     return lower == "true" || lower == "1" || lower == "yes";
 }
 
+bool ConfigManager::applySetting(GameSettings& settings, const std::string& key, const std::string& value)
+{
+    try
+    {
+        // Teleport settings
+        if (key == "base_teleport_interval")
+            settings.baseTeleportInterval = std::stof(value);
+        else if (key == "min_teleport_interval")
+            settings.minTeleportInterval = std::stof(value);
+        else if (key == "teleport_interval_decrease")
+            settings.teleportIntervalDecrease = std::stof(value);
+        else if (key == "teleport_step_ratio")
+            settings.teleportStepRatio = std::stof(value);
+
+        // Spawn settings
+        else if (key == "spawn_interval_min")
+            settings.spawnIntervalMin = std::stof(value);
+        else if (key == "spawn_interval_max")
+            settings.spawnIntervalMax = std::stof(value);
+        else if (key == "spawn_interval_decrease")
+            settings.spawnIntervalDecrease = std::stof(value);
+        else if (key == "min_spawn_interval")
+            settings.minSpawnInterval = std::stof(value);
+        else if (key == "max_concurrent_words")
+            settings.maxConcurrentWords = std::stoi(value);
+
+        // Health settings
+        else if (key == "max_health")
+            settings.maxHealth = std::stof(value);
+        else if (key == "health_gain")
+            settings.healthGain = std::stof(value);
+        else if (key == "health_loss")
+            settings.healthLoss = std::stof(value);
+        else if (key == "health_cap")
+            settings.healthCap = std::stof(value);
+
+        // Effects
+        else if (key == "border_flash_duration")
+            settings.borderFlashDuration = std::stof(value);
+        else if (key == "min_combo_display")
+            settings.minComboDisplay = std::stoi(value);
+
+        // Color thresholds
+        else if (key == "color_white_threshold")
+            settings.colorWhiteThreshold = std::stof(value);
+        else if (key == "color_yellow_threshold")
+            settings.colorYellowThreshold = std::stof(value);
+
+        // Game area
+        else if (key == "game_area_height")
+            settings.gameAreaHeight = std::stoi(value);
+        else if (key == "header_height")
+            settings.headerHeight = std::stoi(value);
+        else if (key == "input_height")
+            settings.inputHeight = std::stoi(value);
+
+        // Opponent
+        else if (key == "bot_opponent")
+            settings.botOpponent = parseBool(value);
+        else if (key == "bot_wpm")
+            settings.botWpm = std::stof(value);
+        else if (key == "bot_error_rate")
+            settings.botErrorRate = std::stof(value);
+        else if (key == "bot_reaction_time")
+            settings.botReactionTime = std::stof(value);
+        else
+            return false;
+    }
+    catch (...)
+    {
+        return false;
+    }
+    return true;
+}
+
 bool ConfigManager::loadFromFile(const std::string& filepath)
 {
     std::ifstream file(filepath);
@@ -37,8 +112,14 @@ bool ConfigManager::loadFromFile(const std::string& filepath)
         return false;
     }
 
+    readSettings(file, m_settings);
+    return true;
+}
+
+void ConfigManager::readSettings(std::istream& in, GameSettings& settings)
+{
     std::string line;
-    while (std::getline(file, line))
+    while (std::getline(in, line))
     {
         line = trim(line);
 
@@ -53,68 +134,9 @@ bool ConfigManager::loadFromFile(const std::string& filepath)
         std::string key = trim(line.substr(0, eqPos));
         std::string value = trim(line.substr(eqPos + 1));
 
-        // Parse each setting
-        try
-        {
-            // Teleport settings
-            if (key == "base_teleport_interval")
-                m_settings.baseTeleportInterval = std::stof(value);
-            else if (key == "min_teleport_interval")
-                m_settings.minTeleportInterval = std::stof(value);
-            else if (key == "teleport_interval_decrease")
-                m_settings.teleportIntervalDecrease = std::stof(value);
-            else if (key == "teleport_step_ratio")
-                m_settings.teleportStepRatio = std::stof(value);
-
-            // Spawn settings
-            else if (key == "spawn_interval_min")
-                m_settings.spawnIntervalMin = std::stof(value);
-            else if (key == "spawn_interval_max")
-                m_settings.spawnIntervalMax = std::stof(value);
-            else if (key == "spawn_interval_decrease")
-                m_settings.spawnIntervalDecrease = std::stof(value);
-            else if (key == "min_spawn_interval")
-                m_settings.minSpawnInterval = std::stof(value);
-            else if (key == "max_concurrent_words")
-                m_settings.maxConcurrentWords = std::stoi(value);
-
-            // Health settings
-            else if (key == "max_health")
-                m_settings.maxHealth = std::stof(value);
-            else if (key == "health_gain")
-                m_settings.healthGain = std::stof(value);
-            else if (key == "health_loss")
-                m_settings.healthLoss = std::stof(value);
-            else if (key == "health_cap")
-                m_settings.healthCap = std::stof(value);
-
-            // Effects
-            else if (key == "border_flash_duration")
-                m_settings.borderFlashDuration = std::stof(value);
-            else if (key == "min_combo_display")
-                m_settings.minComboDisplay = std::stoi(value);
-
-            // Color thresholds
-            else if (key == "color_white_threshold")
-                m_settings.colorWhiteThreshold = std::stof(value);
-            else if (key == "color_yellow_threshold")
-                m_settings.colorYellowThreshold = std::stof(value);
-
-            // Game area
-            else if (key == "game_area_height")
-                m_settings.gameAreaHeight = std::stoi(value);
-            else if (key == "header_height")
-                m_settings.headerHeight = std::stoi(value);
-            else if (key == "input_height")
-                m_settings.inputHeight = std::stoi(value);
-        }
-        catch (...)
-        {
-            // Ignore parse errors, keep default value
-        }
+        // Unknown keys and bad values keep the default
+        applySetting(settings, key, value);
     }
-
-    return true;
 }
 
 bool ConfigManager::saveToFile(const std::string& filepath) const
@@ -130,47 +152,74 @@ bool ConfigManager::saveToFile(const std::string& filepath) const
     if (!file.is_open())
         return false;
 
-    file << "# TypeIt Game Configuration\n";
-    file << "# Edit these values to customize game difficulty\n\n";
-
-    file << "[Teleport]\n";
-    file << "# How words move across the screen (blink/teleport style)\n";
-    file << "base_teleport_interval = " << m_settings.baseTeleportInterval << "\n";
-    file << "min_teleport_interval = " << m_settings.minTeleportInterval << "\n";
-    file << "teleport_interval_decrease = " << m_settings.teleportIntervalDecrease << "\n";
-    file << "teleport_step_ratio = " << m_settings.teleportStepRatio << "\n\n";
-
-    file << "[Spawn]\n";
-    file << "# How often new words appear\n";
-    file << "spawn_interval_min = " << m_settings.spawnIntervalMin << "\n";
-    file << "spawn_interval_max = " << m_settings.spawnIntervalMax << "\n";
-    file << "spawn_interval_decrease = " << m_settings.spawnIntervalDecrease << "\n";
-    file << "min_spawn_interval = " << m_settings.minSpawnInterval << "\n";
-    file << "max_concurrent_words = " << m_settings.maxConcurrentWords << "\n\n";
-
-    file << "[Health]\n";
-    file << "max_health = " << m_settings.maxHealth << "\n";
-    file << "health_gain = " << m_settings.healthGain << "\n";
-    file << "health_loss = " << m_settings.healthLoss << "\n";
-    file << "health_cap = " << m_settings.healthCap << "\n\n";
-
-    file << "[Effects]\n";
-    file << "border_flash_duration = " << m_settings.borderFlashDuration << "\n";
-    file << "min_combo_display = " << m_settings.minComboDisplay << "\n\n";
-
-    file << "[Colors]\n";
-    file << "# Thresholds for word color change (0.0 - 1.0)\n";
-    file << "color_white_threshold = " << m_settings.colorWhiteThreshold << "\n";
-    file << "color_yellow_threshold = " << m_settings.colorYellowThreshold << "\n\n";
-
-    file << "[GameArea]\n";
-    file << "game_area_height = " << m_settings.gameAreaHeight << "\n";
-    file << "header_height = " << m_settings.headerHeight << "\n";
-    file << "input_height = " << m_settings.inputHeight << "\n";
-
+    writeSettings(file, m_settings);
     return true;
 }
 
+void ConfigManager::writeSettings(std::ostream& out, const GameSettings& settings)
+{
+    out << "# TypeIt Game Configuration\n";
+    out << "# Edit these values to customize game difficulty\n\n";
+
+    out << "[Teleport]\n";
+    out << "# How words move across the screen (blink/teleport style)\n";
+    out << "base_teleport_interval = " << settings.baseTeleportInterval << "\n";
+    out << "min_teleport_interval = " << settings.minTeleportInterval << "\n";
+    out << "teleport_interval_decrease = " << settings.teleportIntervalDecrease << "\n";
+    out << "teleport_step_ratio = " << settings.teleportStepRatio << "\n\n";
+
+    out << "[Spawn]\n";
+    out << "# How often new words appear\n";
+    out << "spawn_interval_min = " << settings.spawnIntervalMin << "\n";
+    out << "spawn_interval_max = " << settings.spawnIntervalMax << "\n";
+    out << "spawn_interval_decrease = " << settings.spawnIntervalDecrease << "\n";
+    out << "min_spawn_interval = " << settings.minSpawnInterval << "\n";
+    out << "max_concurrent_words = " << settings.maxConcurrentWords << "\n\n";
+
+    out << "[Health]\n";
+    out << "max_health = " << settings.maxHealth << "\n";
+    out << "health_gain = " << settings.healthGain << "\n";
+    out << "health_loss = " << settings.healthLoss << "\n";
+    out << "health_cap = " << settings.healthCap << "\n\n";
+
+    out << "[Effects]\n";
+    out << "border_flash_duration = " << settings.borderFlashDuration << "\n";
+    out << "min_combo_display = " << settings.minComboDisplay << "\n\n";
+
+    out << "[Colors]\n";
+    out << "# Thresholds for word color change (0.0 - 1.0)\n";
+    out << "color_white_threshold = " << settings.colorWhiteThreshold << "\n";
+    out << "color_yellow_threshold = " << settings.colorYellowThreshold << "\n\n";
+
+    out << "[GameArea]\n";
+    out << "game_area_height = " << settings.gameAreaHeight << "\n";
+    out << "header_height = " << settings.headerHeight << "\n";
+    out << "input_height = " << settings.inputHeight << "\n\n";
+
+    out << "[Opponent]\n";
+    out << "# Bot typist competing for the same words\n";
+    out << "bot_opponent = " << (settings.botOpponent ? "true" : "false") << "\n";
+    out << "bot_wpm = " << settings.botWpm << "\n";
+    out << "bot_error_rate = " << settings.botErrorRate << "\n";
+    out << "bot_reaction_time = " << settings.botReactionTime << "\n";
+
+}
+
+uint64_t ConfigManager::fingerprint(const GameSettings& settings)
+{
+    std::ostringstream text;
+    writeSettings(text, settings);
+
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : text.str())
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
 void ConfigManager::createDefaultConfig(const std::string& filepath) const
 {
     saveToFile(filepath);
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstdint>
+#include <istream>
+#include <ostream>
 #include <string>
 
 // Runtime-configurable game settings loaded from config file
@@ -36,14 +39,22 @@ struct GameSettings
     int gameAreaHeight = 15;
     int headerHeight = 3;
     int inputHeight = 4;
+
+    // Bot opponent racing for the same words
+    bool botOpponent = false;
+    float botWpm = 50.0f;
+    float botErrorRate = 0.04f;     // Chance of a typo per keystroke
+    float botReactionTime = 0.35f;  // Pause before starting on a new word (seconds)
 };
 
 // Compile-time constants that don't need to be configurable
 namespace GamePaths
 {
 constexpr const char* WORDS_FILE = "data/words.txt";
-constexpr const char* RECORDS_FILE = "data/records.csv";
+constexpr const char* RECORDS_FILE = "data/records.csv"; // Pre-sharding history, migrated on first load
+constexpr const char* RECORDS_DIR = "data/records";
 constexpr const char* CONFIG_FILE = "data/config.ini";
+constexpr const char* SUSPEND_FILE = "data/suspended.game"; // Game left with Esc, until it is resumed
 } // namespace GamePaths
 
 class ConfigManager
@@ -55,6 +66,15 @@ public:
     bool saveToFile(const std::string& filepath = GamePaths::CONFIG_FILE) const;
     void createDefaultConfig(const std::string& filepath = GamePaths::CONFIG_FILE) const;
 
+    // Sets the field behind a config.ini key such as "health_loss". Returns
+    // false for an unknown key or a value that doesn't parse.
+    static bool applySetting(GameSettings& settings, const std::string& key, const std::string& value);
+    // config.ini text of the settings, and back; floats keep the stream's precision
+    static void writeSettings(std::ostream& out, const GameSettings& settings);
+    static void readSettings(std::istream& in, GameSettings& settings);
+    // Hash of every setting; games with equal fingerprints play by the same rules
+    static uint64_t fingerprint(const GameSettings& settings);
+
     const GameSettings& settings() const { return m_settings; }
     GameSettings& settings() { return m_settings; }
 
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+
+// The game's random generator: std::mt19937 counting its draws, so a
+// snapshot stores its state as seed + draw count (a few bytes) instead of
+// the 2.5 KB engine state, and restores it with discard().
+class GameRng
+{
+public:
+    using result_type = std::mt19937::result_type;
+
+    explicit GameRng(result_type seed = std::mt19937::default_seed) : m_gen(seed), m_seed(seed) {}
+
+    static constexpr result_type min() { return std::mt19937::min(); }
+    static constexpr result_type max() { return std::mt19937::max(); }
+
+    result_type operator()()
+    {
+        ++m_draws;
+        return m_gen();
+    }
+
+    void seed(result_type seed)
+    {
+        m_gen.seed(seed);
+        m_seed = seed;
+        m_draws = 0;
+    }
+
+    // Same state as a generator seeded with seed after draws draws
+    void restore(result_type seed, uint64_t draws)
+    {
+        this->seed(seed);
+        m_gen.discard(draws);
+        m_draws = draws;
+    }
+
+    result_type getSeed() const { return m_seed; }
+    uint64_t getDraws() const { return m_draws; }
+
+private:
+    std::mt19937 m_gen;
+    result_type m_seed;
+    uint64_t m_draws = 0;
+};
@@ -0,0 +1,60 @@
+#include "JitterStats.h"
+#include <algorithm>
+#include <cstdio>
+
+void JitterStats::record(Clock::duration interval, Clock::duration period)
+{
+    const int64_t us = std::chrono::duration_cast<std::chrono::microseconds>(interval > period ? interval - period : period - interval).count();
+    const size_t bucket = std::min(static_cast<size_t>(us / kBucketUs), kBuckets - 1);
+    m_counts[bucket].fetch_add(1, std::memory_order_relaxed);
+    m_samples.fetch_add(1, std::memory_order_relaxed);
+    if (us > m_maxUs.load(std::memory_order_relaxed))
+    {
+        m_maxUs.store(us, std::memory_order_relaxed);
+    }
+}
+
+JitterStats::Summary JitterStats::summary() const
+{
+    Summary result;
+    result.samples = m_samples.load(std::memory_order_relaxed);
+    result.maxMs = static_cast<double>(m_maxUs.load(std::memory_order_relaxed)) / 1000.0;
+    if (result.samples == 0)
+        return result;
+
+    // Ranks of the two percentiles, counted from 1
+    const uint64_t p50Rank = std::max<uint64_t>(1, (result.samples + 1) / 2);
+    const uint64_t p99Rank = std::max<uint64_t>(1, (result.samples * 99 + 99) / 100);
+    uint64_t seen = 0;
+    bool p50Found = false;
+    for (size_t bucket = 0; bucket < kBuckets; ++bucket)
+    {
+        seen += m_counts[bucket].load(std::memory_order_relaxed);
+        const double upperMs = std::min(static_cast<double>((bucket + 1) * kBucketUs) / 1000.0, result.maxMs);
+        if (!p50Found && seen >= p50Rank)
+        {
+            result.p50Ms = upperMs;
+            p50Found = true;
+        }
+        if (seen >= p99Rank)
+        {
+            result.p99Ms = upperMs;
+            break;
+        }
+    }
+    // Counts still being written can leave the ranks unreached
+    if (!p50Found)
+        result.p50Ms = result.maxMs;
+    if (seen < p99Rank)
+        result.p99Ms = result.maxMs;
+    return result;
+}
+
+std::string JitterStats::report(const char* name) const
+{
+    const Summary s = summary();
+    char line[160];
+    std::snprintf(line, sizeof(line), "%s jitter over %llu intervals: p50 %.2f ms, p99 %.2f ms, max %.2f ms\n", name,
+                  static_cast<unsigned long long>(s.samples), s.p50Ms, s.p99Ms, s.maxMs);
+    return line;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// How far a periodic loop wakes from its period: |interval - period| per
+// wake-up, kept in a fixed histogram of 10 us buckets. One thread records,
+// any thread may summarise; the counters are relaxed atomics, so a summary
+// taken while recording is at most a sample or two behind.
+class JitterStats
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr int64_t kBucketUs = 10;
+    // The last bucket collects everything from about 20 ms up
+    static constexpr size_t kBuckets = 2048;
+
+    struct Summary
+    {
+        uint64_t samples = 0;
+        double p50Ms = 0.0;
+        double p99Ms = 0.0;
+        double maxMs = 0.0;
+    };
+
+    void record(Clock::duration interval, Clock::duration period);
+    // Percentiles are bucket upper bounds, the maximum is exact
+    Summary summary() const;
+    // One line for the exit log
+    std::string report(const char* name) const;
+
+private:
+    std::array<std::atomic<uint32_t>, kBuckets> m_counts{};
+    std::atomic<uint64_t> m_samples = 0;
+    std::atomic<int64_t> m_maxUs = 0;
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+// Fixed-capacity least-recently-used cache. Lookups refresh an entry, inserts
+// evict the oldest entry once the capacity is reached.
+template <typename Key, typename Value>
+class LruCache
+{
+public:
+    explicit LruCache(size_t capacity) : m_capacity(capacity == 0 ? 1 : capacity) {}
+
+    const Value* find(const Key& key)
+    {
+        auto it = m_index.find(key);
+        if (it == m_index.end())
+            return nullptr;
+
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        return &it->second->second;
+    }
+
+    const Value& insert(const Key& key, Value value)
+    {
+        auto it = m_index.find(key);
+        if (it != m_index.end())
+        {
+            it->second->second = std::move(value);
+            m_entries.splice(m_entries.begin(), m_entries, it->second);
+            return it->second->second;
+        }
+
+        if (m_entries.size() >= m_capacity)
+        {
+            m_index.erase(m_entries.back().first);
+            m_entries.pop_back();
+        }
+
+        m_entries.emplace_front(key, std::move(value));
+        m_index.emplace(key, m_entries.begin());
+        return m_entries.front().second;
+    }
+
+    void clear()
+    {
+        m_entries.clear();
+        m_index.clear();
+    }
+
+    size_t size() const { return m_entries.size(); }
+    size_t capacity() const { return m_capacity; }
+
+private:
+    using Entry = std::pair<Key, Value>;
+
+    size_t m_capacity;
+    std::list<Entry> m_entries; // Most recently used first
+    std::unordered_map<Key, typename std::list<Entry>::iterator> m_index;
+};
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Varint.h"
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+// Field encoders for the suspend-to-disk snapshots. Counters go through
+// varints; floats are stored bit-exact so a restored game continues on
+// exactly the same numbers it stopped on.
+namespace snapshot
+{
+inline void putFloat(std::string& out, float value)
+{
+    uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    for (int i = 0; i < 4; ++i)
+    {
+        out.push_back(static_cast<char>(bits >> (8 * i)));
+    }
+}
+
+inline bool getFloat(std::string_view& in, float& value)
+{
+    if (in.size() < 4)
+        return false;
+    uint32_t bits = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        bits |= static_cast<uint32_t>(static_cast<uint8_t>(in[i])) << (8 * i);
+    }
+    in.remove_prefix(4);
+    std::memcpy(&value, &bits, sizeof(value));
+    return true;
+}
+
+inline void putBool(std::string& out, bool value)
+{
+    out.push_back(value ? 1 : 0);
+}
+
+inline bool getBool(std::string_view& in, bool& value)
+{
+    if (in.empty() || static_cast<uint8_t>(in.front()) > 1)
+        return false;
+    value = in.front() == 1;
+    in.remove_prefix(1);
+    return true;
+}
+
+template <typename Int>
+bool getInt(std::string_view& in, Int& value)
+{
+    uint64_t raw = 0;
+    if (!varint::get(in, raw))
+        return false;
+    value = static_cast<Int>(raw);
+    return true;
+}
+
+inline bool getSignedInt(std::string_view& in, int& value)
+{
+    int64_t raw = 0;
+    if (!varint::getSigned(in, raw))
+        return false;
+    value = static_cast<int>(raw);
+    return true;
+}
+
+// Standard random engines and distributions only expose their full state
+// (including a distribution's cached second value) through the stream operators
+template <typename T>
+void putStreamed(std::string& out, const T& value)
+{
+    std::ostringstream text;
+    text << value;
+    varint::putString(out, text.str());
+}
+
+template <typename T>
+bool getStreamed(std::string_view& in, T& value)
+{
+    std::string text;
+    if (!varint::getString(in, text))
+        return false;
+    std::istringstream stream(text);
+    stream >> value;
+    return !stream.fail();
+}
+} // namespace snapshot
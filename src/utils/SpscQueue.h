@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+// Bounded single-producer single-consumer ring. One thread pushes, one other
+// thread peeks and pops; neither ever waits for the other or allocates. Each
+// side caches the other side's index and reloads it only when the ring looks
+// full (producer) or empty (consumer).
+template <typename T, size_t Capacity>
+class SpscQueue
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+
+public:
+    // Producer side; false when the ring is full
+    bool push(const T& value)
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_headCache == Capacity)
+        {
+            m_headCache = m_head.load(std::memory_order_acquire);
+            if (tail - m_headCache == Capacity)
+                return false;
+        }
+        m_slots[tail & (Capacity - 1)] = value;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side; the oldest value, nullptr when empty. Valid until pop().
+    const T* front()
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tailCache)
+        {
+            m_tailCache = m_tail.load(std::memory_order_acquire);
+            if (head == m_tailCache)
+                return nullptr;
+        }
+        return &m_slots[head & (Capacity - 1)];
+    }
+
+    // Consumer side, only after front() returned a value
+    void pop() { m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+private:
+    // Producer and consumer state on separate cache lines
+    alignas(64) std::atomic<size_t> m_tail = 0;
+    size_t m_headCache = 0;
+    alignas(64) std::atomic<size_t> m_head = 0;
+    size_t m_tailCache = 0;
+    alignas(64) std::array<T, Capacity> m_slots{};
+};
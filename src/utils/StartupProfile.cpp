@@ -0,0 +1,61 @@
+#include "StartupProfile.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+StartupProfile::StartupProfile() : m_origin(Clock::now()), m_mainThread(std::this_thread::get_id()) {}
+
+double StartupProfile::sinceOrigin(Clock::time_point time) const
+{
+    return std::chrono::duration<double, std::milli>(time - m_origin).count();
+}
+
+void StartupProfile::record(const std::string& name, Clock::time_point start, Clock::time_point end)
+{
+    Phase phase{name, sinceOrigin(start), sinceOrigin(end), std::this_thread::get_id()};
+    std::lock_guard lock(m_mutex);
+    m_phases.push_back(std::move(phase));
+}
+
+void StartupProfile::mark(const std::string& name)
+{
+    const auto now = Clock::now();
+    record(name, now, now);
+}
+
+std::string StartupProfile::report() const
+{
+    std::vector<Phase> phases;
+    {
+        std::lock_guard lock(m_mutex);
+        phases = m_phases;
+    }
+    std::stable_sort(phases.begin(), phases.end(), [](const Phase& a, const Phase& b) { return a.startMs < b.startMs; });
+
+    // Background threads are numbered in order of first appearance
+    std::vector<std::thread::id> workers;
+    auto threadName = [&](std::thread::id id)
+    {
+        if (id == m_mainThread)
+            return std::string("main");
+        auto it = std::find(workers.begin(), workers.end(), id);
+        if (it == workers.end())
+        {
+            workers.push_back(id);
+            it = workers.end() - 1;
+        }
+        return "worker " + std::to_string(it - workers.begin() + 1);
+    };
+
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2);
+    oss << "Startup profile (ms since launch)\n";
+    oss << std::left << std::setw(22) << "  phase" << std::right << std::setw(10) << "start" << std::setw(10) << "end" << std::setw(10)
+        << "duration" << "  thread\n";
+    for (const auto& phase : phases)
+    {
+        oss << "  " << std::left << std::setw(20) << phase.name << std::right << std::setw(10) << phase.startMs << std::setw(10)
+            << phase.endMs << std::setw(10) << phase.endMs - phase.startMs << "  " << threadName(phase.thread) << "\n";
+    }
+    return oss.str();
+}
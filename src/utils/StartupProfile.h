@@ -0,0 +1,54 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Wall-clock timeline of the startup phases, relative to the moment the
+// profile was created. Phases may be recorded from any thread.
+class StartupProfile
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    StartupProfile();
+
+    void record(const std::string& name, Clock::time_point start, Clock::time_point end);
+    // Zero-length milestone such as the first rendered frame
+    void mark(const std::string& name);
+
+    template <typename Fn>
+    decltype(auto) measure(const std::string& name, Fn&& fn)
+    {
+        struct Scope
+        {
+            StartupProfile& profile;
+            const std::string& name;
+            Clock::time_point start = Clock::now();
+            ~Scope() { profile.record(name, start, Clock::now()); }
+        } scope{*this, name};
+        return std::forward<Fn>(fn)();
+    }
+
+    // Table of phases ordered by start time, in milliseconds since creation
+    std::string report() const;
+
+private:
+    struct Phase
+    {
+        std::string name;
+        double startMs = 0.0;
+        double endMs = 0.0;
+        std::thread::id thread;
+    };
+
+    Clock::time_point m_origin;
+    std::thread::id m_mainThread;
+    mutable std::mutex m_mutex;
+    std::vector<Phase> m_phases;
+
+    double sinceOrigin(Clock::time_point time) const;
+};
@@ -0,0 +1,196 @@
+#include "Trace.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace trace
+{
+namespace
+{
+enum class Phase : char
+{
+    Complete = 'X',
+    FlowBegin = 's',
+    FlowEnd = 'f',
+};
+
+struct Event
+{
+    const char* name = nullptr;
+    uint64_t startNs = 0;
+    uint64_t value = 0; // Duration in ns for spans, flow id for flow events
+    Phase phase = Phase::Complete;
+};
+
+// Single writer (the owning thread); the dump reads it after the writers stopped
+struct ThreadBuffer
+{
+    explicit ThreadBuffer(size_t capacity, uint32_t tid) : events(capacity), tid(tid) {}
+
+    std::vector<Event> events;
+    std::atomic<uint64_t> written = 0;
+    uint32_t tid;
+    std::string name;
+
+    void push(const Event& event)
+    {
+        const uint64_t index = written.load(std::memory_order_relaxed);
+        events[index % events.size()] = event;
+        written.store(index + 1, std::memory_order_release);
+    }
+};
+
+struct Registry
+{
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    size_t eventsPerThread = kDefaultEventsPerThread;
+    std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+};
+
+Registry& registry()
+{
+    static Registry instance;
+    return instance;
+}
+
+std::atomic<uint64_t> g_nextFlowId = 1;
+
+// The registry owns the buffers so events survive their thread
+ThreadBuffer& threadBuffer()
+{
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer)
+    {
+        Registry& reg = registry();
+        std::lock_guard lock(reg.mutex);
+        reg.buffers.push_back(std::make_unique<ThreadBuffer>(reg.eventsPerThread, static_cast<uint32_t>(reg.buffers.size() + 1)));
+        buffer = reg.buffers.back().get();
+    }
+    return *buffer;
+}
+
+void writeEscaped(std::ostream& out, const std::string& text)
+{
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\')
+            out << '\\' << c;
+        else if (static_cast<unsigned char>(c) >= 0x20)
+            out << c;
+    }
+}
+} // namespace
+
+namespace detail
+{
+std::atomic<bool> g_enabled = false;
+
+uint64_t nowNs()
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - registry().origin).count()
+    );
+}
+
+void recordSpan(const char* name, uint64_t startNs, uint64_t endNs)
+{
+    threadBuffer().push(Event{name, startNs, endNs - startNs, Phase::Complete});
+}
+
+void recordFlow(const char* name, uint64_t id, bool begin)
+{
+    threadBuffer().push(Event{name, nowNs(), id, begin ? Phase::FlowBegin : Phase::FlowEnd});
+}
+} // namespace detail
+
+void enable(size_t eventsPerThread)
+{
+    Registry& reg = registry();
+    {
+        std::lock_guard lock(reg.mutex);
+        if (detail::g_enabled.load())
+            return;
+        reg.eventsPerThread = std::max<size_t>(eventsPerThread, 1);
+        reg.origin = std::chrono::steady_clock::now();
+    }
+    detail::g_enabled.store(true);
+}
+
+void setThreadName(const std::string& name)
+{
+    if (!enabled())
+        return;
+    ThreadBuffer& buffer = threadBuffer();
+    std::lock_guard lock(registry().mutex);
+    buffer.name = name;
+}
+
+uint64_t newFlowId()
+{
+    return g_nextFlowId.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool writeChromeTrace(const std::string& path)
+{
+    std::ofstream out(path, std::ios::trunc);
+    if (!out.is_open())
+        return false;
+
+    Registry& reg = registry();
+    std::lock_guard lock(reg.mutex);
+
+    // Timestamps are microseconds with nanosecond fractions
+    char number[32];
+    auto micros = [&](uint64_t ns)
+    {
+        std::snprintf(number, sizeof(number), "%.3f", static_cast<double>(ns) / 1000.0);
+        return number;
+    };
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    auto separator = [&]() -> std::ostream&
+    {
+        out << (first ? "" : ",\n");
+        first = false;
+        return out;
+    };
+
+    for (const auto& buffer : reg.buffers)
+    {
+        separator() << R"({"ph":"M","name":"thread_name","pid":1,"tid":)" << buffer->tid << R"(,"args":{"name":")";
+        writeEscaped(out, buffer->name.empty() ? "thread " + std::to_string(buffer->tid) : buffer->name);
+        out << "\"}}";
+
+        const uint64_t written = buffer->written.load(std::memory_order_acquire);
+        const uint64_t capacity = buffer->events.size();
+        const uint64_t begin = written > capacity ? written - capacity : 0;
+        for (uint64_t i = begin; i < written; ++i)
+        {
+            const Event& event = buffer->events[i % capacity];
+            separator() << "{\"ph\":\"" << static_cast<char>(event.phase) << "\",\"name\":\"";
+            writeEscaped(out, event.name);
+            out << "\",\"pid\":1,\"tid\":" << buffer->tid << ",\"ts\":" << micros(event.startNs);
+            if (event.phase == Phase::Complete)
+            {
+                out << ",\"dur\":" << micros(event.value);
+            }
+            else
+            {
+                // Flow arrows bind to the enclosing spans
+                out << ",\"cat\":\"flow\",\"id\":" << event.value;
+                if (event.phase == Phase::FlowEnd)
+                    out << R"(,"bp":"e")";
+            }
+            out << "}";
+        }
+    }
+    out << "\n]}\n";
+    return out.good();
+}
+} // namespace trace
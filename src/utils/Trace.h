@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Opt-in span tracing, exported in Chrome trace-event format for
+// chrome://tracing or Perfetto. Each thread appends to its own fixed-size
+// ring buffer without locks (the oldest events are overwritten), so the cost
+// when enabled is two clock reads per span and a single relaxed load when
+// disabled. Event names must be string literals or otherwise outlive the dump.
+namespace trace
+{
+namespace detail
+{
+extern std::atomic<bool> g_enabled;
+uint64_t nowNs();
+void recordSpan(const char* name, uint64_t startNs, uint64_t endNs);
+void recordFlow(const char* name, uint64_t id, bool begin);
+} // namespace detail
+
+constexpr size_t kDefaultEventsPerThread = 1 << 16;
+
+// Call before the traced threads start; later calls are ignored
+void enable(size_t eventsPerThread = kDefaultEventsPerThread);
+inline bool enabled()
+{
+    return detail::g_enabled.load(std::memory_order_relaxed);
+}
+
+// Shown as the track name, call from the thread itself
+void setThreadName(const std::string& name);
+
+// Arrow from the point a task is handed to another thread to where it runs.
+// Both ends must be called inside a span.
+uint64_t newFlowId();
+inline void flowBegin(const char* name, uint64_t id)
+{
+    if (enabled())
+        detail::recordFlow(name, id, true);
+}
+inline void flowEnd(const char* name, uint64_t id)
+{
+    if (enabled())
+        detail::recordFlow(name, id, false);
+}
+
+// Writes everything recorded so far. Call once the traced threads have
+// stopped, a writer racing the dump may tear its newest event.
+bool writeChromeTrace(const std::string& path);
+
+class Span
+{
+public:
+    explicit Span(const char* name) : m_name(enabled() ? name : nullptr), m_startNs(m_name ? detail::nowNs() : 0) {}
+    ~Span()
+    {
+        if (m_name)
+            detail::recordSpan(m_name, m_startNs, detail::nowNs());
+    }
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+
+private:
+    const char* m_name;
+    uint64_t m_startNs;
+};
+} // namespace trace
+
+#define TYPEIT_TRACE_CONCAT_INNER(a, b) a##b
+#define TYPEIT_TRACE_CONCAT(a, b) TYPEIT_TRACE_CONCAT_INNER(a, b)
+#define TYPEIT_TRACE_SCOPE(name) ::trace::Span TYPEIT_TRACE_CONCAT(traceSpan_, __LINE__)(name)
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Latest-value handoff from one writer thread to one reader thread. The
+// writer fills back() and publishes it; the reader takes whatever was
+// published last. Three copies rotate so neither side waits for the other:
+// one being written, one being read and the newest finished one in between.
+// A slot handed back to the writer still holds an older value, so the writer
+// must overwrite everything it publishes.
+template <typename T>
+class TripleBuffer
+{
+public:
+    // Writer side
+    T& back() { return m_slots[m_back]; }
+    void publish()
+    {
+        const uint8_t previous = m_middle.exchange(static_cast<uint8_t>(m_back | kFresh), std::memory_order_acq_rel);
+        m_back = previous & kIndex;
+    }
+
+    // Reader side; the newest published value, or the last one read if
+    // nothing new was published since
+    const T& read()
+    {
+        if (m_middle.load(std::memory_order_relaxed) & kFresh)
+        {
+            const uint8_t previous = m_middle.exchange(m_front, std::memory_order_acq_rel);
+            m_front = previous & kIndex;
+        }
+        return m_slots[m_front];
+    }
+
+private:
+    static constexpr uint8_t kIndex = 0x3;
+    static constexpr uint8_t kFresh = 0x4;
+
+    std::array<T, 3> m_slots{};
+    uint8_t m_back = 0;  // Writer only
+    uint8_t m_front = 1; // Reader only
+    std::atomic<uint8_t> m_middle = 2;
+};
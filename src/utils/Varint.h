@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// LEB128 varints for the compact binary formats (race protocol, input logs).
+// Small values take one byte; signed deltas go through zig-zag first.
+namespace varint
+{
+inline void put(std::string& out, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+// Reads one varint from the front of in and advances it. Returns false on
+// truncated or overlong input, leaving in unspecified.
+inline bool get(std::string_view& in, uint64_t& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64 && !in.empty(); shift += 7)
+    {
+        const auto byte = static_cast<uint8_t>(in.front());
+        in.remove_prefix(1);
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+inline uint64_t zigzag(int64_t value)
+{
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t unzigzag(uint64_t value)
+{
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+inline void putSigned(std::string& out, int64_t value)
+{
+    put(out, zigzag(value));
+}
+
+inline bool getSigned(std::string_view& in, int64_t& value)
+{
+    uint64_t raw = 0;
+    if (!get(in, raw))
+        return false;
+    value = unzigzag(raw);
+    return true;
+}
+
+inline void putString(std::string& out, std::string_view text)
+{
+    put(out, text.size());
+    out.append(text);
+}
+
+inline bool getString(std::string_view& in, std::string& text)
+{
+    uint64_t size = 0;
+    if (!get(in, size) || size > in.size())
+        return false;
+    text.assign(in.substr(0, size));
+    in.remove_prefix(size);
+    return true;
+}
+} // namespace varint
@@ -0,0 +1,185 @@
+#include "LoadTest.h"
+#include "RaceConnection.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <poll.h>
+#include <vector>
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+// A fake player: the bot sees the mirrored board and its keystrokes go into
+// the connection's batch
+class MirrorSurface : public TypingSurface
+{
+public:
+    explicit MirrorSurface(RaceConnection& connection) : m_connection(connection) {}
+
+    const std::vector<FallingWord>& fallingWords() const override { return m_connection.mirror().words(); }
+    int visibleWidth() const override { return m_connection.mirror().width(); }
+    bool acceptingInput() const override { return m_connection.isOpen() && m_connection.mirror().synced() && !m_connection.raceOver(); }
+    void typeChar(char c) override
+    {
+        m_connection.queueKeys(std::string_view(&c, 1));
+        ++keystrokes;
+    }
+    void typeBackspace() override
+    {
+        m_connection.queueKeys(std::string_view(&race::kBackspaceKey, 1));
+        ++keystrokes;
+    }
+    void typeSpace() override
+    {
+        m_connection.queueKeys(std::string_view(&race::kSubmitKey, 1));
+        ++keystrokes;
+    }
+
+    uint64_t keystrokes = 0;
+
+private:
+    RaceConnection& m_connection;
+};
+
+struct FakePlayer
+{
+    RaceConnection connection;
+    std::unique_ptr<MirrorSurface> surface;
+    std::unique_ptr<BotTypist> bot;
+    Clock::time_point lastSnapshotAt;
+    uint64_t lastSnapshots = 0;
+};
+
+double percentile(std::vector<double>& values, double p)
+{
+    if (values.empty())
+        return 0.0;
+    const size_t index = std::min(values.size() - 1, static_cast<size_t>(p * static_cast<double>(values.size() - 1) + 0.5));
+    std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(index), values.end());
+    return values[index];
+}
+} // namespace
+
+int runLoadTest(const LoadTestOptions& options)
+{
+    std::vector<std::unique_ptr<FakePlayer>> players;
+    players.reserve(static_cast<size_t>(std::max(0, options.clients)));
+    for (int i = 0; i < options.clients; ++i)
+    {
+        auto player = std::make_unique<FakePlayer>();
+        std::string error;
+        if (!player->connection.open(options.endpoint, "bot" + std::to_string(i), error))
+        {
+            std::cerr << "Client " << i << " failed to connect to " << options.endpoint.describe() << ": " << error << "\n";
+            return 1;
+        }
+        player->surface = std::make_unique<MirrorSurface>(player->connection);
+        player->bot = std::make_unique<BotTypist>(options.profile, options.seed * 7919u + static_cast<uint32_t>(i));
+        players.push_back(std::move(player));
+    }
+    std::cerr << players.size() << " clients connected to " << options.endpoint.describe() << "\n";
+
+    const auto frame = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / std::max(1, options.frameRate)));
+    const float frameSeconds = std::chrono::duration<float>(frame).count();
+    const auto start = Clock::now();
+    const auto end = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(options.seconds));
+    auto nextFrame = start + frame;
+
+    std::vector<pollfd> fds;
+    std::vector<double> arrivalGapsMs;
+    size_t disconnected = 0;
+    while (Clock::now() < end)
+    {
+        // Receive until the next frame, timestamping snapshot arrivals
+        while (true)
+        {
+            const auto now = Clock::now();
+            if (now >= nextFrame)
+                break;
+
+            fds.clear();
+            for (const auto& player : players)
+            {
+                const short events = player->connection.wantsWrite() ? POLLIN | POLLOUT : POLLIN;
+                fds.push_back({player->connection.fd(), events, 0});
+            }
+            const auto waitMs = std::chrono::ceil<std::chrono::milliseconds>(nextFrame - now).count();
+            if (poll(fds.data(), fds.size(), static_cast<int>(waitMs)) <= 0)
+                continue;
+
+            const auto arrival = Clock::now();
+            for (size_t i = 0; i < fds.size(); ++i)
+            {
+                FakePlayer& player = *players[i];
+                if (fds[i].revents == 0 || !player.connection.isOpen())
+                    continue;
+                if (fds[i].revents & POLLOUT)
+                {
+                    player.connection.flush();
+                }
+                if (!player.connection.receive())
+                {
+                    ++disconnected;
+                    continue;
+                }
+
+                const uint64_t snapshots = player.connection.snapshotsReceived();
+                if (snapshots > player.lastSnapshots)
+                {
+                    if (player.lastSnapshots > 0)
+                    {
+                        arrivalGapsMs.push_back(std::chrono::duration<double, std::milli>(arrival - player.lastSnapshotAt).count());
+                    }
+                    player.lastSnapshotAt = arrival;
+                    player.lastSnapshots = snapshots;
+                }
+            }
+        }
+
+        // Every player types and sends at most one batch per frame
+        for (auto& player : players)
+        {
+            if (!player->connection.isOpen())
+                continue;
+            player->bot->update(*player->surface, frameSeconds);
+            player->connection.flush();
+        }
+        nextFrame += frame;
+    }
+
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    uint64_t bytes = 0;
+    uint64_t snapshots = 0;
+    uint64_t missed = 0;
+    uint64_t keystrokes = 0;
+    int correctWords = 0;
+    for (const auto& player : players)
+    {
+        bytes += player->connection.bytesReceived();
+        snapshots += player->connection.snapshotsReceived();
+        missed += player->connection.ticksMissed();
+        keystrokes += player->surface->keystrokes;
+        const auto& scores = player->connection.mirror().scores();
+        const PlayerId id = player->connection.player();
+        if (id < scores.size())
+        {
+            correctWords += scores[id].correctWords;
+        }
+    }
+
+    const double clients = static_cast<double>(std::max<size_t>(1, players.size()));
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "clients:              " << players.size() << " (" << disconnected << " disconnected)\n";
+    std::cout << "snapshots/s/client:   " << static_cast<double>(snapshots) / seconds / clients << "\n";
+    std::cout << "missed ticks:         " << missed << "\n";
+    std::cout << "arrival gap ms:       p50 " << percentile(arrivalGapsMs, 0.5) << "  p99 " << percentile(arrivalGapsMs, 0.99) << "  max "
+              << percentile(arrivalGapsMs, 1.0) << "\n";
+    std::cout << "bytes/snapshot:       " << (snapshots > 0 ? static_cast<double>(bytes) / static_cast<double>(snapshots) : 0.0) << "\n";
+    std::cout << "KiB/s in (all):       " << static_cast<double>(bytes) / seconds / 1024.0 << "\n";
+    std::cout << "keystrokes/s (all):   " << static_cast<double>(keystrokes) / seconds << "\n";
+    std::cout << "words scored (race):  " << correctWords << "\n";
+    return 0;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Socket.h"
+#include "engine/BotTypist.h"
+#include <cstdint>
+
+struct LoadTestOptions
+{
+    Endpoint endpoint;
+    int clients = 100;
+    float seconds = 30.0f;
+    int frameRate = 60; // How often each fake player polls, types and flushes its batch
+    BotProfile profile;
+    uint32_t seed = 1;
+};
+
+// Connects many bot players from one process, each typing through its own
+// connection and mirror, and reports what the clients observed: snapshot
+// rate, missed ticks, inter-arrival jitter and bandwidth. Returns an exit code.
+int runLoadTest(const LoadTestOptions& options);
@@ -0,0 +1,123 @@
+#include "RaceConnection.h"
+
+RaceConnection::~RaceConnection()
+{
+    close();
+}
+
+bool RaceConnection::open(const Endpoint& endpoint, std::string_view name, std::string& error)
+{
+    close();
+    m_fd = net::connectTo(endpoint, error);
+    if (m_fd < 0)
+        return false;
+
+    race::appendFrame(m_outbox, race::MessageType::Hello, race::encodeHello(name));
+    return flush();
+}
+
+void RaceConnection::close()
+{
+    net::closeSocket(m_fd);
+    m_fd = -1;
+    m_reader = race::FrameReader();
+    m_mirror.reset();
+    m_welcomed = false;
+    m_outbox.clear();
+    m_sent = 0;
+}
+
+bool RaceConnection::receive()
+{
+    if (m_fd < 0)
+        return false;
+
+    char buffer[16384];
+    while (true)
+    {
+        const long received = net::receiveSome(m_fd, buffer, sizeof(buffer));
+        if (received < 0)
+        {
+            close();
+            return false;
+        }
+        if (received == 0)
+            break;
+
+        m_bytesReceived += static_cast<uint64_t>(received);
+        m_reader.append(buffer, static_cast<size_t>(received));
+        race::MessageType type;
+        std::string_view body;
+        while (m_reader.next(type, body))
+        {
+            if (!handleFrame(type, body))
+            {
+                close();
+                return false;
+            }
+        }
+        if (m_reader.broken())
+        {
+            close();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RaceConnection::handleFrame(race::MessageType type, std::string_view body)
+{
+    switch (type)
+    {
+    case race::MessageType::Welcome:
+        if (!race::decodeWelcome(body, m_welcome))
+            return false;
+        // A new race: the keyframe right behind this message rebuilds the board
+        m_welcomed = true;
+        m_raceOver = false;
+        m_mirror.reset();
+        m_pendingKeys.clear();
+        return true;
+    case race::MessageType::Snapshot:
+    {
+        const uint64_t previousTick = m_mirror.tick();
+        const bool wasSynced = m_mirror.synced();
+        ++m_snapshots;
+        m_mirror.apply(body);
+        if (wasSynced && m_mirror.tick() > previousTick + 1)
+        {
+            m_ticksMissed += m_mirror.tick() - previousTick - 1;
+        }
+        return true;
+    }
+    case race::MessageType::RaceOver:
+        m_raceOver = true;
+        return true;
+    default:
+        // Unknown server messages are skipped for forward compatibility
+        return true;
+    }
+}
+
+bool RaceConnection::flush()
+{
+    if (m_fd < 0)
+        return false;
+
+    if (!m_pendingKeys.empty())
+    {
+        race::appendFrame(m_outbox, race::MessageType::Input, m_pendingKeys);
+        m_pendingKeys.clear();
+    }
+    if (!net::sendSome(m_fd, m_outbox, m_sent))
+    {
+        close();
+        return false;
+    }
+    if (m_sent == m_outbox.size())
+    {
+        m_outbox.clear();
+        m_sent = 0;
+    }
+    return true;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Socket.h"
+#include "net/RaceProtocol.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Client end of a race: mirrors the server's board and batches keystrokes
+// into one Input message per flush(). Not thread-safe.
+class RaceConnection
+{
+public:
+    RaceConnection() = default;
+    ~RaceConnection();
+
+    RaceConnection(const RaceConnection&) = delete;
+    RaceConnection& operator=(const RaceConnection&) = delete;
+
+    bool open(const Endpoint& endpoint, std::string_view name, std::string& error);
+    void close();
+    int fd() const { return m_fd; }
+    bool isOpen() const { return m_fd >= 0; }
+
+    // Reads and applies everything the server sent. Returns false once the
+    // connection is gone.
+    bool receive();
+    void queueKeys(std::string_view keys) { m_pendingKeys += keys; }
+    // Sends the batched keys as a single message. Returns false once the
+    // connection is gone.
+    bool flush();
+    bool wantsWrite() const { return m_sent < m_outbox.size(); }
+
+    const race::RaceMirror& mirror() const { return m_mirror; }
+    bool welcomed() const { return m_welcomed; }
+    PlayerId player() const { return m_welcome.player; }
+    uint32_t raceNumber() const { return m_welcome.raceNumber; }
+    bool raceOver() const { return m_raceOver; }
+
+    // Traffic counters for the load test
+    uint64_t bytesReceived() const { return m_bytesReceived; }
+    uint64_t snapshotsReceived() const { return m_snapshots; }
+    // Ticks the server published that never reached this client's mirror
+    uint64_t ticksMissed() const { return m_ticksMissed; }
+
+private:
+    int m_fd = -1;
+    race::FrameReader m_reader;
+    race::RaceMirror m_mirror;
+    race::Welcome m_welcome;
+    bool m_welcomed = false;
+    bool m_raceOver = false;
+    std::string m_pendingKeys;
+    std::string m_outbox;
+    size_t m_sent = 0;
+    uint64_t m_bytesReceived = 0;
+    uint64_t m_snapshots = 0;
+    uint64_t m_ticksMissed = 0;
+
+    bool handleFrame(race::MessageType type, std::string_view body);
+};
@@ -0,0 +1,375 @@
+#include "RaceServer.h"
+#include "utils/Trace.h"
+#include "utils/Varint.h"
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <poll.h>
+
+RaceServer::RaceServer(const WordManager& words, const RaceServerOptions& options) : m_options(options), m_engine(words)
+{
+    m_options.tickRate = std::max(1, m_options.tickRate);
+}
+
+RaceServer::~RaceServer()
+{
+    for (auto& client : m_clients)
+    {
+        net::closeSocket(client->fd);
+    }
+    net::closeSocket(m_listenFd);
+}
+
+bool RaceServer::listen(std::string& error)
+{
+    m_listenFd = net::listenOn(m_options.endpoint, error);
+    return m_listenFd >= 0;
+}
+
+void RaceServer::run(const std::atomic<bool>& stop)
+{
+    trace::setThreadName("race server");
+    const auto tickDuration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / m_options.tickRate));
+    startRace();
+
+    std::vector<pollfd> fds;
+    auto nextTick = Clock::now() + tickDuration;
+    while (!stop.load())
+    {
+        // Serve sockets until the tick is due; inputs are applied as they arrive
+        while (!stop.load())
+        {
+            const auto now = Clock::now();
+            if (now >= nextTick)
+                break;
+
+            fds.clear();
+            fds.push_back({m_listenFd, POLLIN, 0});
+            for (const auto& client : m_clients)
+            {
+                const short events = client->sent < client->outbox.size() ? POLLIN | POLLOUT : POLLIN;
+                fds.push_back({client->fd, events, 0});
+            }
+
+            const auto waitMs = std::chrono::ceil<std::chrono::milliseconds>(nextTick - now).count();
+            if (poll(fds.data(), fds.size(), static_cast<int>(waitMs)) <= 0)
+                continue;
+
+            if (fds[0].revents & POLLIN)
+            {
+                acceptClients();
+            }
+            // acceptClients() appends, so only the clients polled above are checked
+            for (size_t i = 1; i < fds.size(); ++i)
+            {
+                Client& client = *m_clients[i - 1];
+                if (fds[i].revents & (POLLIN | POLLHUP | POLLERR))
+                {
+                    readClient(client);
+                }
+                if (!client.closed && (fds[i].revents & POLLOUT))
+                {
+                    flush(client);
+                }
+            }
+            dropClosed();
+        }
+
+        tick();
+
+        // After a stall, skip the missed ticks instead of running a burst of them
+        nextTick += tickDuration;
+        const auto now = Clock::now();
+        if (nextTick < now - 4 * tickDuration)
+        {
+            nextTick = now + tickDuration;
+        }
+    }
+}
+
+void RaceServer::startRace()
+{
+    ++m_raceNumber;
+    m_tick = 0;
+    m_racing = true;
+
+    GameSettings settings = m_options.settings;
+    settings.botOpponent = false;
+    m_engine.start(m_options.screenWidth, settings, m_options.seed + m_raceNumber * 0x9e3779b9u);
+    for (int i = 0; i < m_options.houseBots; ++i)
+    {
+        m_engine.addBotOpponent(m_options.houseBotProfile);
+    }
+    m_encoder.reset();
+    m_encoder.encodeDelta(m_engine, m_tick);
+
+    // Player ids restart with every race
+    m_freePlayers.clear();
+    for (auto& client : m_clients)
+    {
+        if (client->joined)
+        {
+            join(*client);
+        }
+    }
+}
+
+void RaceServer::tick()
+{
+    if (!m_racing)
+    {
+        if (Clock::now() >= m_nextRaceAt)
+        {
+            startRace();
+        }
+        return;
+    }
+
+    TYPEIT_TRACE_SCOPE("RaceServer::tick");
+    const auto workStart = Clock::now();
+    m_engine.update(1.0f / static_cast<float>(m_options.tickRate));
+    ++m_tick;
+
+    std::string frame;
+    race::appendFrame(frame, race::MessageType::Snapshot, m_encoder.encodeDelta(m_engine, m_tick));
+    for (auto& client : m_clients)
+    {
+        if (client->joined)
+        {
+            queueRaw(*client, frame);
+            flush(*client);
+        }
+    }
+
+    if (m_engine.isGameOver())
+    {
+        finishRace();
+    }
+
+    const double work = std::chrono::duration<double>(Clock::now() - workStart).count();
+    ++m_stats.ticks;
+    m_stats.tickWorkSeconds += work;
+    m_stats.maxTickWorkSeconds = std::max(m_stats.maxTickWorkSeconds, work);
+    reportStats();
+}
+
+void RaceServer::finishRace()
+{
+    m_racing = false;
+    m_nextRaceAt = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(m_options.restartDelay));
+
+    std::string body;
+    varint::put(body, static_cast<uint64_t>(m_options.restartDelay * 1000.0f));
+    for (auto& client : m_clients)
+    {
+        if (client->joined)
+        {
+            queue(*client, race::MessageType::RaceOver, body);
+            flush(*client);
+        }
+    }
+}
+
+void RaceServer::acceptClients()
+{
+    while (true)
+    {
+        const int fd = net::acceptClient(m_listenFd);
+        if (fd < 0)
+            return;
+        if (m_clients.size() >= m_options.maxClients)
+        {
+            net::closeSocket(fd);
+            continue;
+        }
+
+        auto client = std::make_unique<Client>();
+        client->fd = fd;
+        m_clients.push_back(std::move(client));
+    }
+}
+
+void RaceServer::readClient(Client& client)
+{
+    char buffer[4096];
+    while (!client.closed)
+    {
+        const long received = net::receiveSome(client.fd, buffer, sizeof(buffer));
+        if (received < 0)
+        {
+            client.closed = true;
+            return;
+        }
+        if (received == 0)
+            return;
+
+        client.reader.append(buffer, static_cast<size_t>(received));
+        race::MessageType type;
+        std::string_view body;
+        while (!client.closed && client.reader.next(type, body))
+        {
+            handleFrame(client, type, body);
+        }
+        if (client.reader.broken())
+        {
+            client.closed = true;
+        }
+    }
+}
+
+void RaceServer::handleFrame(Client& client, race::MessageType type, std::string_view body)
+{
+    switch (type)
+    {
+    case race::MessageType::Hello:
+        if (client.joined || !race::decodeHello(body, client.name))
+        {
+            client.closed = true;
+            return;
+        }
+        client.joined = true;
+        join(client);
+        return;
+    case race::MessageType::Input:
+        if (client.joined)
+        {
+            ++m_stats.inputMessages;
+            applyInput(client, body);
+        }
+        return;
+    default:
+        client.closed = true;
+        return;
+    }
+}
+
+void RaceServer::join(Client& client)
+{
+    if (!m_freePlayers.empty())
+    {
+        client.player = m_freePlayers.back();
+        m_freePlayers.pop_back();
+        m_engine.resetPlayer(client.player);
+    }
+    else if (m_engine.getPlayerCount() <= std::numeric_limits<PlayerId>::max())
+    {
+        client.player = m_engine.addPlayer();
+    }
+    else
+    {
+        // A wrapped id would hand the client someone else's slot
+        client.joined = false;
+        client.closed = true;
+        return;
+    }
+
+    queue(client, race::MessageType::Welcome, race::encodeWelcome({client.player, m_raceNumber}));
+    queue(client, race::MessageType::Snapshot, m_encoder.encodeKeyframe(m_engine, m_tick));
+    if (!m_racing)
+    {
+        std::string body;
+        const auto left = std::chrono::duration<float>(m_nextRaceAt - Clock::now()).count();
+        varint::put(body, static_cast<uint64_t>(std::max(0.0f, left * 1000.0f)));
+        queue(client, race::MessageType::RaceOver, body);
+    }
+    flush(client);
+}
+
+void RaceServer::applyInput(const Client& client, std::string_view keys)
+{
+    for (char key : keys)
+    {
+        if (key == race::kSubmitKey)
+            m_engine.handleSpace(client.player);
+        else if (key == race::kBackspaceKey)
+            m_engine.handleBackspace(client.player);
+        // Letters past the capacity can't spell any word; dropping them keeps a
+        // client that never submits from growing its input without bound
+        else if (m_engine.getCurrentInput(client.player).size() < GameEngine::kInputCapacity)
+            m_engine.handleCharInput(key, client.player);
+    }
+}
+
+void RaceServer::queue(Client& client, race::MessageType type, std::string_view body)
+{
+    std::string frame;
+    race::appendFrame(frame, type, body);
+    queueRaw(client, frame);
+}
+
+void RaceServer::queueRaw(Client& client, std::string_view frame)
+{
+    if (client.closed)
+        return;
+    if (client.outbox.size() - client.sent + frame.size() > m_options.maxQueuedBytes)
+    {
+        // Too far behind to catch up; buffering more would only grow memory
+        client.closed = true;
+        return;
+    }
+    client.outbox.append(frame);
+}
+
+void RaceServer::flush(Client& client)
+{
+    if (client.closed)
+        return;
+
+    const size_t before = client.sent;
+    if (!net::sendSome(client.fd, client.outbox, client.sent))
+    {
+        client.closed = true;
+        return;
+    }
+    m_stats.bytesOut += client.sent - before;
+
+    if (client.sent == client.outbox.size())
+    {
+        client.outbox.clear();
+        client.sent = 0;
+    }
+    else if (client.sent > 64 * 1024)
+    {
+        client.outbox.erase(0, client.sent);
+        client.sent = 0;
+    }
+}
+
+void RaceServer::dropClosed()
+{
+    // The tail left by remove_if holds moved-from pointers, so close inside the predicate
+    auto closed = std::remove_if(
+        m_clients.begin(),
+        m_clients.end(),
+        [this](const std::unique_ptr<Client>& client)
+        {
+            if (client->closed)
+            {
+                net::closeSocket(client->fd);
+                if (client->joined)
+                {
+                    m_freePlayers.push_back(client->player);
+                }
+            }
+            return client->closed;
+        }
+    );
+    m_clients.erase(closed, m_clients.end());
+}
+
+void RaceServer::reportStats()
+{
+    if (m_options.statsInterval <= 0.0f)
+        return;
+
+    const double elapsed = std::chrono::duration<double>(Clock::now() - m_stats.since).count();
+    if (elapsed < m_options.statsInterval)
+        return;
+
+    const double ticks = static_cast<double>(std::max<uint64_t>(1, m_stats.ticks));
+    std::cerr << "race " << m_raceNumber << ": " << m_clients.size() << " clients, " << static_cast<int>(m_stats.ticks / elapsed) << " ticks/s, tick work avg "
+              << static_cast<int>(m_stats.tickWorkSeconds / ticks * 1e6) << " us max " << static_cast<int>(m_stats.maxTickWorkSeconds * 1e6) << " us, "
+              << static_cast<int>(m_stats.bytesOut / elapsed / 1024.0) << " KiB/s out, " << static_cast<int>(m_stats.inputMessages / elapsed)
+              << " input batches/s\n";
+    m_stats = LoadStats();
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "Socket.h"
+#include "engine/BotTypist.h"
+#include "engine/GameEngine.h"
+#include "managers/WordManager.h"
+#include "net/RaceProtocol.h"
+#include "utils/GameConfig.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct RaceServerOptions
+{
+    Endpoint endpoint;
+    int tickRate = 60;
+    int screenWidth = 100;
+    float restartDelay = 5.0f;             // Seconds between the end of a race and the next one
+    size_t maxClients = 250;
+    size_t maxQueuedBytes = 256 * 1024;    // A client further behind than this is dropped
+    int houseBots = 0;                     // Server-side bot opponents in every race
+    BotProfile houseBotProfile;
+    float statsInterval = 5.0f;            // Seconds between load reports on stderr, 0 disables
+    GameSettings settings;
+    uint32_t seed = 1;
+};
+
+// Single-threaded authoritative race. One poll() loop accepts clients,
+// applies their input batches as they arrive, and at every fixed tick
+// advances the engine and broadcasts one delta snapshot, encoded once and
+// shared by all clients. Clients that stop reading are dropped instead of
+// buffering without bound.
+class RaceServer
+{
+public:
+    RaceServer(const WordManager& words, const RaceServerOptions& options);
+    ~RaceServer();
+
+    bool listen(std::string& error);
+    // Runs races back to back until stop is set
+    void run(const std::atomic<bool>& stop);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Client
+    {
+        int fd = -1;
+        race::FrameReader reader;
+        std::string outbox;
+        size_t sent = 0;
+        std::string name;
+        PlayerId player = 0;
+        bool joined = false;
+        bool closed = false;
+    };
+
+    // Load figures since the last report
+    struct LoadStats
+    {
+        uint64_t ticks = 0;
+        uint64_t inputMessages = 0;
+        uint64_t bytesOut = 0;
+        double tickWorkSeconds = 0.0;
+        double maxTickWorkSeconds = 0.0;
+        Clock::time_point since = Clock::now();
+    };
+
+    RaceServerOptions m_options;
+    GameEngine m_engine;
+    race::SnapshotEncoder m_encoder;
+    int m_listenFd = -1;
+    std::vector<std::unique_ptr<Client>> m_clients;
+    // Engine slots of clients that left during this race, handed to the next
+    // ones to join so reconnecting clients can't grow the player list
+    std::vector<PlayerId> m_freePlayers;
+    uint32_t m_raceNumber = 0;
+    uint64_t m_tick = 0;
+    bool m_racing = false;
+    Clock::time_point m_nextRaceAt;
+    LoadStats m_stats;
+
+    void startRace();
+    void tick();
+    void finishRace();
+    void acceptClients();
+    void readClient(Client& client);
+    void handleFrame(Client& client, race::MessageType type, std::string_view body);
+    // Drops the client instead once every PlayerId is taken
+    void join(Client& client);
+    void applyInput(const Client& client, std::string_view keys);
+    void queue(Client& client, race::MessageType type, std::string_view body);
+    void queueRaw(Client& client, std::string_view frame);
+    void flush(Client& client);
+    void dropClosed();
+    void reportStats();
+};
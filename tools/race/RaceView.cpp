@@ -0,0 +1,205 @@
+#include "RaceView.h"
+#include "RaceConnection.h"
+#include "screens/WordPalette.h"
+#include "ftxui/component/component.hpp"
+#include "ftxui/component/event.hpp"
+#include "ftxui/component/screen_interactive.hpp"
+#include "ftxui/dom/canvas.hpp"
+#include "ftxui/dom/elements.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <iostream>
+#include <mutex>
+#include <poll.h>
+#include <thread>
+#include <vector>
+
+using namespace ftxui;
+
+namespace
+{
+constexpr int kFrameMs = 16;
+constexpr size_t kLeaderboardSize = 5;
+
+struct ViewState
+{
+    std::mutex mutex;
+    RaceConnection connection;
+    std::string input; // Local echo, the server only sees the batched keys
+    uint32_t raceNumber = 0;
+};
+
+Element renderBoard(const race::RaceMirror& mirror, const WordPalette& palette)
+{
+    return canvas(
+               [&mirror, &palette](Canvas& c)
+               {
+                   const int width = c.width();
+                   const int height = c.height() / 2;
+                   for (const auto& fw : mirror.words())
+                   {
+                       if (!fw.isVisible(mirror.width()))
+                           continue;
+
+                       // The server's board is scaled onto whatever the terminal has
+                       const float scaleX = static_cast<float>(width) / static_cast<float>(mirror.width());
+                       const int x = std::clamp(static_cast<int>(std::round(fw.x * scaleX)), 0, std::max(0, width - 1));
+                       const int y = std::clamp(static_cast<int>(std::round(fw.y * 2.0f)), 0, std::max(0, height * 2 - 2));
+                       c.DrawText(x, y, fw.word.text, palette.colorAt(fw.lifeProgress));
+                   }
+               }
+           ) |
+           flex;
+}
+
+Element renderLeaderboard(const race::RaceMirror& mirror, PlayerId self)
+{
+    // Player 0 is the shared board, not a racer
+    std::vector<race::PlayerScore> ranking;
+    for (const auto& score : mirror.scores())
+    {
+        if (score.player != kLocalPlayer)
+        {
+            ranking.push_back(score);
+        }
+    }
+    std::sort(ranking.begin(), ranking.end(), [](const auto& a, const auto& b) { return a.correctWords > b.correctWords; });
+
+    Elements rows;
+    for (size_t i = 0; i < ranking.size() && i < kLeaderboardSize; ++i)
+    {
+        const auto& score = ranking[i];
+        auto row = text(std::to_string(i + 1) + ". Player " + std::to_string(score.player) + "  " + std::to_string(score.correctWords));
+        rows.push_back(score.player == self ? row | bold | color(Color::Cyan) : row | dim);
+    }
+    return hbox({text("Top: ") | bold, hbox(std::move(rows))});
+}
+
+Element render(ViewState& state, const WordPalette& palette)
+{
+    std::lock_guard lock(state.mutex);
+    const auto& connection = state.connection;
+    const auto& mirror = connection.mirror();
+    if (!connection.isOpen())
+        return text("Disconnected from the race server. Esc to quit.") | center | border;
+    if (!mirror.synced())
+        return text("Waiting for the race to start...") | center | border;
+
+    const int seconds = static_cast<int>(mirror.gameTime());
+    const int mine = connection.player() < mirror.scores().size() ? mirror.scores()[connection.player()].correctWords : 0;
+    Element status = connection.raceOver() ? text("Race over, next one starting soon") | bold | color(Color::Yellow)
+                                           : text("Words: " + std::to_string(mine)) | bold;
+
+    return vbox({
+               hbox({
+                   text("Race #" + std::to_string(connection.raceNumber())) | bold | color(Color::Cyan),
+                   text("  Time: " + std::to_string(seconds / 60) + ":" + (seconds % 60 < 10 ? "0" : "") + std::to_string(seconds % 60)),
+                   text("  Board: "),
+                   gauge(mirror.health() / 100.0f) | color(Color::Green) | flex,
+                   text("  "),
+                   status,
+               }),
+               separator(),
+               renderBoard(mirror, palette) | flex,
+               separator(),
+               hbox({text("Input: ") | bold, text(state.input) | color(Color::Cyan) | bold, text("_") | blink}),
+               renderLeaderboard(mirror, connection.player()),
+           }) |
+           border;
+}
+} // namespace
+
+int runRaceView(const Endpoint& endpoint, const std::string& name, const GameSettings& settings)
+{
+    ViewState state;
+    std::string error;
+    if (!state.connection.open(endpoint, name, error))
+    {
+        std::cerr << "Cannot join " << endpoint.describe() << ": " << error << "\n";
+        return 1;
+    }
+
+    auto screen = ScreenInteractive::Fullscreen();
+    std::atomic<bool> running = true;
+    std::thread network(
+        [&]
+        {
+            while (running)
+            {
+                int fd = -1;
+                {
+                    std::lock_guard lock(state.mutex);
+                    fd = state.connection.fd();
+                }
+                if (fd < 0)
+                {
+                    screen.Post(Event::Custom);
+                    return;
+                }
+
+                pollfd pfd{fd, POLLIN, 0};
+                poll(&pfd, 1, kFrameMs);
+                {
+                    // Keys typed since the last pass leave as one batch
+                    std::lock_guard lock(state.mutex);
+                    state.connection.receive();
+                    state.connection.flush();
+                    if (state.connection.raceNumber() != state.raceNumber)
+                    {
+                        state.raceNumber = state.connection.raceNumber();
+                        state.input.clear();
+                    }
+                }
+                screen.Post(Event::Custom);
+            }
+        }
+    );
+
+    const WordPalette palette(settings, WordPalette::detectDepth());
+    auto component = Renderer([&] { return render(state, palette); });
+    component |= CatchEvent(
+        [&](Event event)
+        {
+            if (event == Event::Escape)
+            {
+                screen.Exit();
+                return true;
+            }
+
+            std::lock_guard lock(state.mutex);
+            if (event == Event::Character(' ') || event == Event::Return)
+            {
+                state.connection.queueKeys(std::string_view(&race::kSubmitKey, 1));
+                state.input.clear();
+                return true;
+            }
+            if (event == Event::Backspace)
+            {
+                state.connection.queueKeys(std::string_view(&race::kBackspaceKey, 1));
+                if (!state.input.empty())
+                {
+                    state.input.pop_back();
+                }
+                return true;
+            }
+            if (event.is_character())
+            {
+                const char c = event.character()[0];
+                if (std::isalpha(static_cast<unsigned char>(c)))
+                {
+                    state.connection.queueKeys(std::string_view(&c, 1));
+                    state.input += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+                }
+                return true;
+            }
+            return false;
+        }
+    );
+
+    screen.Loop(component);
+    running = false;
+    network.join();
+    return 0;
+}
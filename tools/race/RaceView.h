@@ -0,0 +1,10 @@
+#pragma once
+
+#include "Socket.h"
+#include "utils/GameConfig.h"
+#include <string>
+
+// Terminal client: joins a race server and plays with the keyboard. The
+// network thread batches the keys typed during each frame into one message.
+// Word colours follow settings' thresholds. Returns an exit code.
+int runRaceView(const Endpoint& endpoint, const std::string& name, const GameSettings& settings);
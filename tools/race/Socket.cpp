@@ -0,0 +1,211 @@
+#include "Socket.h"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+#ifdef MSG_NOSIGNAL
+constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+constexpr int kSendFlags = 0;
+#endif
+
+bool fillUnixAddress(const std::string& path, sockaddr_un& address, std::string& error)
+{
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path))
+    {
+        error = "socket path too long: " + path;
+        return false;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+sockaddr_in loopbackAddress(int port)
+{
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(port));
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return address;
+}
+
+int fail(int fd, std::string& error, const char* what)
+{
+    error = std::string(what) + ": " + std::strerror(errno);
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+    return -1;
+}
+
+// A socket file left behind by a server that crashed: nothing accepts on it.
+// Anything else at the path (a regular file, a live server) is left alone.
+bool isStaleSocket(const std::string& path, const sockaddr_un& address)
+{
+    struct stat info;
+    if (lstat(path.c_str(), &info) != 0 || !S_ISSOCK(info.st_mode))
+        return false;
+
+    const int probe = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (probe < 0)
+        return false;
+    const bool refused = connect(probe, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0 && errno == ECONNREFUSED;
+    close(probe);
+    return refused;
+}
+
+void disableNagle(int fd)
+{
+    // Snapshots are small and latency-bound
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+}
+} // namespace
+
+std::string Endpoint::describe() const
+{
+    return port > 0 ? "127.0.0.1:" + std::to_string(port) : socketPath;
+}
+
+namespace net
+{
+int listenOn(const Endpoint& endpoint, std::string& error)
+{
+    int fd = -1;
+    if (endpoint.port > 0)
+    {
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0)
+            return fail(fd, error, "socket");
+        int one = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        const sockaddr_in address = loopbackAddress(endpoint.port);
+        if (bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0)
+            return fail(fd, error, "bind");
+    }
+    else
+    {
+        sockaddr_un address;
+        if (!fillUnixAddress(endpoint.socketPath, address, error))
+            return -1;
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0)
+            return fail(fd, error, "socket");
+        // A previous server that crashed leaves its socket file behind
+        if (isStaleSocket(endpoint.socketPath, address))
+        {
+            unlink(endpoint.socketPath.c_str());
+        }
+        if (bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0)
+            return fail(fd, error, errno == EADDRINUSE ? "bind (path in use by another server or file)" : "bind");
+    }
+
+    if (listen(fd, SOMAXCONN) < 0)
+        return fail(fd, error, "listen");
+    if (!setNonBlocking(fd))
+        return fail(fd, error, "fcntl");
+    return fd;
+}
+
+int connectTo(const Endpoint& endpoint, std::string& error)
+{
+    int fd = -1;
+    if (endpoint.port > 0)
+    {
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0)
+            return fail(fd, error, "socket");
+        const sockaddr_in address = loopbackAddress(endpoint.port);
+        if (connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0)
+            return fail(fd, error, "connect");
+        disableNagle(fd);
+    }
+    else
+    {
+        sockaddr_un address;
+        if (!fillUnixAddress(endpoint.socketPath, address, error))
+            return -1;
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0)
+            return fail(fd, error, "socket");
+        if (connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0)
+            return fail(fd, error, "connect");
+    }
+
+    if (!setNonBlocking(fd))
+        return fail(fd, error, "fcntl");
+    return fd;
+}
+
+int acceptClient(int listenFd)
+{
+    const int fd = accept(listenFd, nullptr, nullptr);
+    if (fd < 0)
+        return -1;
+    if (!setNonBlocking(fd))
+    {
+        close(fd);
+        return -1;
+    }
+    disableNagle(fd);
+    return fd;
+}
+
+bool setNonBlocking(int fd)
+{
+    const int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+void closeSocket(int fd)
+{
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+}
+
+bool sendSome(int fd, const std::string& data, size_t& offset)
+{
+    while (offset < data.size())
+    {
+        const ssize_t sent = send(fd, data.data() + offset, data.size() - offset, kSendFlags);
+        if (sent > 0)
+        {
+            offset += static_cast<size_t>(sent);
+            continue;
+        }
+        if (sent < 0 && errno == EINTR)
+            continue;
+        return sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+    }
+    return true;
+}
+
+long receiveSome(int fd, char* buffer, size_t size)
+{
+    while (true)
+    {
+        const ssize_t received = recv(fd, buffer, size, 0);
+        if (received > 0)
+            return static_cast<long>(received);
+        if (received == 0)
+            return -1;
+        if (errno == EINTR)
+            continue;
+        return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+    }
+}
+} // namespace net
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string>
+
+// Where the race server listens: a Unix socket path, or a loopback TCP port
+// when port is non-zero (handy for testing across containers)
+struct Endpoint
+{
+    std::string socketPath = "/tmp/typeit-race.sock";
+    int port = 0;
+
+    std::string describe() const;
+};
+
+// Thin POSIX socket helpers. All returned descriptors are non-blocking;
+// on failure they return -1 and fill error.
+namespace net
+{
+int listenOn(const Endpoint& endpoint, std::string& error);
+int connectTo(const Endpoint& endpoint, std::string& error);
+// Returns -1 when no connection is pending
+int acceptClient(int listenFd);
+bool setNonBlocking(int fd);
+void closeSocket(int fd);
+
+// Sends as much of data[offset..] as the socket takes, advancing offset.
+// Returns false when the peer is gone.
+bool sendSome(int fd, const std::string& data, size_t& offset);
+// Reads what is available into buffer. Returns the byte count, 0 when
+// nothing was pending, -1 when the peer closed or failed.
+long receiveSome(int fd, char* buffer, size_t size);
+} // namespace net
@@ -0,0 +1,175 @@
+#include "LoadTest.h"
+#include "RaceServer.h"
+#include "RaceView.h"
+#include "managers/WordManager.h"
+#include "utils/GameConfig.h"
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+
+namespace
+{
+const char* kUsage =
+    "Usage: typeit_race <serve|join|load> [options]\n"
+    "Office typing races: one server runs the game, terminal clients race for the same words.\n"
+    "Connection (all modes):\n"
+    "  --socket <path>       Unix socket (default /tmp/typeit-race.sock)\n"
+    "  --port <n>            Loopback TCP port instead of the Unix socket\n"
+    "serve:\n"
+    "  --tick-rate <hz>      Simulation and broadcast rate (default 60)\n"
+    "  --max-clients <n>     Connection limit (default 250)\n"
+    "  --house-bots <n>      Server-side bot opponents per race (default 0)\n"
+    "  --restart <seconds>   Pause between races (default 5)\n"
+    "  --config <file>       Game settings (default data/config.ini)\n"
+    "  --words <file>        Word list (default data/words.txt)\n"
+    "  --seed <n>            Seed of the first race (default: random)\n"
+    "join:\n"
+    "  --name <name>         Name sent to the server\n"
+    "load:\n"
+    "  --clients <n>         Fake players (default 100)\n"
+    "  --seconds <n>         Test duration (default 30)\n"
+    "  --wpm <n>             Fake player speed (default 60)\n"
+    "  --errors <rate>       Fake player typo chance per keystroke (default 0.03)\n";
+
+std::atomic<bool> g_stop = false;
+
+void onSignal(int)
+{
+    g_stop = true;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2 || std::string(argv[1]) == "-h" || std::string(argv[1]) == "--help")
+    {
+        std::cout << kUsage;
+        return argc < 2 ? 1 : 0;
+    }
+
+    const std::string mode = argv[1];
+    if (mode != "serve" && mode != "join" && mode != "load")
+    {
+        std::cerr << "Unknown mode: " << mode << "\n" << kUsage;
+        return 1;
+    }
+
+    Endpoint endpoint;
+    RaceServerOptions server;
+    server.seed = std::random_device{}();
+    LoadTestOptions load;
+    load.profile.errorRate = 0.03f;
+    std::string name = "player";
+    std::string configPath = GamePaths::CONFIG_FILE;
+    std::string wordsPath = GamePaths::WORDS_FILE;
+
+    for (int i = 2; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (i + 1 >= argc)
+        {
+            std::cerr << "Missing value for " << arg << "\n" << kUsage;
+            return 1;
+        }
+
+        const std::string value = argv[++i];
+        try
+        {
+            if (arg == "--socket")
+                endpoint.socketPath = value;
+            else if (arg == "--port")
+                endpoint.port = std::stoi(value);
+            else if (arg == "--tick-rate")
+                server.tickRate = std::stoi(value);
+            else if (arg == "--max-clients")
+                server.maxClients = static_cast<size_t>(std::max(1, std::stoi(value)));
+            else if (arg == "--house-bots")
+                server.houseBots = std::stoi(value);
+            else if (arg == "--restart")
+                server.restartDelay = std::stof(value);
+            else if (arg == "--config")
+                configPath = value;
+            else if (arg == "--words")
+                wordsPath = value;
+            else if (arg == "--seed")
+                server.seed = static_cast<uint32_t>(std::stoul(value));
+            else if (arg == "--name")
+                name = value;
+            else if (arg == "--clients")
+                load.clients = std::max(1, std::stoi(value));
+            else if (arg == "--seconds")
+                load.seconds = std::stof(value);
+            else if (arg == "--wpm")
+                load.profile.wpm = std::stof(value);
+            else if (arg == "--errors")
+                load.profile.errorRate = std::stof(value);
+            else
+            {
+                std::cerr << "Unknown option: " << arg << "\n" << kUsage;
+                return 1;
+            }
+        }
+        catch (...)
+        {
+            std::cerr << "Invalid value for " << arg << ": " << value << "\n";
+            return 1;
+        }
+    }
+
+    // A client vanishing mid-write must not kill the server
+    std::signal(SIGPIPE, SIG_IGN);
+
+    if (mode == "join")
+    {
+        // Word colours follow the local config
+        if (std::filesystem::exists(configPath))
+        {
+            ConfigManager::instance().loadFromFile(configPath);
+        }
+        return runRaceView(endpoint, name, ConfigManager::instance().settings());
+    }
+
+    if (mode == "load")
+    {
+        load.endpoint = endpoint;
+        load.seed = server.seed;
+        return runLoadTest(load);
+    }
+
+    if (std::filesystem::exists(configPath))
+    {
+        ConfigManager::instance().loadFromFile(configPath);
+    }
+    WordManager words;
+    if (!words.loadFromFile(wordsPath))
+    {
+        std::cerr << "Failed to load words from " << wordsPath << "\n";
+        return 1;
+    }
+
+    server.endpoint = endpoint;
+    server.settings = ConfigManager::instance().settings();
+    RaceServer raceServer(words, server);
+    std::string error;
+    if (!raceServer.listen(error))
+    {
+        std::cerr << "Cannot listen on " << endpoint.describe() << ": " << error << "\n";
+        return 1;
+    }
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+    std::cerr << "Race server on " << endpoint.describe() << ", Ctrl+C to stop\n";
+    raceServer.run(g_stop);
+
+    if (endpoint.port == 0)
+    {
+        std::error_code ec;
+        std::filesystem::remove(endpoint.socketPath, ec);
+    }
+    return 0;
+}
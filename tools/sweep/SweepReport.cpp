@@ -0,0 +1,151 @@
+#include "SweepReport.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+
+namespace
+{
+// Linear interpolation between closest ranks
+double percentile(const std::vector<double>& sorted, double p)
+{
+    if (sorted.empty())
+        return 0.0;
+    const double rank = p * static_cast<double>(sorted.size() - 1);
+    const auto lower = static_cast<size_t>(std::floor(rank));
+    const size_t upper = std::min(lower + 1, sorted.size() - 1);
+    return sorted[lower] + (sorted[upper] - sorted[lower]) * (rank - static_cast<double>(lower));
+}
+
+void writeDistributionJson(std::ostream& out, const Distribution& d)
+{
+    out << "{\"mean\": " << d.mean << ", \"stddev\": " << d.stddev << ", \"min\": " << d.min << ", \"p10\": " << d.p10
+        << ", \"p25\": " << d.p25 << ", \"p50\": " << d.p50 << ", \"p75\": " << d.p75 << ", \"p90\": " << d.p90 << ", \"max\": " << d.max
+        << "}";
+}
+
+std::string escapeJson(const std::string& text)
+{
+    std::string escaped;
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\')
+            escaped += '\\';
+        escaped += c;
+    }
+    return escaped;
+}
+} // namespace
+
+Distribution Distribution::of(std::vector<double> values)
+{
+    Distribution d;
+    if (values.empty())
+        return d;
+
+    std::sort(values.begin(), values.end());
+    const auto n = static_cast<double>(values.size());
+    d.mean = std::accumulate(values.begin(), values.end(), 0.0) / n;
+    double squares = 0.0;
+    for (double v : values)
+    {
+        squares += (v - d.mean) * (v - d.mean);
+    }
+    d.stddev = std::sqrt(squares / n);
+    d.min = values.front();
+    d.p10 = percentile(values, 0.10);
+    d.p25 = percentile(values, 0.25);
+    d.p50 = percentile(values, 0.50);
+    d.p75 = percentile(values, 0.75);
+    d.p90 = percentile(values, 0.90);
+    d.max = values.back();
+    return d;
+}
+
+SweepRow SweepRow::summarize(const SweepCell& cell)
+{
+    SweepRow row;
+    row.configLabel = cell.configLabel;
+    row.botWpm = cell.botWpm;
+    row.games = cell.games.size();
+
+    std::vector<double> survival;
+    std::vector<double> wpm;
+    double accuracy = 0.0;
+    for (const auto& game : cell.games)
+    {
+        survival.push_back(game.record.survivalTime);
+        wpm.push_back(game.record.wpm);
+        accuracy += game.record.accuracy;
+        row.timedOut += game.timedOut ? 1 : 0;
+    }
+    row.survival = Distribution::of(std::move(survival));
+    row.wpm = Distribution::of(std::move(wpm));
+    row.meanAccuracy = row.games > 0 ? accuracy / static_cast<double>(row.games) : 0.0;
+    return row;
+}
+
+std::string formatTable(const std::vector<SweepRow>& rows)
+{
+    size_t labelWidth = 6;
+    for (const auto& row : rows)
+    {
+        labelWidth = std::max(labelWidth, row.configLabel.size());
+    }
+
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1);
+    oss << std::left << std::setw(static_cast<int>(labelWidth)) << "config" << std::right << std::setw(6) << "bot" << std::setw(7) << "games"
+        << std::setw(9) << "timeout" << std::setw(28) << "survival s p10/p50/p90" << std::setw(22) << "WPM p10/p50/p90" << std::setw(8) << "acc%"
+        << "\n";
+    for (const auto& row : rows)
+    {
+        std::ostringstream survival;
+        survival << std::fixed << std::setprecision(1) << row.survival.p10 << " / " << row.survival.p50 << " / " << row.survival.p90;
+        std::ostringstream wpm;
+        wpm << std::fixed << std::setprecision(0) << row.wpm.p10 << " / " << row.wpm.p50 << " / " << row.wpm.p90;
+
+        oss << std::left << std::setw(static_cast<int>(labelWidth)) << row.configLabel << std::right << std::setw(6) << row.botWpm
+            << std::setw(7) << row.games << std::setw(9) << row.timedOut << std::setw(28) << survival.str() << std::setw(22) << wpm.str()
+            << std::setw(8) << row.meanAccuracy << "\n";
+    }
+    return oss.str();
+}
+
+std::string formatCsv(const std::vector<SweepRow>& rows)
+{
+    std::ostringstream oss;
+    oss << "Config,BotWPM,Games,TimedOut,SurvivalMean,SurvivalStddev,SurvivalMin,SurvivalP10,SurvivalP25,SurvivalP50,SurvivalP75,"
+           "SurvivalP90,SurvivalMax,WPMMean,WPMStddev,WPMMin,WPMP10,WPMP25,WPMP50,WPMP75,WPMP90,WPMMax,AccuracyMean\n";
+    for (const auto& row : rows)
+    {
+        oss << "\"" << row.configLabel << "\"," << row.botWpm << "," << row.games << "," << row.timedOut;
+        for (const Distribution* d : {&row.survival, &row.wpm})
+        {
+            oss << "," << d->mean << "," << d->stddev << "," << d->min << "," << d->p10 << "," << d->p25 << "," << d->p50 << "," << d->p75
+                << "," << d->p90 << "," << d->max;
+        }
+        oss << "," << row.meanAccuracy << "\n";
+    }
+    return oss.str();
+}
+
+std::string formatJson(const std::vector<SweepRow>& rows)
+{
+    std::ostringstream oss;
+    oss << "{\"results\": [";
+    for (size_t i = 0; i < rows.size(); ++i)
+    {
+        const auto& row = rows[i];
+        oss << (i == 0 ? "\n" : ",\n");
+        oss << "  {\"config\": \"" << escapeJson(row.configLabel) << "\", \"bot_wpm\": " << row.botWpm << ", \"games\": " << row.games
+            << ", \"timed_out\": " << row.timedOut << ", \"survival_seconds\": ";
+        writeDistributionJson(oss, row.survival);
+        oss << ", \"wpm\": ";
+        writeDistributionJson(oss, row.wpm);
+        oss << ", \"accuracy_mean\": " << row.meanAccuracy << "}";
+    }
+    oss << "\n]}\n";
+    return oss.str();
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "engine/HeadlessGame.h"
+#include <string>
+#include <vector>
+
+struct Distribution
+{
+    double mean = 0.0;
+    double stddev = 0.0;
+    double min = 0.0;
+    double p10 = 0.0;
+    double p25 = 0.0;
+    double p50 = 0.0;
+    double p75 = 0.0;
+    double p90 = 0.0;
+    double max = 0.0;
+
+    static Distribution of(std::vector<double> values);
+};
+
+// All games of one configuration played by one bot skill level
+struct SweepCell
+{
+    std::string configLabel;
+    float botWpm = 0.0f;
+    std::vector<HeadlessGameResult> games;
+};
+
+struct SweepRow
+{
+    std::string configLabel;
+    float botWpm = 0.0f;
+    size_t games = 0;
+    size_t timedOut = 0;
+    Distribution survival;
+    Distribution wpm;
+    double meanAccuracy = 0.0;
+
+    static SweepRow summarize(const SweepCell& cell);
+};
+
+std::string formatTable(const std::vector<SweepRow>& rows);
+std::string formatCsv(const std::vector<SweepRow>& rows);
+std::string formatJson(const std::vector<SweepRow>& rows);
@@ -0,0 +1,138 @@
+#include "SweepSpec.h"
+#include <cmath>
+#include <sstream>
+
+namespace
+{
+std::vector<std::string> split(const std::string& text, char delimiter)
+{
+    std::vector<std::string> parts;
+    std::istringstream iss(text);
+    std::string part;
+    while (std::getline(iss, part, delimiter))
+    {
+        parts.push_back(part);
+    }
+    return parts;
+}
+
+std::string formatValue(double value)
+{
+    std::ostringstream oss;
+    oss << value;
+    return oss.str();
+}
+} // namespace
+
+bool SweepSpec::addParameter(const std::string& text, std::string& error)
+{
+    const size_t eq = text.find('=');
+    if (eq == std::string::npos || eq == 0 || eq + 1 == text.size())
+    {
+        error = "Expected key=values, got '" + text + "'";
+        return false;
+    }
+
+    SweepParameter parameter;
+    parameter.key = text.substr(0, eq);
+    const std::string values = text.substr(eq + 1);
+
+    const auto range = split(values, ':');
+    if (range.size() == 3)
+    {
+        double from = 0.0;
+        double to = 0.0;
+        double step = 0.0;
+        try
+        {
+            from = std::stod(range[0]);
+            to = std::stod(range[1]);
+            step = std::stod(range[2]);
+        }
+        catch (...)
+        {
+            error = "Bad range for " + parameter.key + ": " + values;
+            return false;
+        }
+        if (step <= 0.0 || to < from)
+        {
+            error = "Range for " + parameter.key + " needs from <= to and a positive step";
+            return false;
+        }
+        // Indexing instead of accumulating keeps 0.1-style steps exact at the end
+        const auto count = static_cast<long long>(std::floor((to - from) / step + 1e-9)) + 1;
+        for (long long i = 0; i < count; ++i)
+        {
+            parameter.values.push_back(formatValue(from + static_cast<double>(i) * step));
+        }
+    }
+    else if (range.size() == 1)
+    {
+        parameter.values = split(values, ',');
+    }
+    else
+    {
+        error = "Bad value list for " + parameter.key + ": " + values;
+        return false;
+    }
+
+    // Validate every value against a scratch copy of the settings
+    GameSettings scratch;
+    for (const auto& value : parameter.values)
+    {
+        if (!ConfigManager::applySetting(scratch, parameter.key, value))
+        {
+            error = "Unknown setting or bad value: " + parameter.key + "=" + value;
+            return false;
+        }
+    }
+
+    parameters.push_back(std::move(parameter));
+    return true;
+}
+
+std::vector<SweepSpec::Config> SweepSpec::expand(const GameSettings& base) const
+{
+    std::vector<Config> configs{Config{"", base}};
+    for (const auto& parameter : parameters)
+    {
+        std::vector<Config> next;
+        next.reserve(configs.size() * parameter.values.size());
+        for (const auto& config : configs)
+        {
+            for (const auto& value : parameter.values)
+            {
+                Config expanded = config;
+                ConfigManager::applySetting(expanded.settings, parameter.key, value);
+                expanded.label += (expanded.label.empty() ? "" : " ") + parameter.key + "=" + value;
+                next.push_back(std::move(expanded));
+            }
+        }
+        configs = std::move(next);
+    }
+    if (configs.size() == 1 && configs[0].label.empty())
+    {
+        configs[0].label = "base";
+    }
+    return configs;
+}
+
+bool SweepSpec::parseFloatList(const std::string& text, std::vector<float>& values)
+{
+    std::vector<float> parsed;
+    try
+    {
+        for (const auto& part : split(text, ','))
+        {
+            parsed.push_back(std::stof(part));
+        }
+    }
+    catch (...)
+    {
+        return false;
+    }
+    if (parsed.empty())
+        return false;
+    values = std::move(parsed);
+    return true;
+}
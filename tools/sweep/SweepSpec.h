@@ -0,0 +1,39 @@
+#pragma once
+
+#include "utils/GameConfig.h"
+#include <string>
+#include <vector>
+
+// One swept config.ini key and the values it takes
+struct SweepParameter
+{
+    std::string key;
+    std::vector<std::string> values;
+};
+
+struct SweepSpec
+{
+    std::vector<SweepParameter> parameters;
+    std::vector<float> botWpm = {40.0f, 70.0f, 100.0f};
+    float botReactionTime = 0.35f;
+    float botErrorRate = 0.0f;
+    float botKeySpread = 0.35f;
+    int gamesPerConfig = 1000;
+    unsigned seed = 1;
+    float maxSeconds = 900.0f;
+    float tickSeconds = 1.0f / 60.0f;
+
+    // "health_loss=10:20:2.5" (inclusive range) or "health_loss=10,15,20".
+    // Returns false and fills error when the key is unknown or a value doesn't parse.
+    bool addParameter(const std::string& text, std::string& error);
+
+    // Cartesian product of every parameter, applied on top of base
+    struct Config
+    {
+        std::string label; // "health_loss=15 spawn_interval_decrease=0.02"
+        GameSettings settings;
+    };
+    std::vector<Config> expand(const GameSettings& base) const;
+
+    static bool parseFloatList(const std::string& text, std::vector<float>& values);
+};
@@ -0,0 +1,112 @@
+#include "WorkStealingPool.h"
+#include <algorithm>
+
+namespace
+{
+// Lets submit() find the calling worker's own deque
+thread_local const WorkStealingPool* t_pool = nullptr;
+thread_local size_t t_workerIndex = 0;
+} // namespace
+
+WorkStealingPool::WorkStealingPool(size_t threadCount)
+{
+    threadCount = std::max<size_t>(1, threadCount);
+    for (size_t i = 0; i < threadCount; ++i)
+    {
+        m_queues.push_back(std::make_unique<Queue>());
+    }
+    for (size_t i = 0; i < threadCount; ++i)
+    {
+        m_threads.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard lock(m_wakeMutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+void WorkStealingPool::submit(Task task)
+{
+    const size_t index = t_pool == this ? t_workerIndex : m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+    m_pending.fetch_add(1);
+    // Counted before the push so a worker can never take it below zero;
+    // a worker woken early just retries until the task lands
+    {
+        std::lock_guard lock(m_wakeMutex);
+        m_queued.fetch_add(1);
+    }
+    {
+        std::lock_guard lock(m_queues[index]->mutex);
+        m_queues[index]->tasks.push_back(std::move(task));
+    }
+    m_wake.notify_one();
+}
+
+void WorkStealingPool::wait()
+{
+    std::unique_lock lock(m_wakeMutex);
+    m_idle.wait(lock, [this] { return m_pending.load() == 0; });
+}
+
+bool WorkStealingPool::popLocal(size_t index, Task& task)
+{
+    Queue& queue = *m_queues[index];
+    std::lock_guard lock(queue.mutex);
+    if (queue.tasks.empty())
+        return false;
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::steal(size_t thief, Task& task)
+{
+    for (size_t offset = 1; offset < m_queues.size(); ++offset)
+    {
+        Queue& victim = *m_queues[(thief + offset) % m_queues.size()];
+        std::lock_guard lock(victim.mutex);
+        if (!victim.tasks.empty())
+        {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::workerLoop(size_t index)
+{
+    t_pool = this;
+    t_workerIndex = index;
+
+    while (true)
+    {
+        Task task;
+        if (popLocal(index, task) || steal(index, task))
+        {
+            m_queued.fetch_sub(1);
+            task();
+            if (m_pending.fetch_sub(1) == 1)
+            {
+                std::lock_guard lock(m_wakeMutex);
+                m_idle.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock lock(m_wakeMutex);
+        m_wake.wait(lock, [this] { return m_stopping || m_queued.load() > 0; });
+        if (m_stopping && m_queued.load() == 0)
+            return;
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of workers, each with its own task deque. A worker pops the
+// newest task from its own deque and, when that runs dry, steals the oldest
+// task from another worker, so uneven task costs (a long game next to a
+// short one) even out without a shared queue.
+class WorkStealingPool
+{
+public:
+    using Task = std::function<void()>;
+
+    explicit WorkStealingPool(size_t threadCount = std::thread::hardware_concurrency());
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // Tasks submitted from a worker go to that worker's own deque
+    void submit(Task task);
+    // Blocks until every submitted task has finished
+    void wait();
+
+    size_t threadCount() const { return m_threads.size(); }
+
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::vector<std::thread> m_threads;
+    std::atomic<size_t> m_queued = 0;  // Tasks sitting in deques
+    std::atomic<size_t> m_pending = 0; // Tasks not finished yet
+    std::atomic<size_t> m_nextQueue = 0;
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_idle;
+    bool m_stopping = false;
+
+    void workerLoop(size_t index);
+    bool popLocal(size_t index, Task& task);
+    bool steal(size_t thief, Task& task);
+};
@@ -0,0 +1,207 @@
+#include "SweepReport.h"
+#include "SweepSpec.h"
+#include "WorkStealingPool.h"
+#include "engine/HeadlessGame.h"
+#include "managers/WordManager.h"
+#include "utils/GameConfig.h"
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace
+{
+const char* kUsage =
+    "Usage: typeit_sweep [options]\n"
+    "Plays headless games with bot typists for every combination of the swept settings.\n"
+    "  --param <key=values>  config.ini key to sweep, as from:to:step or v1,v2,... (repeatable)\n"
+    "  --bots <wpm,...>      Bot skill levels in WPM (default 40,70,100)\n"
+    "  --reaction <seconds>  Bot pause before each word (default 0.35)\n"
+    "  --errors <rate>       Bot typo chance per keystroke (default 0)\n"
+    "  --spread <sigma>      Spread of the bot's inter-key intervals (default 0.35)\n"
+    "  --games <n>           Games per configuration and bot (default 1000)\n"
+    "  --threads <n>         Worker threads (default: all cores)\n"
+    "  --seed <n>            Base seed, results are reproducible per seed (default 1)\n"
+    "  --max-time <seconds>  Stop games that survive this long (default 900)\n"
+    "  --config <file>       Base settings (default: built-in defaults)\n"
+    "  --words <file>        Word list (default data/words.txt)\n"
+    "  --format <fmt>        table, csv or json (default table)\n";
+
+// Games per pool task; small enough to balance, large enough to amortize the task
+constexpr int kGamesPerTask = 8;
+
+uint32_t gameSeed(unsigned base, size_t cell, int game)
+{
+    // SplitMix64 finalizer, so neighbouring games get unrelated seeds
+    uint64_t z = (static_cast<uint64_t>(base) << 40) ^ (static_cast<uint64_t>(cell) << 20) ^ static_cast<uint64_t>(game);
+    z += 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return static_cast<uint32_t>(z ^ (z >> 31));
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    SweepSpec spec;
+    size_t threads = std::thread::hardware_concurrency();
+    std::string configPath;
+    std::string wordsPath = GamePaths::WORDS_FILE;
+    std::string format = "table";
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help")
+        {
+            std::cout << kUsage;
+            return 0;
+        }
+        if (i + 1 >= argc)
+        {
+            std::cerr << "Missing value for " << arg << "\n" << kUsage;
+            return 1;
+        }
+
+        const std::string value = argv[++i];
+        std::string error;
+        try
+        {
+            if (arg == "--param")
+            {
+                if (!spec.addParameter(value, error))
+                {
+                    std::cerr << error << "\n";
+                    return 1;
+                }
+            }
+            else if (arg == "--bots")
+            {
+                if (!SweepSpec::parseFloatList(value, spec.botWpm))
+                {
+                    std::cerr << "Bad bot list: " << value << "\n";
+                    return 1;
+                }
+            }
+            else if (arg == "--reaction")
+                spec.botReactionTime = std::stof(value);
+            else if (arg == "--errors")
+                spec.botErrorRate = std::stof(value);
+            else if (arg == "--spread")
+                spec.botKeySpread = std::stof(value);
+            else if (arg == "--games")
+                spec.gamesPerConfig = std::max(1, std::stoi(value));
+            else if (arg == "--threads")
+                threads = static_cast<size_t>(std::max(1, std::stoi(value)));
+            else if (arg == "--seed")
+                spec.seed = static_cast<unsigned>(std::stoul(value));
+            else if (arg == "--max-time")
+                spec.maxSeconds = std::stof(value);
+            else if (arg == "--config")
+                configPath = value;
+            else if (arg == "--words")
+                wordsPath = value;
+            else if (arg == "--format")
+                format = value;
+            else
+            {
+                std::cerr << "Unknown option: " << arg << "\n" << kUsage;
+                return 1;
+            }
+        }
+        catch (...)
+        {
+            std::cerr << "Invalid value for " << arg << ": " << value << "\n";
+            return 1;
+        }
+    }
+    if (format != "table" && format != "csv" && format != "json")
+    {
+        std::cerr << "Unknown format: " << format << "\n";
+        return 1;
+    }
+
+    // loadFromFile would write a default file when missing, check first
+    if (!configPath.empty())
+    {
+        if (!std::filesystem::exists(configPath))
+        {
+            std::cerr << "Config not found: " << configPath << "\n";
+            return 1;
+        }
+        ConfigManager::instance().loadFromFile(configPath);
+    }
+
+    WordManager words;
+    if (!words.loadFromFile(wordsPath))
+    {
+        std::cerr << "Failed to load words from " << wordsPath << "\n";
+        return 1;
+    }
+
+    const auto configs = spec.expand(ConfigManager::instance().settings());
+    std::vector<SweepCell> cells;
+    for (const auto& config : configs)
+    {
+        for (float wpm : spec.botWpm)
+        {
+            SweepCell cell;
+            cell.configLabel = config.label;
+            cell.botWpm = wpm;
+            cell.games.resize(static_cast<size_t>(spec.gamesPerConfig));
+            cells.push_back(std::move(cell));
+        }
+    }
+
+    HeadlessGameOptions options;
+    options.tickSeconds = spec.tickSeconds;
+    options.maxSeconds = spec.maxSeconds;
+
+    const auto start = std::chrono::steady_clock::now();
+    {
+        WorkStealingPool pool(threads);
+        for (size_t c = 0; c < cells.size(); ++c)
+        {
+            const GameSettings& settings = configs[c / spec.botWpm.size()].settings;
+            BotProfile bot;
+            bot.wpm = cells[c].botWpm;
+            bot.reactionTime = spec.botReactionTime;
+            bot.errorRate = spec.botErrorRate;
+            bot.keyIntervalSpread = spec.botKeySpread;
+            for (int first = 0; first < spec.gamesPerConfig; first += kGamesPerTask)
+            {
+                const int last = std::min(spec.gamesPerConfig, first + kGamesPerTask);
+                // Every task owns a disjoint slice of its cell's results
+                pool.submit(
+                    [&, c, first, last, bot]
+                    {
+                        for (int g = first; g < last; ++g)
+                        {
+                            cells[c].games[static_cast<size_t>(g)] = runHeadlessGame(words, settings, bot, gameSeed(spec.seed, c, g), options);
+                        }
+                    }
+                );
+            }
+        }
+        pool.wait();
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<SweepRow> rows;
+    for (const auto& cell : cells)
+    {
+        rows.push_back(SweepRow::summarize(cell));
+    }
+
+    if (format == "csv")
+        std::cout << formatCsv(rows);
+    else if (format == "json")
+        std::cout << formatJson(rows);
+    else
+        std::cout << formatTable(rows);
+
+    std::cerr << cells.size() * static_cast<size_t>(spec.gamesPerConfig) << " games on " << threads << " threads in " << seconds << " s\n";
+    return 0;
+}